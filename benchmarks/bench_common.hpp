@@ -0,0 +1,29 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace daedalus::bench {
+
+/// Wall-clock stopwatch for microbenchmarks.
+class Stopwatch {
+  public:
+    Stopwatch() : start_(std::chrono::steady_clock::now()) {}
+
+    [[nodiscard]] double elapsed_seconds() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    }
+
+  private:
+    std::chrono::steady_clock::time_point start_;
+};
+
+/// Print one result row: name, operation count, elapsed time, throughput.
+inline void report(const std::string &name, double ops, double seconds, const char *unit = "ops") {
+    const double rate = seconds > 0.0 ? ops / seconds : 0.0;
+    std::printf("%-40s %12.0f %-6s %9.3f ms %14.0f %s/s\n", name.c_str(), ops, unit,
+                seconds * 1000.0, rate, unit);
+}
+
+} // namespace daedalus::bench
@@ -0,0 +1,154 @@
+// Frame handoff benchmark: fresh vector per frame vs. recycled BufferPool buffers
+// vs. records written in place into a ByteRing.
+//
+// Simulates the HermesClient → render thread path at 500 signals (4024-byte frames)
+// and counts every heap allocation made while frames are in flight.
+
+#include "bench_common.hpp"
+
+#include "daedalus/data/buffer_pool.hpp"
+#include "daedalus/data/byte_ring.hpp"
+#include "daedalus/protocol/telemetry.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::atomic<uint64_t> g_heap_allocations{0};
+
+constexpr size_t kSignals = 500;
+constexpr size_t kFrames = 200000;
+constexpr size_t kQueueDepth = 512;
+
+std::string make_wire_frame() {
+    daedalus::protocol::TelemetryHeader hdr{};
+    hdr.magic = daedalus::protocol::kTelemetryMagic;
+    hdr.count = static_cast<uint32_t>(kSignals);
+    std::string wire(sizeof(hdr) + kSignals * sizeof(double), '\0');
+    std::memcpy(wire.data(), &hdr, sizeof(hdr));
+    return wire;
+}
+
+struct Result {
+    double seconds = 0.0;
+    uint64_t heap_allocations = 0;
+};
+
+template <typename Produce, typename Consume> Result run(Produce produce, Consume consume) {
+    daedalus::data::SPSCQueue<std::vector<uint8_t>> queue(kQueueDepth);
+    const uint64_t before = g_heap_allocations.load();
+    daedalus::bench::Stopwatch watch;
+
+    std::thread producer([&] {
+        for (size_t i = 0; i < kFrames; ++i) {
+            auto frame = produce();
+            while (!queue.try_push(std::move(frame))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::vector<uint8_t> frame;
+    size_t received = 0;
+    while (received < kFrames) {
+        if (queue.try_pop(frame)) {
+            consume(frame);
+            ++received;
+        }
+    }
+    producer.join();
+
+    return {watch.elapsed_seconds(), g_heap_allocations.load() - before};
+}
+
+/// Same handoff through a ByteRing sized like the vector queue's payload.
+Result run_byte_ring(const std::string &wire) {
+    daedalus::data::ByteRing ring(kQueueDepth * (wire.size() + 8));
+    const uint64_t before = g_heap_allocations.load();
+    daedalus::bench::Stopwatch watch;
+
+    std::thread producer([&] {
+        for (size_t i = 0; i < kFrames; ++i) {
+            uint8_t *out = nullptr;
+            while ((out = ring.try_reserve(wire.size())) == nullptr) {
+                std::this_thread::yield();
+            }
+            std::memcpy(out, wire.data(), wire.size());
+            ring.commit_write(wire.size());
+        }
+    });
+
+    std::span<const uint8_t> frame;
+    size_t received = 0;
+    while (received < kFrames) {
+        if (ring.try_read(frame)) {
+            ring.commit_read();
+            ++received;
+        }
+    }
+    producer.join();
+
+    return {watch.elapsed_seconds(), g_heap_allocations.load() - before};
+}
+
+void print(const char *name, const Result &r) {
+    daedalus::bench::report(name, static_cast<double>(kFrames), r.seconds, "frames");
+    std::printf("%-40s %12.3f allocations/frame\n", "", static_cast<double>(r.heap_allocations) /
+                                                            static_cast<double>(kFrames));
+}
+
+} // namespace
+
+void *operator new(std::size_t size) {
+    g_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+int main() {
+    const std::string wire = make_wire_frame();
+
+    const Result copy = run(
+        [&] { return std::vector<uint8_t>(wire.begin(), wire.end()); },
+        [](std::vector<uint8_t> &) {});
+    print("copy per frame", copy);
+
+    daedalus::data::BufferPool<std::vector<uint8_t>> pool(kQueueDepth + 64, 64, [] {
+        std::vector<uint8_t> frame;
+        frame.reserve(8192);
+        return frame;
+    });
+    const Result pooled = run(
+        [&] {
+            auto frame = pool.acquire();
+            if (frame.capacity() < wire.size()) {
+                pool.note_allocation();
+            }
+            frame.assign(wire.begin(), wire.end());
+            return frame;
+        },
+        [&](std::vector<uint8_t> &frame) { pool.release(std::move(frame)); });
+    print("pooled (BufferPool)", pooled);
+
+    const auto stats = pool.stats();
+    std::printf("pool: preallocated=%llu allocations=%llu reuses=%llu discards=%llu\n",
+                static_cast<unsigned long long>(stats.preallocated),
+                static_cast<unsigned long long>(stats.allocations),
+                static_cast<unsigned long long>(stats.reuses),
+                static_cast<unsigned long long>(stats.discards));
+
+    print("in place (ByteRing)", run_byte_ring(wire));
+    return 0;
+}
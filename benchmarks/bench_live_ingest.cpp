@@ -0,0 +1,68 @@
+// End-to-end live ingest: a SyntheticHermes server on loopback streams to a
+// HermesClient, whose frames go through the whole pipeline (WebSocket → decode →
+// FrameBatcher → TelemetryQueue → IngestThread → SignalStore), for a few sizes
+// of stream. Unpaced, so the numbers are the pipeline's ceiling on this machine.
+//
+// Usage: bench_live_ingest [seconds per case]
+
+#include "bench_common.hpp"
+
+#include "daedalus/headless.hpp"
+#include "daedalus/loadgen/synthetic_hermes.hpp"
+#include "daedalus/protocol/client.hpp"
+
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+namespace {
+
+void run_case(size_t modules, size_t signals_per_module, double seconds) {
+    daedalus::loadgen::LoadProfile profile;
+    profile.modules = modules;
+    profile.signals_per_module = signals_per_module;
+    profile.rate_hz = 0.0;
+    daedalus::loadgen::SyntheticHermes server(profile);
+    if (!server.start()) {
+        return;
+    }
+    daedalus::protocol::HermesClient client(server.url());
+    daedalus::HeadlessSession session(client);
+    session.start();
+
+    // Time from the first ingested frame, not from connecting
+    while (session.report().frames == 0) {
+        session.poll();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const auto first = session.report();
+    daedalus::bench::Stopwatch watch;
+    while (watch.elapsed_seconds() < seconds) {
+        session.poll();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    const auto last = session.report();
+    const double elapsed = watch.elapsed_seconds();
+    session.stop();
+    server.stop();
+
+    const std::string name = "live " + std::to_string(modules * signals_per_module) + " signals";
+    daedalus::bench::report(name, static_cast<double>(last.frames - first.frames), elapsed,
+                            "frames");
+    daedalus::bench::report(name, static_cast<double>(last.samples - first.samples), elapsed,
+                            "samples");
+    std::printf("%-40s p50 %.3f ms  p99 %.3f ms  dropped %llu\n", "",
+                std::chrono::duration<double, std::milli>(last.latency_p50).count(),
+                std::chrono::duration<double, std::milli>(last.latency_p99).count(),
+                static_cast<unsigned long long>(last.frames_dropped));
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const double seconds = argc > 1 ? std::strtod(argv[1], nullptr) : 3.0;
+    run_case(1, 90, seconds);    // Icarus-sized
+    run_case(10, 100, seconds);
+    run_case(100, 100, seconds);
+    return 0;
+}
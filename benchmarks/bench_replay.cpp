@@ -0,0 +1,128 @@
+// End-to-end ingest throughput: a recorded session replayed as fast as possible
+// through the live pipeline (decode → FrameBatcher → TelemetryQueue →
+// IngestThread → SignalStore), with no Hermes server.
+//
+// Usage: bench_replay [session.daedalus]
+// Without a file, records a synthetic 1000-signal session to a temporary file
+// first, so runs are repeatable.
+
+#include "bench_common.hpp"
+
+#include "daedalus/data/history_budget.hpp"
+#include "daedalus/data/ingest_thread.hpp"
+#include "daedalus/data/signal_store.hpp"
+#include "daedalus/record/session_recorder.hpp"
+#include "daedalus/record/session_replay.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+namespace {
+
+constexpr size_t kSignals = 1000;
+constexpr uint64_t kFrames = 20000;
+
+/// Record a schema, ack and kFrames plain frames of kSignals values to `path`.
+bool record_synthetic(const std::string &path) {
+    std::string schema = R"({"type":"schema","modules":{"bench":{"signals":[)";
+    std::string ack = R"({"type":"ack","action":"subscribe","count":)" +
+                      std::to_string(kSignals) + R"(,"signals":[)";
+    for (size_t s = 0; s < kSignals; ++s) {
+        const std::string name = "s" + std::to_string(s);
+        schema += (s > 0 ? "," : "") + std::string(R"({"name":")") + name + R"("})";
+        ack += (s > 0 ? ",\"bench." : "\"bench.") + name + "\"";
+    }
+    schema += "]}}}";
+    ack += "]}";
+
+    daedalus::record::SessionRecorder recorder;
+    if (!recorder.start(path)) {
+        return false;
+    }
+    recorder.record_text(schema);
+    recorder.record_text(ack);
+    std::vector<uint8_t> frame(sizeof(daedalus::protocol::TelemetryHeader) +
+                               kSignals * sizeof(double));
+    for (uint64_t f = 0; f < kFrames; ++f) {
+        const daedalus::protocol::TelemetryHeader hdr{daedalus::protocol::kTelemetryMagic, f,
+                                                      0.001 * static_cast<double>(f),
+                                                      static_cast<uint32_t>(kSignals)};
+        std::memcpy(frame.data(), &hdr, sizeof(hdr));
+        auto *values = frame.data() + sizeof(hdr);
+        for (size_t s = 0; s < kSignals; ++s) {
+            const double v = std::sin(0.001 * static_cast<double>(f * (s + 1)));
+            std::memcpy(values + s * sizeof(double), &v, sizeof(v));
+        }
+        while (!recorder.record_frame(frame.data(), frame.size())) {
+            std::this_thread::yield(); // let the writer catch up
+        }
+    }
+    recorder.stop();
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    namespace fs = std::filesystem;
+    std::string path;
+    fs::path synthetic;
+    if (argc > 1) {
+        path = argv[1];
+    } else {
+        synthetic = fs::temp_directory_path() / "daedalus_bench_replay.daedalus";
+        path = synthetic.string();
+        if (!record_synthetic(path)) {
+            return 1;
+        }
+    }
+
+    daedalus::record::SessionReplay replay(path, daedalus::record::SessionReplay::kMaxSpeed);
+    daedalus::data::IngestThread ingest(replay.telemetry_queue(), replay.batch_pool());
+    daedalus::data::HistoryBudget budget;
+    std::shared_ptr<daedalus::data::SignalStore> store;
+    ingest.start();
+    replay.connect();
+
+    // Handle control events like the app, until every frame is in the store.
+    daedalus::bench::Stopwatch watch;
+    daedalus::protocol::ControlEvent event;
+    while (replay.state() == daedalus::protocol::ConnectionState::Connected &&
+           !(replay.finished() && replay.telemetry_queue().size_approx() == 0 &&
+             ingest.rows_ingested() + ingest.rows_discarded() >= replay.frames_played())) {
+        if (!replay.event_queue().try_pop(event)) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            continue;
+        }
+        if (const auto *ack = std::get_if<daedalus::protocol::SubscribeAck>(&event)) {
+            store = std::make_shared<daedalus::data::SignalStore>(
+                ack->signals.size(), budget.plan(ack->signals.size()));
+            ingest.set_store(store);
+            replay.resume();
+        }
+    }
+    const double seconds = watch.elapsed_seconds();
+    ingest.stop();
+    replay.disconnect();
+
+    const auto frames = static_cast<double>(ingest.rows_ingested());
+    const double signals = store ? static_cast<double>(store->signal_count()) : 0.0;
+    std::printf("%s: %.0f frames of %.0f signals, %.1f MB\n", path.c_str(), frames, signals,
+                static_cast<double>(fs::file_size(path)) / (1024.0 * 1024.0));
+    daedalus::bench::report("replay, max speed", frames, seconds, "frames");
+    daedalus::bench::report("replay, max speed", frames * signals, seconds, "samples");
+    if (ingest.rows_discarded() > 0) {
+        std::printf("%-40s %12llu rows discarded\n", "",
+                    static_cast<unsigned long long>(ingest.rows_discarded()));
+    }
+    if (!synthetic.empty()) {
+        fs::remove(synthetic);
+    }
+    return 0;
+}
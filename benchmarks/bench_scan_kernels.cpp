@@ -0,0 +1,136 @@
+// Ring-buffer scan benchmark: per-element value_at() vs. the dispatched SIMD kernels.
+//
+// Scans a wrapped 1M-sample SignalStore column the way the stats overlay and Y
+// auto-fit do, then times time lookups (lower_bound_time) against a plain binary
+// search.
+
+#include "bench_common.hpp"
+
+#include "daedalus/data/scan_kernels.hpp"
+#include "daedalus/data/signal_store.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr size_t kSamples = size_t{1} << 20;
+constexpr size_t kScans = 200;
+constexpr size_t kLookups = 2000000;
+
+volatile double g_sink = 0.0;
+
+std::shared_ptr<daedalus::data::SignalStore> make_store() {
+    auto store = std::make_shared<daedalus::data::SignalStore>(1, kSamples);
+    // Overfill so the contents wrap and the scan has two spans.
+    daedalus::data::FrameBatch batch;
+    for (size_t i = 0; i < kSamples + kSamples / 3;) {
+        batch.reset(1, store->guard());
+        for (; batch.rows < store->guard() && i < kSamples + kSamples / 3; ++i) {
+            const double t = static_cast<double>(i) * 0.001;
+            const double value[] = {std::sin(t) + 0.001 * static_cast<double>(i % 97)};
+            batch.append(i, t, value);
+        }
+        store->append_rows(batch);
+    }
+    return store;
+}
+
+double scan_value_at(const daedalus::data::SignalView &view) {
+    double lo = view.value_at(0);
+    double hi = lo;
+    double sum = 0.0;
+    for (size_t i = 0; i < view.size(); ++i) {
+        const double v = view.value_at(i);
+        lo = std::min(lo, v);
+        hi = std::max(hi, v);
+        sum += v;
+    }
+    return lo + hi + sum;
+}
+
+double scan_kernels(const daedalus::data::SignalView &view,
+                    const daedalus::data::ScanKernels &kernels) {
+    const daedalus::data::RingSpans spans = view.value_spans(0, view.size());
+    daedalus::data::RangeStats stats = kernels.stats(spans.first.data(), spans.first.size());
+    stats.merge(kernels.stats(spans.second.data(), spans.second.size()));
+    return stats.min + stats.max + stats.sum;
+}
+
+size_t binary_search_time(const daedalus::data::SignalView &view, double target) {
+    size_t left = 0;
+    size_t right = view.size();
+    while (left < right) {
+        const size_t mid = left + (right - left) / 2;
+        if (view.time_at(mid) < target) {
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+    return left;
+}
+
+} // namespace
+
+int main() {
+    using daedalus::bench::report;
+    using daedalus::bench::Stopwatch;
+    namespace data = daedalus::data;
+
+    const auto store = make_store();
+    const data::StoreSnapshot snapshot = store->snapshot();
+    const data::SignalView &view = *snapshot.find(0);
+    const double samples = static_cast<double>(kScans * view.size());
+    std::printf("detected ISA: %s\n", data::scan_isa_name(data::detected_scan_isa()));
+
+    {
+        Stopwatch watch;
+        for (size_t i = 0; i < kScans; ++i) {
+            g_sink = g_sink + scan_value_at(view);
+        }
+        report("stats via value_at()", samples, watch.elapsed_seconds(), "samples");
+    }
+    for (const data::ScanIsa isa : {data::ScanIsa::Scalar, data::ScanIsa::Sse2,
+                                    data::ScanIsa::Avx2}) {
+        if (!data::scan_isa_supported(isa)) {
+            continue;
+        }
+        const data::ScanKernels &kernels = data::scan_kernels(isa);
+        Stopwatch watch;
+        for (size_t i = 0; i < kScans; ++i) {
+            g_sink = g_sink + scan_kernels(view, kernels);
+        }
+        report(std::string("stats kernel (") + data::scan_isa_name(isa) + ")", samples,
+               watch.elapsed_seconds(), "samples");
+    }
+
+    const double span = view.last_time() - view.time_at(0);
+    {
+        Stopwatch watch;
+        size_t acc = 0;
+        for (size_t i = 0; i < kLookups; ++i) {
+            acc += binary_search_time(view, view.time_at(0) +
+                                                span * static_cast<double>(i % 1000) / 1000.0);
+        }
+        g_sink = g_sink + static_cast<double>(acc);
+        report("time lookup via time_at()", static_cast<double>(kLookups),
+               watch.elapsed_seconds(), "lookups");
+    }
+    {
+        Stopwatch watch;
+        size_t acc = 0;
+        for (size_t i = 0; i < kLookups; ++i) {
+            acc += view.lower_bound_time(view.time_at(0) +
+                                         span * static_cast<double>(i % 1000) / 1000.0);
+        }
+        g_sink = g_sink + static_cast<double>(acc);
+        report("time lookup via lower_bound_time()", static_cast<double>(kLookups),
+               watch.elapsed_seconds(), "lookups");
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+// Schema and subscribe-ack parsing at 1k, 10k and 100k signals: a JSON DOM plus
+// parse_schema()/parse_subscribe_ack() vs. the streaming text parsers.
+//
+// Messages look like Hermes': 100 signals per module, each with a name, type and
+// unit. Every heap allocation made while parsing is counted, along with the
+// bytes requested.
+
+#include "bench_common.hpp"
+
+#include "daedalus/protocol/schema.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+namespace {
+
+std::atomic<uint64_t> g_heap_allocations{0};
+std::atomic<uint64_t> g_heap_bytes{0};
+
+constexpr int kParses = 5;
+
+std::string make_schema_text(size_t signals) {
+    nlohmann::json modules = nlohmann::json::object();
+    for (size_t m = 0; m * 100 < signals; ++m) {
+        auto &list = modules["module" + std::to_string(m)]["signals"];
+        list = nlohmann::json::array();
+        for (size_t s = 0; s < 100 && m * 100 + s < signals; ++s) {
+            list.push_back({{"name", "group" + std::to_string(s / 10) + ".signal" +
+                                         std::to_string(s % 10)},
+                            {"type", "f64"},
+                            {"unit", "m/s"}});
+        }
+    }
+    return nlohmann::json{{"type", "schema"}, {"modules", modules}}.dump();
+}
+
+std::string make_ack_text(size_t signals) {
+    nlohmann::json list = nlohmann::json::array();
+    for (size_t i = 0; i < signals; ++i) {
+        list.push_back("module" + std::to_string(i / 100) + ".group" +
+                       std::to_string(i % 100 / 10) + ".signal" + std::to_string(i % 10));
+    }
+    return nlohmann::json{
+        {"type", "ack"}, {"action", "subscribe"}, {"count", signals}, {"signals", list}}
+        .dump();
+}
+
+/// Parse kParses times and report the mean parse and its allocations.
+template <typename Parse>
+void measure(const std::string &name, size_t signals, Parse parse) {
+    double seconds = 0.0;
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+    size_t checksum = 0;
+    for (int i = 0; i < kParses; ++i) {
+        const uint64_t allocations_before = g_heap_allocations.load();
+        const uint64_t bytes_before = g_heap_bytes.load();
+        daedalus::bench::Stopwatch watch;
+        checksum += parse();
+        seconds += watch.elapsed_seconds();
+        allocations += g_heap_allocations.load() - allocations_before;
+        bytes += g_heap_bytes.load() - bytes_before;
+    }
+    if (checksum != signals * kParses) {
+        std::printf("%s: parsed %zu signals, expected %zu\n", name.c_str(), checksum / kParses,
+                    signals);
+    }
+
+    const std::string label = name + " (" + std::to_string(signals) + ")";
+    daedalus::bench::report(label, static_cast<double>(signals), seconds / kParses, "sigs");
+    std::printf("%-40s %12.0f allocations %10.1f MiB requested\n", "",
+                static_cast<double>(allocations) / kParses,
+                static_cast<double>(bytes) / kParses / (1024.0 * 1024.0));
+}
+
+size_t signal_count(const daedalus::protocol::Schema &schema) {
+    size_t count = 0;
+    for (const auto &mod : schema.modules) {
+        count += mod.signals.size();
+    }
+    return count;
+}
+
+} // namespace
+
+void *operator new(std::size_t size) {
+    g_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_heap_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void *p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+int main() {
+    using namespace daedalus::protocol;
+    for (const size_t signals : {size_t{1000}, size_t{10000}, size_t{100000}}) {
+        const std::string schema = make_schema_text(signals);
+        measure("schema, DOM", signals, [&] {
+            return signal_count(parse_schema(nlohmann::json::parse(schema)));
+        });
+        measure("schema, streaming", signals,
+                [&] { return signal_count(parse_schema_text(schema)); });
+
+        const std::string ack = make_ack_text(signals);
+        measure("subscribe ack, DOM", signals, [&] {
+            return parse_subscribe_ack(nlohmann::json::parse(ack)).signals.size();
+        });
+        measure("subscribe ack, streaming", signals,
+                [&] { return parse_subscribe_ack_text(ack).signals.size(); });
+    }
+    return 0;
+}
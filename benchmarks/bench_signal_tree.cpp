@@ -0,0 +1,148 @@
+// SignalTree::build_from_schema benchmark at 1k, 10k and 100k signals: the original
+// node-per-allocation tree vs. the arena-backed one.
+//
+// Schemas look like a simulation's: 100 signals per module, grouped ten to a
+// sub-namespace ("module12.group3.signal7"). Every heap allocation made while
+// building is counted, along with the bytes requested.
+
+#include "bench_common.hpp"
+
+#include "daedalus/data/signal_tree.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+std::atomic<uint64_t> g_heap_allocations{0};
+std::atomic<uint64_t> g_heap_bytes{0};
+
+constexpr int kBuilds = 5;
+
+/// The tree before the rework: a unique_ptr per node, two std::string copies of
+/// every path, a linear child scan per segment and a node-based path map.
+class LegacySignalTree {
+  public:
+    struct Node {
+        std::string name;
+        std::string full_path;
+        bool is_leaf = false;
+        std::vector<std::unique_ptr<Node>> children;
+
+        Node *find_child(const std::string &child_name) const {
+            for (const auto &child : children) {
+                if (child->name == child_name) {
+                    return child.get();
+                }
+            }
+            return nullptr;
+        }
+    };
+
+    void build_from_schema(const daedalus::protocol::Schema &schema) {
+        root_.children.clear();
+        path_index_.clear();
+        for (const auto &mod : schema.modules) {
+            for (const auto &sig : mod.signals) {
+                ensure_path(mod.name + "." + sig.name).is_leaf = true;
+            }
+        }
+    }
+
+  private:
+    Node &ensure_path(const std::string &full_path) {
+        Node *current = &root_;
+        std::istringstream stream(full_path);
+        std::string segment;
+        std::string built_path;
+        while (std::getline(stream, segment, '.')) {
+            if (!built_path.empty()) {
+                built_path += ".";
+            }
+            built_path += segment;
+            Node *child = current->find_child(segment);
+            if (child == nullptr) {
+                auto node = std::make_unique<Node>();
+                node->name = segment;
+                node->full_path = built_path;
+                child = node.get();
+                current->children.push_back(std::move(node));
+            }
+            path_index_[built_path] = child;
+            current = child;
+        }
+        return *current;
+    }
+
+    Node root_;
+    std::unordered_map<std::string, Node *> path_index_;
+};
+
+daedalus::protocol::Schema make_schema(size_t signals) {
+    daedalus::protocol::Schema schema;
+    for (size_t m = 0; m * 100 < signals; ++m) {
+        daedalus::protocol::ModuleInfo mod;
+        mod.name = "module" + std::to_string(m);
+        for (size_t s = 0; s < 100 && m * 100 + s < signals; ++s) {
+            mod.signals.push_back(
+                {"group" + std::to_string(s / 10) + ".signal" + std::to_string(s % 10), "f64",
+                 "m"});
+        }
+        schema.modules.push_back(std::move(mod));
+    }
+    return schema;
+}
+
+/// Build a fresh tree kBuilds times and report the mean build and its allocations.
+template <typename Tree>
+void measure(const char *name, const daedalus::protocol::Schema &schema, size_t signals) {
+    double seconds = 0.0;
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+    for (int i = 0; i < kBuilds; ++i) {
+        auto tree = std::make_unique<Tree>();
+        const uint64_t allocations_before = g_heap_allocations.load();
+        const uint64_t bytes_before = g_heap_bytes.load();
+        daedalus::bench::Stopwatch watch;
+        tree->build_from_schema(schema);
+        seconds += watch.elapsed_seconds();
+        allocations += g_heap_allocations.load() - allocations_before;
+        bytes += g_heap_bytes.load() - bytes_before;
+    }
+
+    const std::string label = std::string(name) + " (" + std::to_string(signals) + ")";
+    daedalus::bench::report(label, static_cast<double>(signals), seconds / kBuilds, "sigs");
+    std::printf("%-40s %12.0f allocations %10.1f MiB requested\n", "",
+                static_cast<double>(allocations) / kBuilds,
+                static_cast<double>(bytes) / kBuilds / (1024.0 * 1024.0));
+}
+
+} // namespace
+
+void *operator new(std::size_t size) {
+    g_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_heap_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void *p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+int main() {
+    for (const size_t signals : {size_t{1000}, size_t{10000}, size_t{100000}}) {
+        const auto schema = make_schema(signals);
+        measure<LegacySignalTree>("legacy node tree", schema, signals);
+        measure<daedalus::data::SignalTree>("arena tree", schema, signals);
+    }
+    return 0;
+}
@@ -0,0 +1,168 @@
+// SPSCQueue throughput benchmark: the original modulo ring vs. the masked ring with
+// cached indices, item by item and in bulk, and the evictable ring a DropOldest
+// queue uses.
+//
+// Runs one producer/consumer pair (2 cores) and two independent pairs (4 cores)
+// and reports the aggregate items moved per second. Threads are pinned to
+// distinct cores where the platform allows it.
+
+#include "bench_common.hpp"
+
+#include "daedalus/data/telemetry_queue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+constexpr uint64_t kItems = 20000000;
+constexpr size_t kCapacity = 1024;
+constexpr size_t kBulk = 32;
+
+/// The queue before the rework: `% capacity_` per operation and a load of the
+/// other side's index on every push and pop (eviction support omitted).
+template <typename T> class LegacySPSCQueue {
+  public:
+    explicit LegacySPSCQueue(size_t capacity)
+        : capacity_(std::max<size_t>(capacity, 2)), buffer_(capacity_) {}
+
+    bool try_push(T &&item) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) >= capacity_ - 1) {
+            return false;
+        }
+        buffer_[tail % capacity_] = std::move(item);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T &item) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = std::move(buffer_[head % capacity_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+  private:
+    size_t capacity_;
+    std::vector<T> buffer_;
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+};
+
+void pin_to_core(unsigned core) {
+#ifdef __linux__
+    if (core >= std::thread::hardware_concurrency()) {
+        return;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)core;
+#endif
+}
+
+template <typename Queue> void single_pair(Queue &queue, unsigned first_core) {
+    std::thread producer([&] {
+        pin_to_core(first_core);
+        for (uint64_t i = 0; i < kItems; ++i) {
+            uint64_t item = i;
+            while (!queue.try_push(std::move(item))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    pin_to_core(first_core + 1);
+    uint64_t item = 0;
+    for (uint64_t received = 0; received < kItems;) {
+        if (queue.try_pop(item)) {
+            ++received;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+}
+
+void bulk_pair(daedalus::data::SPSCQueue<uint64_t> &queue, unsigned first_core) {
+    std::thread producer([&] {
+        pin_to_core(first_core);
+        uint64_t batch[kBulk];
+        for (uint64_t next = 0; next < kItems;) {
+            const size_t n = static_cast<size_t>(std::min<uint64_t>(kBulk, kItems - next));
+            for (size_t i = 0; i < n; ++i) {
+                batch[i] = next + i;
+            }
+            for (size_t pushed = 0; pushed < n;) {
+                const size_t written = queue.try_push_bulk(batch + pushed, n - pushed);
+                if (written == 0) {
+                    std::this_thread::yield();
+                }
+                pushed += written;
+            }
+            next += n;
+        }
+    });
+    pin_to_core(first_core + 1);
+    uint64_t out[kBulk];
+    for (uint64_t received = 0; received < kItems;) {
+        const size_t n = queue.try_pop_bulk(out, kBulk);
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+        received += n;
+    }
+    producer.join();
+}
+
+/// Run `pairs` independent producer/consumer pairs and report aggregate throughput.
+template <typename Queue, typename Run, typename... Args>
+void measure(const std::string &name, unsigned pairs, Run run, Args... queue_args) {
+    std::vector<std::unique_ptr<Queue>> queues;
+    for (unsigned p = 0; p < pairs; ++p) {
+        queues.push_back(std::make_unique<Queue>(kCapacity, queue_args...));
+    }
+    daedalus::bench::Stopwatch watch;
+    std::vector<std::thread> threads;
+    for (unsigned p = 0; p < pairs; ++p) {
+        threads.emplace_back([&, p] { run(*queues[p], 2 * p); });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    daedalus::bench::report(name + " (" + std::to_string(2 * pairs) + " cores)",
+                            static_cast<double>(kItems) * pairs, watch.elapsed_seconds(),
+                            "items");
+}
+
+} // namespace
+
+int main() {
+    using daedalus::data::SPSCQueue;
+    for (const unsigned pairs : {1u, 2u}) {
+        measure<LegacySPSCQueue<uint64_t>>("legacy modulo ring", pairs,
+                                           single_pair<LegacySPSCQueue<uint64_t>>);
+        measure<SPSCQueue<uint64_t>>("masked ring, cached indices", pairs,
+                                     single_pair<SPSCQueue<uint64_t>>);
+        measure<SPSCQueue<uint64_t>>("masked ring, bulk x32", pairs, bulk_pair);
+        measure<SPSCQueue<uint64_t>>("evictable ring", pairs, single_pair<SPSCQueue<uint64_t>>,
+                                     true);
+    }
+    return 0;
+}
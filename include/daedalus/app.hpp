@@ -1,56 +1,88 @@
 #pragma once
 
-#include "daedalus/data/signal_buffer.hpp"
+#include "daedalus/data/history_budget.hpp"
+#include "daedalus/data/ingest_thread.hpp"
+#include "daedalus/data/signal_store.hpp"
 #include "daedalus/data/signal_tree.hpp"
 #include "daedalus/protocol/client.hpp"
+#include "daedalus/protocol/decode_plan.hpp"
+#include "daedalus/protocol/events.hpp"
 #include "daedalus/protocol/schema.hpp"
+#include "daedalus/protocol/telemetry_source.hpp"
+#include "daedalus/record/session_recorder.hpp"
+#include "daedalus/record/session_replay.hpp"
 #include "daedalus/views/plotter.hpp"
 
-#include <map>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
-#include <string_view>
 #include <unordered_map>
 
 namespace daedalus {
 
 /// Application entry point and lifecycle management.
-/// Initializes Hello ImGui, connects to Hermes, and runs the render loop.
+/// Initializes Hello ImGui, connects to Hermes (or replays a recorded session),
+/// and runs the render loop.
 class App {
   public:
     App();
     ~App();
 
     /// Run the main application loop.
+    /// Arguments: [--replay FILE [--speed N|max]] plays a recorded session instead
+    /// of connecting to Hermes, at N× the recorded rate (default 1).
     /// Returns exit code (0 = success).
     int run(int argc, char *argv[]);
 
   private:
     /// Called each frame by Hello ImGui to process queued data.
     void process_events();
-    void process_telemetry();
+
+    /// Pin the signal store for this frame's widgets, and release it once they
+    /// have all been submitted.
+    void begin_frame_snapshot();
+    void end_frame_snapshot();
+
+    /// Periodically redistribute the history budget by what is plotted and how
+    /// often each signal changes.
+    void rebalance_history();
+
+    /// Start recording the raw stream to a new session file in the working
+    /// directory, or stop the current recording.
+    void toggle_recording();
 
     /// UI rendering functions (called each frame).
     void render_connection_status();
     void render_signal_tree();
-    void render_signal_tree_node(const data::SignalTreeNode &node, std::string_view filter);
+    void render_signal_tree_row(const data::SignalTreeRow &row);
     void render_plot_workspace();
 
-    /// Handle a parsed JSON event from the event queue.
-    void handle_event(const std::string &json_str);
+    /// Apply a control event from the event queue (already parsed off this thread).
+    void handle_event(protocol::ControlEvent &event);
 
     // --- State ---
-    std::unique_ptr<protocol::HermesClient> client_;
+    std::unique_ptr<protocol::TelemetrySource> source_;
+    protocol::HermesClient *client_ = nullptr; ///< source_, when live.
+    record::SessionReplay *replay_ = nullptr;  ///< source_, when replaying.
+    std::unique_ptr<data::IngestThread> ingest_;
+    std::shared_ptr<record::SessionRecorder> recorder_;
     data::SignalTree signal_tree_;
-    std::map<size_t, data::SignalBuffer> signal_buffers_;
+    std::shared_ptr<data::SignalStore> store_;
+    data::StoreSnapshot frame_snapshot_;
+    data::HistoryBudget history_budget_;
+    std::chrono::steady_clock::time_point last_rebalance_{};
+    std::vector<uint64_t> rebalance_changes_; ///< column_changes() at the last rebalance.
+    uint64_t rebalance_samples_ = 0;
     std::unordered_map<std::string, std::string> signal_units_;
     protocol::Schema current_schema_;
     std::vector<std::string> subscribed_signals_;
+    /// Declared type of each subscribed signal; integral ones display as integers.
+    std::vector<protocol::ValueType> signal_types_;
     views::PlotManager plot_manager_;
     std::string server_url_ = "ws://127.0.0.1:8765";
     bool schema_received_ = false;
-    std::optional<bool> tree_open_state_request_;
 };
 
 } // namespace daedalus
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "daedalus/data/frame_batch.hpp"
+#include "daedalus/data/telemetry_queue.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace daedalus::data {
+
+/// Allocation counters for a BufferPool. Plain snapshot, safe to copy anywhere.
+struct PoolStats {
+    uint64_t preallocated = 0; // buffers created up front by the constructor
+    uint64_t allocations = 0;  // heap allocations after construction (misses + growth)
+    uint64_t reuses = 0;       // acquisitions served from a recycled buffer
+    uint64_t releases = 0;     // buffers handed back by the consumer
+    uint64_t discards = 0;     // returned buffers freed because the pool was full
+};
+
+/// Recycling pool for heap buffers that travel producer → consumer over an SPSC queue.
+/// The consumer hands finished buffers back through a reverse SPSC channel, so the
+/// steady state performs no heap allocation once enough buffers are in flight.
+///
+/// Producer thread: acquire(), reclaim(), note_allocation().
+/// Consumer thread: release().
+/// stats() may be called from any thread.
+template <typename T> class BufferPool {
+  public:
+    /// Create a pool that keeps up to `max_buffers` recycled buffers and
+    /// preallocates `prewarm` of them with `factory`.
+    BufferPool(size_t max_buffers, size_t prewarm, std::function<T()> factory)
+        : factory_(std::move(factory)), returned_(max_buffers + 1) {
+        local_.reserve(kLocalSlots);
+        for (size_t i = 0; i < prewarm && i < returned_.capacity(); ++i) {
+            returned_.try_push(factory_());
+            preallocated_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    BufferPool(const BufferPool &) = delete;
+    BufferPool &operator=(const BufferPool &) = delete;
+
+    /// Take a buffer for filling (producer only).
+    /// Returns a recycled buffer when one is available, otherwise a fresh one.
+    T acquire() {
+        if (local_.empty()) {
+            // Refill the local spares from the return channel in one claim.
+            local_.resize(kLocalSlots);
+            local_.resize(returned_.try_pop_bulk(local_.data(), kLocalSlots));
+        }
+        if (!local_.empty()) {
+            T buffer = std::move(local_.back());
+            local_.pop_back();
+            reuses_.fetch_add(1, std::memory_order_relaxed);
+            return buffer;
+        }
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+        return factory_();
+    }
+
+    /// Keep a buffer that never left the producer, e.g. after a failed push (producer only).
+    void reclaim(T &&buffer) {
+        if (local_.size() < kLocalSlots) {
+            local_.push_back(std::move(buffer));
+        }
+    }
+
+    /// Hand a consumed buffer back to the producer (consumer only).
+    void release(T &&buffer) {
+        if (returned_.try_push(std::move(buffer))) {
+            releases_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            discards_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /// Record a heap allocation made while filling an acquired buffer, such as
+    /// growing a recycled vector past its capacity (producer only).
+    void note_allocation() { allocations_.fetch_add(1, std::memory_order_relaxed); }
+
+    [[nodiscard]] PoolStats stats() const {
+        PoolStats s;
+        s.preallocated = preallocated_.load(std::memory_order_relaxed);
+        s.allocations = allocations_.load(std::memory_order_relaxed);
+        s.reuses = reuses_.load(std::memory_order_relaxed);
+        s.releases = releases_.load(std::memory_order_relaxed);
+        s.discards = discards_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+  private:
+    static constexpr size_t kLocalSlots = 4;
+
+    std::function<T()> factory_;
+    SPSCQueue<T> returned_;
+    std::vector<T> local_; // producer-private spares
+
+    std::atomic<uint64_t> preallocated_{0};
+    std::atomic<uint64_t> allocations_{0};
+    std::atomic<uint64_t> reuses_{0};
+    std::atomic<uint64_t> releases_{0};
+    std::atomic<uint64_t> discards_{0};
+};
+
+/// Pool of decoded telemetry batches (network thread → render thread and back).
+using BatchPool = BufferPool<FrameBatch>;
+
+/// Decoded telemetry batch queue (network → render thread); its batches come
+/// from and go back to a BatchPool.
+using TelemetryQueue = OverflowQueue<FrameBatch>;
+
+} // namespace daedalus::data
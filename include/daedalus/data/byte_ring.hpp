@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace daedalus::data {
+
+/// Single-producer single-consumer ring of variable-size byte records.
+///
+/// Records are written in place into one preallocated region, each behind an
+/// 8-byte length prefix and padded so every payload starts 8-byte aligned. A
+/// record never straddles the end of the region: if it does not fit in the bytes
+/// left before the end, the producer leaves a wrap marker there and starts over
+/// at the front. The footprint is fixed at construction and nothing is allocated
+/// per record.
+///
+/// Producer: try_reserve() a slot, fill it, commit_write() (or try_push() a copy).
+/// Consumer: try_read() the oldest record, use the span, commit_read(). The span
+/// stays valid until commit_read(); the producer cannot reuse those bytes before.
+///
+/// Offsets are monotonic byte counters, and like SPSCQueue each side caches the
+/// other's offset and rereads the shared one only when the cache says full/empty.
+class ByteRing {
+  public:
+    /// Bytes of length prefix in front of every record.
+    static constexpr size_t kHeaderBytes = 8;
+    /// Payload alignment and record granularity.
+    static constexpr size_t kAlignment = 8;
+
+    /// Region of at least `capacity` bytes (rounded up to a power of two, minimum 64).
+    explicit ByteRing(size_t capacity)
+        : capacity_(std::bit_ceil(std::max<size_t>(capacity, 64))), mask_(capacity_ - 1),
+          buffer_(capacity_) {}
+
+    ByteRing(const ByteRing &) = delete;
+    ByteRing &operator=(const ByteRing &) = delete;
+
+    /// Region size in bytes, headers and padding included.
+    [[nodiscard]] size_t capacity() const { return capacity_; }
+
+    /// Largest payload that always fits once the ring drains. Half the region, so
+    /// a record either fits before the end or after the wrap, wherever it starts.
+    [[nodiscard]] size_t max_record_size() const { return capacity_ / 2 - kHeaderBytes; }
+
+    /// Reserve room for a record of `size` bytes (producer only). Returns where to
+    /// write the payload, or nullptr if the ring is too full or the record too big.
+    /// Reserving again before commit_write() replaces the earlier reservation.
+    uint8_t *try_reserve(size_t size) {
+        if (size > max_record_size()) {
+            return nullptr;
+        }
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t pos = tail & mask_;
+        const size_t footprint = record_bytes(size);
+        const size_t to_end = capacity_ - pos;
+        const size_t needed = footprint <= to_end ? footprint : to_end + footprint;
+
+        if (capacity_ - (tail - cached_head_) < needed) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (capacity_ - (tail - cached_head_) < needed) {
+                return nullptr; // full
+            }
+        }
+
+        size_t start = tail;
+        if (footprint > to_end) {
+            write_header(pos, kWrapMarker);
+            start += to_end;
+        }
+        reserved_ = start;
+        reserved_size_ = size;
+        write_header(start & mask_, static_cast<uint32_t>(size));
+        return buffer_.data() + (start & mask_) + kHeaderBytes;
+    }
+
+    /// Publish the reserved record (producer only). `size` may trim it below the
+    /// reserved size, e.g. when the final length is only known after writing.
+    void commit_write(size_t size) {
+        size = std::min(size, reserved_size_);
+        write_header(reserved_ & mask_, static_cast<uint32_t>(size));
+        tail_.store(reserved_ + record_bytes(size), std::memory_order_release);
+    }
+
+    /// Copy a record in (producer only). Returns false if it does not fit.
+    bool try_push(std::span<const uint8_t> record) {
+        uint8_t *out = try_reserve(record.size());
+        if (out == nullptr) {
+            return false;
+        }
+        if (!record.empty()) {
+            std::memcpy(out, record.data(), record.size());
+        }
+        commit_write(record.size());
+        return true;
+    }
+
+    /// View the oldest record (consumer only). Returns false if empty. Calling it
+    /// again before commit_read() returns the same record.
+    bool try_read(std::span<const uint8_t> &record) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false; // empty
+            }
+        }
+        uint32_t size = read_header(head & mask_);
+        if (size == kWrapMarker) {
+            head += capacity_ - (head & mask_); // the record follows at the front
+            size = read_header(0);
+        }
+        read_end_ = head + record_bytes(size);
+        record = {buffer_.data() + (head & mask_) + kHeaderBytes, size};
+        return true;
+    }
+
+    /// Release the record returned by the last try_read() (consumer only).
+    void commit_read() { head_.store(read_end_, std::memory_order_release); }
+
+    /// Bytes currently held, headers and padding included (approximate under
+    /// concurrency).
+    [[nodiscard]] size_t used_bytes() const {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t head = head_.load(std::memory_order_relaxed);
+        return tail >= head ? tail - head : 0;
+    }
+    [[nodiscard]] bool empty() const { return used_bytes() == 0; }
+
+  private:
+    static constexpr uint32_t kWrapMarker = std::numeric_limits<uint32_t>::max();
+
+    static size_t record_bytes(size_t size) {
+        return kHeaderBytes + (size + kAlignment - 1) / kAlignment * kAlignment;
+    }
+
+    void write_header(size_t pos, uint32_t size) {
+        std::memcpy(buffer_.data() + pos, &size, sizeof(size));
+    }
+    [[nodiscard]] uint32_t read_header(size_t pos) const {
+        uint32_t size = 0;
+        std::memcpy(&size, buffer_.data() + pos, sizeof(size));
+        return size;
+    }
+
+    size_t capacity_;
+    size_t mask_;
+    std::vector<uint8_t> buffer_;
+
+    // Separate cache lines to avoid false sharing; each side's private state
+    // lives next to its own offset.
+    alignas(64) std::atomic<size_t> head_{0};
+    size_t cached_tail_ = 0; // consumer only
+    size_t read_end_ = 0;    // consumer only: head after the record being read
+    alignas(64) std::atomic<size_t> tail_{0};
+    size_t cached_head_ = 0;   // producer only
+    size_t reserved_ = 0;      // producer only: start of the reserved record
+    size_t reserved_size_ = 0; // producer only
+};
+
+} // namespace daedalus::data
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "daedalus/data/queue_item_weight.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace daedalus::data {
+
+/// Columnar block of decoded telemetry frames.
+/// One row per frame (frame number + sim time) and one value column per signal,
+/// in subscription order. Columns are contiguous so the consumer can append a
+/// whole signal at once instead of touching every sample.
+struct FrameBatch {
+    size_t signal_count = 0;
+    size_t row_capacity = 0;
+    size_t rows = 0;
+    std::vector<uint64_t> frames;
+    std::vector<double> times;
+    std::vector<double> values; // column-major: values[signal * row_capacity + row]
+    /// When the first row's frame was received; the consumer measures latency from it.
+    std::chrono::steady_clock::time_point received_at{};
+
+    /// Prepare for `signals` columns of up to `capacity` rows and drop existing rows.
+    /// Returns true if storage had to grow (i.e. a heap allocation happened).
+    bool reset(size_t signals, size_t capacity) {
+        capacity = std::max<size_t>(capacity, 1);
+        const bool grew = frames.capacity() < capacity || times.capacity() < capacity ||
+                          values.capacity() < signals * capacity;
+        signal_count = signals;
+        row_capacity = capacity;
+        rows = 0;
+        frames.resize(capacity);
+        times.resize(capacity);
+        values.resize(signals * capacity);
+        return grew;
+    }
+
+    [[nodiscard]] bool empty() const { return rows == 0; }
+    [[nodiscard]] bool full() const { return rows >= row_capacity; }
+
+    /// Append one decoded frame. `row_values` must hold signal_count values.
+    /// Returns false if the batch is full or the row width does not match.
+    bool append(uint64_t frame, double time, std::span<const double> row_values) {
+        if (full() || row_values.size() != signal_count) {
+            return false;
+        }
+        frames[rows] = frame;
+        times[rows] = time;
+        for (size_t s = 0; s < signal_count; ++s) {
+            values[s * row_capacity + rows] = row_values[s];
+        }
+        ++rows;
+        return true;
+    }
+
+    [[nodiscard]] std::span<const uint64_t> frame_column() const { return {frames.data(), rows}; }
+    [[nodiscard]] std::span<const double> time_column() const { return {times.data(), rows}; }
+
+    /// Samples of one signal, oldest first.
+    [[nodiscard]] std::span<const double> column(size_t signal) const {
+        return {values.data() + signal * row_capacity, rows};
+    }
+
+    /// Sim time of the newest row. UB if empty.
+    [[nodiscard]] double last_time() const { return times[rows - 1]; }
+};
+
+/// A batch counts its rows, so queue drops are reported in telemetry frames.
+template <> struct QueueItemWeight<FrameBatch> {
+    static uint64_t of(const FrameBatch &batch) { return batch.rows; }
+};
+
+} // namespace daedalus::data
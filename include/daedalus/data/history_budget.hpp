@@ -0,0 +1,64 @@
+#pragma once
+
+#include "daedalus/data/signal_store.hpp"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace daedalus::data {
+
+/// What the UI currently wants from one signal's history.
+struct SignalDemand {
+    /// Drawn on at least one plot panel.
+    bool plotted = false;
+    /// Fraction of recent samples that differed from the one before, in [0, 1].
+    double activity = 1.0;
+};
+
+/// Splits one memory budget across the signal history of a subscription.
+///
+/// plan() sizes a SignalStore so its fixed costs (time ring, pyramids, guard bands)
+/// take at most half the budget, shrinking the archive and guard band for wide
+/// subscriptions. The rest is full-rate value samples, which allocate() hands out
+/// by weight: plotted signals count kPlottedWeight times more, and a signal that
+/// never changes still keeps kIdleWeight of an active one's share. Every column
+/// keeps at least SignalStore::kMinColumnCapacity samples and at most the store's
+/// capacity(), so the same budget serves 90 signals or 20k.
+class HistoryBudget {
+  public:
+    static constexpr size_t kDefaultBudgetBytes = size_t{2} << 30;
+    /// Largest full-rate window a single column is ever given (about 73 min at 60 Hz).
+    static constexpr size_t kMaxCapacity = size_t{1} << 18;
+    static constexpr size_t kMinArchiveBuckets = 64;
+    static constexpr size_t kMinGuard = 256;
+    static constexpr double kPlottedWeight = 8.0;
+    static constexpr double kIdleWeight = 0.125;
+    /// Relative change a column's target must exceed before rebalance() moves it.
+    static constexpr double kHysteresis = 0.25;
+    /// Share of the sample budget allocate() leaves unassigned, so columns held back
+    /// by hysteresis rarely push the total over budget.
+    static constexpr double kReserve = 0.0625;
+
+    explicit HistoryBudget(size_t budget_bytes = kDefaultBudgetBytes)
+        : budget_bytes_(budget_bytes) {}
+
+    [[nodiscard]] size_t budget_bytes() const { return budget_bytes_; }
+
+    /// Store geometry for `signal_count` signals, starting from an equal split.
+    [[nodiscard]] StoreGeometry plan(size_t signal_count) const;
+
+    /// Target capacity of every column of `store` for the given demand (one entry
+    /// per signal; missing entries count as unplotted and active).
+    [[nodiscard]] std::vector<size_t> allocate(const SignalStore &store,
+                                               std::span<const SignalDemand> demand) const;
+
+    /// Request the allocate() targets that moved by more than kHysteresis, plus any
+    /// shrink needed to stay within budget. Returns the number of columns resized.
+    size_t rebalance(SignalStore &store, std::span<const SignalDemand> demand) const;
+
+  private:
+    size_t budget_bytes_;
+};
+
+} // namespace daedalus::data
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "daedalus/data/buffer_pool.hpp"
+#include "daedalus/data/latency_histogram.hpp"
+#include "daedalus/data/signal_store.hpp"
+#include "daedalus/data/telemetry_queue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <utility>
+
+namespace daedalus::data {
+
+/// Drains decoded telemetry batches into the current SignalStore on a dedicated
+/// thread, so ingest throughput no longer depends on the render frame rate.
+///
+/// The ingest thread is the TelemetryQueue consumer: every popped batch goes back
+/// to the BatchPool. Batches whose width does not match the current store (e.g.
+/// frames still in flight from a previous subscription) are discarded.
+/// set_store(), start(), stop() and the counters may be used from any thread.
+class IngestThread {
+  public:
+    /// Poll interval while the telemetry queue is empty.
+    static constexpr std::chrono::microseconds kIdleWait{500};
+    /// Back-off while the render thread's snapshot blocks further writes.
+    static constexpr std::chrono::microseconds kPinnedWait{100};
+
+    IngestThread(TelemetryQueue &queue, BatchPool &pool);
+    ~IngestThread();
+
+    IngestThread(const IngestThread &) = delete;
+    IngestThread &operator=(const IngestThread &) = delete;
+
+    void start();
+    void stop();
+    [[nodiscard]] bool running() const { return thread_.joinable(); }
+
+    /// Run `hook` on the ingest thread each time it finds the queue empty, before
+    /// it sleeps; the pipeline uses it to publish batches a paused producer still
+    /// holds. Set before start().
+    void set_idle_hook(std::function<void()> hook) { idle_hook_ = std::move(hook); }
+
+    /// Route subsequent batches to `store`; nullptr discards them.
+    void set_store(std::shared_ptr<SignalStore> store);
+
+    [[nodiscard]] uint64_t rows_ingested() const {
+        return rows_ingested_.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] uint64_t rows_discarded() const {
+        return rows_discarded_.load(std::memory_order_relaxed);
+    }
+    /// Rows ingested times their width: values written to stores.
+    [[nodiscard]] uint64_t samples_ingested() const {
+        return samples_ingested_.load(std::memory_order_relaxed);
+    }
+    /// Per ingested batch, from the receipt of its first frame until the batch is
+    /// in the store: the latency of its oldest row.
+    [[nodiscard]] const LatencyHistogram &ingest_latency() const { return ingest_latency_; }
+    /// Times the writer had to wait for a render-thread snapshot.
+    [[nodiscard]] uint64_t pinned_waits() const {
+        return pinned_waits_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    void run(const std::stop_token &stop);
+
+    TelemetryQueue &queue_;
+    BatchPool &pool_;
+    std::function<void()> idle_hook_;
+    std::jthread thread_;
+
+    std::mutex store_mutex_;
+    std::shared_ptr<SignalStore> next_store_;
+    std::atomic<uint64_t> store_generation_{0};
+
+    std::atomic<uint64_t> rows_ingested_{0};
+    std::atomic<uint64_t> rows_discarded_{0};
+    std::atomic<uint64_t> samples_ingested_{0};
+    LatencyHistogram ingest_latency_;
+    std::atomic<uint64_t> pinned_waits_{0};
+};
+
+} // namespace daedalus::data
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace daedalus::data {
+
+/// Log-linear histogram of durations: 8 buckets per power of two, so a quantile
+/// is reported within 12.5% of the true value, in fixed memory and without
+/// allocating. Covers 1 ns to centuries.
+///
+/// One thread records; any thread may read. Buckets are individually atomic, so
+/// a reader sees a consistent-enough view for monitoring, not an exact cut.
+class LatencyHistogram {
+  public:
+    /// Record one duration (negative counts as zero).
+    void record(std::chrono::nanoseconds duration) {
+        const auto ns = static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0));
+        buckets_[bucket_of(ns)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        if (ns > max_ns_.load(std::memory_order_relaxed)) {
+            max_ns_.store(ns, std::memory_order_relaxed);
+        }
+    }
+
+    [[nodiscard]] uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::chrono::nanoseconds max() const {
+        return std::chrono::nanoseconds(max_ns_.load(std::memory_order_relaxed));
+    }
+
+    /// Smallest bucket bound at or above a `q` fraction (0..1) of the recorded
+    /// durations, capped at the largest one seen; zero if nothing was recorded.
+    [[nodiscard]] std::chrono::nanoseconds quantile(double q) const {
+        const uint64_t total = count();
+        if (total == 0) {
+            return std::chrono::nanoseconds(0);
+        }
+        const auto rank = static_cast<uint64_t>(std::clamp(q, 0.0, 1.0) *
+                                                static_cast<double>(total - 1)) +
+                          1;
+        uint64_t seen = 0;
+        for (size_t b = 0; b < kBuckets; ++b) {
+            seen += buckets_[b].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                return std::min(std::chrono::nanoseconds(static_cast<int64_t>(bucket_limit(b))),
+                                max());
+            }
+        }
+        return max();
+    }
+
+  private:
+    static constexpr unsigned kSubBits = 3;
+    static constexpr uint64_t kSub = uint64_t{1} << kSubBits;
+    /// Values below kSub have a bucket each; above, kSub per power of two.
+    static constexpr size_t kBuckets = (64 - kSubBits + 1) * kSub;
+
+    static size_t bucket_of(uint64_t ns) {
+        if (ns < kSub) {
+            return static_cast<size_t>(ns);
+        }
+        const unsigned exponent = static_cast<unsigned>(std::bit_width(ns)) - 1;
+        const uint64_t sub = (ns >> (exponent - kSubBits)) & (kSub - 1);
+        return static_cast<size_t>((exponent - kSubBits + 1) * kSub + sub);
+    }
+
+    /// Largest value in bucket `b`.
+    static uint64_t bucket_limit(size_t b) {
+        if (b < kSub) {
+            return b;
+        }
+        const unsigned shift = static_cast<unsigned>(b / kSub) - 1;
+        const uint64_t sub = b % kSub;
+        return ((kSub + sub + 1) << shift) - 1;
+    }
+
+    std::array<std::atomic<uint64_t>, kBuckets> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> max_ns_{0};
+};
+
+} // namespace daedalus::data
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+namespace daedalus::data {
+
+/// How many frames an item stands for in queue statistics (see QueueStats). One
+/// by default; an item type that carries several frames specialises this next
+/// to its definition.
+template <typename T> struct QueueItemWeight {
+    static uint64_t of(const T &) { return 1; }
+};
+
+} // namespace daedalus::data
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+
+namespace daedalus::data {
+
+/// Minimum, maximum, sum and count of a range of samples.
+struct RangeStats {
+    double min = 0.0;
+    double max = 0.0;
+    double sum = 0.0;
+    size_t count = 0;
+
+    [[nodiscard]] bool empty() const { return count == 0; }
+    [[nodiscard]] double mean() const {
+        return count > 0 ? sum / static_cast<double>(count) : 0.0;
+    }
+    /// Fold in `n` samples with the given extremes and sum.
+    void merge(double lo, double hi, double total, size_t n) {
+        if (n == 0) {
+            return;
+        }
+        min = count == 0 ? lo : std::min(min, lo);
+        max = count == 0 ? hi : std::max(max, hi);
+        sum += total;
+        count += n;
+    }
+    void merge(const RangeStats &other) { merge(other.min, other.max, other.sum, other.count); }
+};
+
+/// Instruction sets the scan kernels are built for, in increasing order.
+enum class ScanIsa { Scalar, Sse2, Avx2 };
+
+[[nodiscard]] const char *scan_isa_name(ScanIsa isa);
+[[nodiscard]] bool scan_isa_supported(ScanIsa isa);
+/// Best instruction set of this CPU, detected once.
+[[nodiscard]] ScanIsa detected_scan_isa();
+
+/// Scans over contiguous doubles, one table per instruction set.
+///
+/// Ring buffers hand these their contents as at most two contiguous spans (see
+/// SignalView::value_spans()). The SIMD versions are compiled with per-function
+/// target attributes and picked at runtime, so one binary runs on any x86-64;
+/// other architectures and compilers get the scalar table.
+struct ScanKernels {
+    ScanIsa isa;
+    /// Min, max, sum and count. Min and max skip NaNs; the sum propagates them.
+    RangeStats (*stats)(const double *values, size_t n);
+    /// First i in [1, n) where values[i - 1] and values[i] lie on different sides
+    /// of `threshold` (a value equal to it counts as above), or n if none.
+    size_t (*find_crossing)(const double *values, size_t n, double threshold);
+    /// First i with values[i] >= target in ascending `values`, or n if none.
+    size_t (*lower_bound)(const double *values, size_t n, double target);
+};
+
+/// Kernels for `isa`, or for the best supported set below it.
+[[nodiscard]] const ScanKernels &scan_kernels(ScanIsa isa);
+/// Kernels for this CPU.
+[[nodiscard]] const ScanKernels &scan_kernels();
+
+[[nodiscard]] inline RangeStats scan_stats(std::span<const double> values) {
+    return scan_kernels().stats(values.data(), values.size());
+}
+[[nodiscard]] inline size_t scan_crossing(std::span<const double> values, double threshold) {
+    return scan_kernels().find_crossing(values.data(), values.size(), threshold);
+}
+[[nodiscard]] inline size_t scan_lower_bound(std::span<const double> sorted, double target) {
+    return scan_kernels().lower_bound(sorted.data(), sorted.size(), target);
+}
+
+} // namespace daedalus::data
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "daedalus/data/scan_kernels.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace daedalus::data {
+
+class SignalView;
+
+/// Ring geometry of a level-of-detail pyramid, shared by every column of a
+/// SignalStore (the time column included).
+///
+/// Level l summarises each bucket of 2^shift(l) consecutive samples (bucket b
+/// covers samples [b << shift, (b + 1) << shift)) as its minimum and maximum,
+/// stored in the order they occur so a decimated polyline keeps the signal's
+/// shape, plus its mean. For the time column that is the bucket's first time,
+/// last time and mean time.
+///
+/// The pyramid doubles as the long-term history. Every level retains the newest
+/// `archive_buckets` buckets, so each coarser level reaches twice as far back for
+/// the same memory. Each ring has extra slots for the writer's guard band, so
+/// every readable bucket a snapshot can see survives while the snapshot is pinned.
+class LodLayout {
+  public:
+    /// Finest level summarises 8 samples; finer levels would cost more memory than
+    /// the draw calls they save.
+    static constexpr unsigned kBaseShift = 3;
+    /// Doubles per bucket: two ordered extremes and the mean.
+    static constexpr size_t kEntryDoubles = 3;
+
+    LodLayout() = default;
+    /// Levels for a full-rate window of up to `capacity` samples, a writer guard
+    /// band of `guard` samples, and `archive_buckets` retained buckets per level.
+    LodLayout(size_t capacity, size_t guard, size_t archive_buckets);
+
+    [[nodiscard]] size_t levels() const { return slots_.size(); }
+    [[nodiscard]] static unsigned shift(size_t level) {
+        return kBaseShift + static_cast<unsigned>(level);
+    }
+    [[nodiscard]] size_t slots(size_t level) const { return slots_[level]; }
+    /// Newest buckets of a level a snapshot may read.
+    [[nodiscard]] size_t readable(size_t level) const { return readable_[level]; }
+    /// Offset of a level's ring within one column's pyramid, in doubles.
+    [[nodiscard]] size_t offset(size_t level) const { return offsets_[level]; }
+    /// Doubles needed for one column's pyramid.
+    [[nodiscard]] size_t column_doubles() const { return column_doubles_; }
+
+  private:
+    std::vector<size_t> slots_;
+    std::vector<size_t> readable_;
+    std::vector<size_t> offsets_;
+    size_t column_doubles_ = 0;
+};
+
+/// Read side of one column's pyramid, with the time pyramid it shares.
+/// Empty for histories without one.
+class LodColumn {
+  public:
+    LodColumn() = default;
+    LodColumn(const double *times, const double *values, const LodLayout *layout)
+        : times_(times), values_(values), layout_(layout) {}
+
+    [[nodiscard]] size_t levels() const { return layout_ ? layout_->levels() : 0; }
+    [[nodiscard]] const LodLayout &layout() const { return *layout_; }
+
+    /// Extreme of bucket `bucket` at `level` that occurs first (which = 0) or last.
+    [[nodiscard]] double extreme(size_t level, uint64_t bucket, size_t which) const {
+        return values_[entry(level, bucket) + which];
+    }
+    [[nodiscard]] double mean(size_t level, uint64_t bucket) const {
+        return values_[entry(level, bucket) + 2];
+    }
+    [[nodiscard]] double first_time(size_t level, uint64_t bucket) const {
+        return times_[entry(level, bucket)];
+    }
+    [[nodiscard]] double last_time(size_t level, uint64_t bucket) const {
+        return times_[entry(level, bucket) + 1];
+    }
+
+  private:
+    [[nodiscard]] size_t entry(size_t level, uint64_t bucket) const {
+        const size_t slot = static_cast<size_t>(bucket % layout_->slots(level));
+        return layout_->offset(level) + LodLayout::kEntryDoubles * slot;
+    }
+
+    const double *times_ = nullptr;
+    const double *values_ = nullptr;
+    const LodLayout *layout_ = nullptr;
+};
+
+/// Fold samples [from, to) of a ring of `physical` slots into the pyramid at
+/// `pyramid` (writer only). Every bucket completed by those samples is written,
+/// finest level first, so it must run before the samples are published.
+void lod_update(double *pyramid, const LodLayout &layout, const double *ring, size_t physical,
+                uint64_t from, uint64_t to);
+
+/// Aggregate samples [start, start + count) of a view from its pyramid: the range
+/// is split into the largest aligned buckets still retained, so a window of n
+/// samples costs O(log n) bucket reads plus the few unaligned samples at its edges.
+/// Near the old end of a long view, where the finest levels have been recycled,
+/// the edges are read raw up to the first retained bucket. Raw runs, and views
+/// without a pyramid, go through the SIMD scan kernels.
+[[nodiscard]] RangeStats range_stats(const SignalView &view, size_t start, size_t count);
+
+/// A time window of a SignalView reduced to about `max_points` points for drawing,
+/// reading across the full-rate samples and the archived pyramid levels.
+///
+/// Whole buckets inside the window contribute their (min, max) pair at the times
+/// of the bucket's first and last sample; partial buckets at either edge are drawn
+/// raw. The level chosen is the finest whose buckets are at least
+/// count / (max_points / 2) samples wide and still retained, so with
+/// max_points = 2 x pixel width every pixel column gets about two points and no
+/// peak is lost. A window that starts before the full-rate samples uses the finest
+/// level that still reaches back that far, then steps down through one bucket of
+/// each finer level to the raw samples, so the line stays continuous whatever the
+/// column's capacity. Falls back to the raw samples when the window is small
+/// enough or the view has no pyramid; a window that hits no samples shows the
+/// whole view.
+class DecimatedSeries {
+  public:
+    DecimatedSeries(const SignalView &view, double x_min, double x_max, size_t max_points);
+
+    [[nodiscard]] size_t size() const { return head_ + 2 * (buckets_ + steps_.size()) + tail_; }
+    [[nodiscard]] bool empty() const { return size() == 0; }
+    /// Samples per bucket, or 1 when drawing raw samples.
+    [[nodiscard]] size_t stride() const { return buckets_ > 0 ? size_t{1} << shift_ : 1; }
+    /// True if some points come from samples older than the full-rate window.
+    [[nodiscard]] bool archived() const { return archived_; }
+
+    [[nodiscard]] double time_at(size_t i) const;
+    [[nodiscard]] double value_at(size_t i) const;
+
+  private:
+    /// Pick the bucket range for samples [start, start + count) of the view.
+    void decimate_samples(size_t start, size_t count, size_t max_points);
+    /// Pick the bucket range for a window reaching back past the view.
+    void decimate_archive(double x_min, double x_max, size_t end, size_t max_points);
+    /// Logical view index of raw point i (i < head_ or in the tail).
+    [[nodiscard]] size_t raw_index(size_t i) const;
+    /// Pyramid bucket behind point i, or false if it is a raw sample.
+    bool bucket_at(size_t i, size_t &level, uint64_t &bucket) const;
+
+    const SignalView *view_;
+    LodColumn lod_;
+    size_t start_ = 0;
+    size_t head_ = 0;
+    uint64_t buckets_ = 0;
+    size_t tail_ = 0;
+    size_t tail_start_ = 0;
+    size_t level_ = 0;
+    unsigned shift_ = 0;
+    uint64_t first_bucket_ = 0;
+    /// Single (level, bucket) entries bridging the main level to the raw tail.
+    std::vector<std::pair<size_t, uint64_t>> steps_;
+    bool archived_ = false;
+};
+
+} // namespace daedalus::data
@@ -0,0 +1,212 @@
+#pragma once
+
+#include "daedalus/data/frame_batch.hpp"
+#include "daedalus/data/signal_lod.hpp"
+#include "daedalus/data/signal_view.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace daedalus::data {
+
+class SignalStore;
+
+/// Consistent read-side view of a SignalStore, normally held for one render frame.
+/// Every series is frozen at the same sample count. While a snapshot is alive the
+/// store is pinned: the ingest thread will not overwrite any sample it can see.
+/// Move-only; releasing (destroying or reassigning) it unpins the store.
+class StoreSnapshot {
+  public:
+    StoreSnapshot() = default;
+    ~StoreSnapshot();
+
+    StoreSnapshot(StoreSnapshot &&other) noexcept;
+    StoreSnapshot &operator=(StoreSnapshot &&other) noexcept;
+    StoreSnapshot(const StoreSnapshot &) = delete;
+    StoreSnapshot &operator=(const StoreSnapshot &) = delete;
+
+    /// View of one signal, or nullptr if the index is not part of the subscription.
+    [[nodiscard]] const SignalView *find(size_t index) const {
+        return index < series_.size() ? &series_[index] : nullptr;
+    }
+
+    [[nodiscard]] size_t signal_count() const { return series_.size(); }
+    /// Rows (frames) ingested when the snapshot was taken.
+    [[nodiscard]] uint64_t samples() const { return samples_; }
+    [[nodiscard]] bool empty() const { return series_.empty() || series_.front().empty(); }
+    /// Simulation time of the newest row. UB if empty().
+    [[nodiscard]] double last_time() const { return series_.front().last_time(); }
+
+  private:
+    friend class SignalStore;
+
+    void release();
+
+    std::shared_ptr<SignalStore> store_;
+    std::vector<SignalView> series_;
+    uint64_t samples_ = 0;
+};
+
+/// Sizing of a SignalStore (see HistoryBudget for deriving one from a memory budget).
+struct StoreGeometry {
+    /// Largest full-rate window any column may be given; sizes the shared time ring.
+    /// The default holds 5 min at 60 Hz.
+    size_t capacity = 18000;
+    /// Rows the writer may run ahead of a pinned snapshot before it has to wait.
+    size_t guard = 4096;
+    /// Buckets every pyramid level retains. With the default full-rate window the
+    /// coarsest level (8192 samples per bucket) then reaches back about 8.4M
+    /// samples: over 2 hours at 1 kHz, or 38 hours at 60 Hz.
+    size_t archive_buckets = 1024;
+    /// Initial full-rate window of every column; 0 means `capacity`.
+    size_t column_capacity = 0;
+};
+
+/// Columnar signal history for one subscription.
+///
+/// Every signal in a telemetry frame shares the frame's timestamp, so the store
+/// keeps a single time ring plus one dense value ring per signal, indexed by
+/// subscription order. Rings start on their own cache line and all advance
+/// together under a single published row count.
+/// Every column also keeps a min/max/mean pyramid (see LodLayout), updated as rows
+/// arrive. Plots use it to draw a bounded number of points per pixel, and its
+/// coarse levels keep a decimated history long after the full-rate window has
+/// moved on.
+///
+/// Each value ring has its own full-rate capacity, up to the store's capacity(),
+/// so a memory budget can favour the signals that matter (see HistoryBudget).
+/// set_column_capacity() may be called from any thread; the writer reallocates
+/// the ring on its next append, keeping the newest samples.
+///
+/// Single writer (the ingest thread) appends rows while a single reader (the render
+/// thread) works from StoreSnapshots. Synchronisation is an epoch pin rather than
+/// a lock: a snapshot publishes the row count it froze, and the writer stays within
+/// the guard band past that count until the snapshot is released. Rings replaced by
+/// a capacity change are freed only once no snapshot can still be reading them.
+class SignalStore : public std::enable_shared_from_this<SignalStore> {
+  public:
+    static constexpr size_t kDefaultCapacity = StoreGeometry{}.capacity;
+    static constexpr size_t kDefaultGuard = StoreGeometry{}.guard;
+    static constexpr size_t kDefaultArchiveBuckets = StoreGeometry{}.archive_buckets;
+    /// Smallest full-rate window a column can be shrunk to.
+    static constexpr size_t kMinColumnCapacity = 64;
+    /// Alignment of the time ring and of every value ring.
+    static constexpr size_t kColumnAlignment = 64;
+
+    explicit SignalStore(size_t signal_count, size_t capacity = kDefaultCapacity,
+                         size_t guard = kDefaultGuard,
+                         size_t archive_buckets = kDefaultArchiveBuckets);
+    SignalStore(size_t signal_count, const StoreGeometry &geometry);
+
+    SignalStore(const SignalStore &) = delete;
+    SignalStore &operator=(const SignalStore &) = delete;
+
+    [[nodiscard]] size_t signal_count() const { return signal_count_; }
+    [[nodiscard]] size_t capacity() const { return capacity_; }
+    [[nodiscard]] size_t guard() const { return guard_; }
+    [[nodiscard]] const LodLayout &lod_layout() const { return lod_layout_; }
+
+    /// Request a new full-rate window for one column (any thread), clamped to
+    /// [kMinColumnCapacity, capacity()]. Takes effect on the writer's next append.
+    void set_column_capacity(size_t signal, size_t capacity);
+    /// Full-rate window of a column as currently allocated.
+    [[nodiscard]] size_t column_capacity(size_t signal) const {
+        return columns_[signal].capacity.load(std::memory_order_relaxed);
+    }
+    /// Bytes held for one column: its value ring (guard band and padding included)
+    /// and its pyramid.
+    [[nodiscard]] size_t column_bytes(size_t signal) const;
+    /// Samples of a column that differed from the one before (writer-maintained).
+    [[nodiscard]] uint64_t column_changes(size_t signal) const {
+        return columns_[signal].changes.load(std::memory_order_relaxed);
+    }
+    /// Bytes held beyond the columns' full-rate samples: the time ring, every
+    /// pyramid, and each value ring's guard band and padding.
+    [[nodiscard]] size_t fixed_bytes() const;
+    /// Bytes currently held by the store.
+    [[nodiscard]] size_t memory_bytes() const;
+
+    /// Rows appended so far (any thread).
+    [[nodiscard]] uint64_t samples() const { return samples_.load(std::memory_order_acquire); }
+
+    /// Append rows [first_row, batch.rows) of a batch with matching signal_count
+    /// (writer only). Writes as many rows as the reader's pin allows and returns
+    /// that count; 0 means the writer must wait for the current snapshot to go.
+    size_t append_rows(const FrameBatch &batch, size_t first_row = 0);
+
+    /// Freeze and pin the current contents (reader only; one snapshot at a time).
+    [[nodiscard]] StoreSnapshot snapshot();
+
+  private:
+    friend class StoreSnapshot;
+
+    static constexpr uint64_t kUnpinned = std::numeric_limits<uint64_t>::max();
+
+    struct AlignedDelete {
+        void operator()(double *p) const {
+            ::operator delete[](p, std::align_val_t{kColumnAlignment});
+        }
+    };
+    using AlignedArray = std::unique_ptr<double[], AlignedDelete>;
+
+    /// One column's full-rate samples. Immutable geometry once published.
+    struct ValueRing {
+        size_t capacity;
+        size_t physical;
+        uint64_t first_valid; ///< Oldest sample index the ring was filled from.
+        AlignedArray data;
+    };
+
+    struct Column {
+        std::unique_ptr<ValueRing> owner; ///< Writer only; readers go through `ring`.
+        std::atomic<ValueRing *> ring{nullptr};
+        std::atomic<size_t> capacity{0};
+        std::atomic<size_t> requested{0}; ///< Pending capacity; 0 = none.
+        std::atomic<uint64_t> changes{0};
+        double last_value = 0.0; ///< Writer only.
+    };
+
+    struct RetiredRing {
+        uint64_t epoch;
+        std::unique_ptr<ValueRing> ring;
+    };
+
+    void unpin() {
+        pin_.store(kUnpinned, std::memory_order_release);
+        reader_epoch_.fetch_add(1, std::memory_order_seq_cst);
+    }
+    /// Writer: swap in rings for pending capacity requests, and free retired rings
+    /// no snapshot can still see.
+    void apply_capacity_requests(uint64_t written);
+    void reclaim_retired();
+
+    /// Pyramids: the time column's first, then one per signal.
+    [[nodiscard]] double *lod_column(size_t slot) {
+        return lod_storage_.get() + slot * lod_stride_;
+    }
+    [[nodiscard]] const double *lod_column(size_t slot) const {
+        return lod_storage_.get() + slot * lod_stride_;
+    }
+
+    size_t signal_count_;
+    size_t capacity_;
+    size_t guard_;
+    size_t physical_;
+    AlignedArray times_;
+    LodLayout lod_layout_;
+    size_t lod_stride_;
+    AlignedArray lod_storage_;
+    std::unique_ptr<Column[]> columns_;
+    std::vector<RetiredRing> retired_; ///< Writer only.
+    std::atomic<uint64_t> samples_{0};
+    std::atomic<uint64_t> pin_{kUnpinned};
+    /// Odd while a snapshot is being taken or held.
+    std::atomic<uint64_t> reader_epoch_{0};
+};
+
+} // namespace daedalus::data
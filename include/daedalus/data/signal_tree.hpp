@@ -2,10 +2,13 @@
 
 #include "daedalus/protocol/schema.hpp"
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
 namespace daedalus::data {
@@ -13,21 +16,52 @@ namespace daedalus::data {
 /// A node in the hierarchical signal tree.
 /// Internal nodes represent namespace segments (e.g., "vehicle", "position").
 /// Leaf nodes represent actual signals (e.g., "x" with full_path "vehicle.position.x").
+/// Nodes belong to their SignalTree: `name` and `full_path` view its path buffer
+/// (not NUL-terminated) and `children` its child table, all valid until the tree
+/// is rebuilt or cleared.
 struct SignalTreeNode {
-    std::string name;
-    std::string full_path;
+    std::string_view name;
+    std::string_view full_path;
     bool is_leaf = false;
     std::optional<size_t> signal_index; // set after subscribe ack
-    std::vector<std::unique_ptr<SignalTreeNode>> children;
+    size_t preorder = 0;                // position in the tree's node table (root = 0)
+    std::span<SignalTreeNode *const> children;
+};
 
-    /// Find a direct child by name.
-    SignalTreeNode *find_child(const std::string &child_name) const;
+/// One row of the flattened signal browser.
+struct SignalTreeRow {
+    const SignalTreeNode *node;
+    size_t depth; ///< 0 for the root's children.
 };
 
 /// Hierarchical signal namespace built from the Hermes schema.
+///
+/// Built without per-node allocations: the signal paths are laid out back to back
+/// in one buffer, every node sits in one arena and views its path there (an
+/// interior node views the prefix of the first signal below it, its name the last
+/// segment), children are slices of one pointer table, and paths are looked up in
+/// an open-addressed hash table of arena indices.
+///
+/// Also keeps the filter index for the signal browser: every node's lowercased
+/// full path, computed once per schema, and the set of nodes visible under the
+/// current filter text, recomputed only when that text changes. A node is
+/// visible if its path contains the filter (case-insensitive) or any descendant's
+/// does. Its name is the last segment of its path, so the path check covers both.
+///
+/// The browser draws the tree as a flat list of rows, the visible nodes under
+/// expanded ancestors in display order, so it can skip everything off screen.
+/// The list is rebuilt only after the filter or an expansion state changes.
+/// Expansion state is kept by path across schema rebuilds.
 /// Thread safety: render thread only.
 class SignalTree {
   public:
+    SignalTree();
+
+    SignalTree(const SignalTree &) = delete;
+    SignalTree &operator=(const SignalTree &) = delete;
+    SignalTree(SignalTree &&) = default;
+    SignalTree &operator=(SignalTree &&) = default;
+
     /// Build tree from a parsed schema.
     /// Signal paths are "module.signal_name" (e.g., "vehicle.position.x").
     void build_from_schema(const protocol::Schema &schema);
@@ -37,25 +71,117 @@ class SignalTree {
     void update_subscription(const protocol::SubscribeAck &ack);
 
     /// Access the root node.
-    [[nodiscard]] const SignalTreeNode &root() const { return root_; }
+    [[nodiscard]] const SignalTreeNode &root() const { return arena_.front(); }
 
     /// Lookup a node by its full path (e.g., "vehicle.position.x").
     /// Returns nullptr if not found.
-    [[nodiscard]] const SignalTreeNode *find(const std::string &path) const;
+    [[nodiscard]] const SignalTreeNode *find(std::string_view path) const;
 
     /// Get all leaf signal paths.
     [[nodiscard]] std::vector<std::string> all_signals() const;
 
-    /// Clear the tree.
+    /// Clear the tree. The filter text is kept.
     void clear();
 
+    /// Set the filter text. Cheap when unchanged; otherwise re-tests node paths.
+    /// When the new text contains the old, only nodes that matched before are
+    /// tested again. Returns true if the visible set may have changed.
+    bool set_filter(std::string_view text);
+    [[nodiscard]] const std::string &filter() const { return filter_text_; }
+
+    /// True if the node passes the current filter (always true with no filter).
+    [[nodiscard]] bool visible(const SignalTreeNode &node) const {
+        return filter_.empty() || visible_[node.preorder];
+    }
+
+    /// Nodes in the filter index, the root included.
+    [[nodiscard]] size_t node_count() const { return nodes_.size(); }
+
+    /// Whether an internal node shows its children. All nodes start collapsed.
+    [[nodiscard]] bool expanded(const SignalTreeNode &node) const {
+        return expanded_[node.preorder];
+    }
+    void set_expanded(const SignalTreeNode &node, bool expanded);
+    /// Expand or collapse every internal node.
+    void set_all_expanded(bool expanded);
+
+    /// Rows to draw, in display order. Rebuilt here if the filter or expansion
+    /// state changed since the last call; the reference stays valid until then.
+    [[nodiscard]] const std::vector<SignalTreeRow> &rows();
+
   private:
-    /// Ensure a path of nodes exists, creating intermediate nodes as needed.
-    /// Returns the final (deepest) node.
-    SignalTreeNode &ensure_path(const std::string &full_path);
+    static constexpr uint32_t kNoNode = UINT32_MAX;
+
+    /// Nodes in fixed-size blocks: growing never moves a node, and a build costs
+    /// one allocation per kBlockNodes nodes.
+    class NodeArena {
+      public:
+        static constexpr size_t kBlockNodes = 1024;
+
+        [[nodiscard]] size_t size() const { return size_; }
+        SignalTreeNode &operator[](size_t i) { return blocks_[i / kBlockNodes][i % kBlockNodes]; }
+        const SignalTreeNode &operator[](size_t i) const {
+            return blocks_[i / kBlockNodes][i % kBlockNodes];
+        }
+        [[nodiscard]] const SignalTreeNode &front() const { return blocks_.front()[0]; }
+
+        SignalTreeNode &emplace_back() {
+            if (size_ % kBlockNodes == 0) {
+                blocks_.push_back(std::make_unique<SignalTreeNode[]>(kBlockNodes));
+            }
+            return (*this)[size_++];
+        }
+        void reserve_blocks(size_t nodes) {
+            blocks_.reserve((nodes + kBlockNodes - 1) / kBlockNodes);
+        }
+        void clear() {
+            blocks_.clear();
+            blocks_.shrink_to_fit();
+            size_ = 0;
+        }
+
+      private:
+        std::vector<std::unique_ptr<SignalTreeNode[]>> blocks_;
+        size_t size_ = 0;
+    };
+
+    /// Hash-table slot holding `path`, or the empty slot where it would go.
+    [[nodiscard]] uint32_t &path_slot(std::string_view path);
+    [[nodiscard]] uint32_t find_index(std::string_view path) const;
+    /// Size the hash table for `nodes` entries and insert every non-root node.
+    void rehash(size_t nodes);
+    /// Point every node's `children` at its run of the child table.
+    void link_children(const std::vector<uint32_t> &parents);
+
+    /// Lowercased full path of a non-root node.
+    [[nodiscard]] std::string_view lowered_path(const SignalTreeNode &node) const {
+        return {lowered_.data() + (node.full_path.data() - paths_.data()),
+                node.full_path.size()};
+    }
+
+    /// Number the nodes in preorder and lowercase their paths.
+    void index_nodes();
+    /// Recompute the visible set; `narrowing` re-tests only earlier matches.
+    void apply_filter(bool narrowing);
+    void rebuild_rows();
+
+    std::vector<char> paths_;                   ///< Every signal path, back to back.
+    NodeArena arena_;                           ///< Creation order; arena_[0] is the root.
+    std::vector<SignalTreeNode *> child_slots_; ///< Children of each node, contiguous.
+    std::vector<uint32_t> path_slots_;          ///< Arena index by full path; kNoNode = empty.
+
+    // Filter index, by preorder position.
+    std::vector<const SignalTreeNode *> nodes_;
+    std::vector<size_t> parents_;
+    std::vector<char> lowered_; ///< paths_, lowercased.
+    std::string filter_text_;   ///< As typed.
+    std::string filter_;        ///< Lowercased.
+    std::vector<bool> matches_; ///< Path contains the filter.
+    std::vector<bool> visible_; ///< Node or a descendant matches.
 
-    SignalTreeNode root_;
-    std::unordered_map<std::string, SignalTreeNode *> path_index_;
+    std::vector<bool> expanded_;
+    std::vector<SignalTreeRow> rows_;
+    bool rows_dirty_ = true;
 };
 
 } // namespace daedalus::data
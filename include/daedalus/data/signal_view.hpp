@@ -0,0 +1,145 @@
+#pragma once
+
+#include "daedalus/data/scan_kernels.hpp"
+#include "daedalus/data/signal_lod.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace daedalus::data {
+
+class SignalStore;
+
+/// A run of ring slots as at most two contiguous spans, oldest first.
+struct RingSpans {
+    std::span<const double> first;
+    std::span<const double> second;
+
+    [[nodiscard]] size_t size() const { return first.size() + second.size(); }
+};
+
+/// Read-only window onto one SignalStore column, frozen at a given sample count.
+/// Logical index 0 is the oldest visible sample. A view stays valid while the
+/// writer has appended no more than the store's guard band past its end; the
+/// store enforces that through its snapshots.
+class SignalView {
+  public:
+    SignalView() = default;
+
+    [[nodiscard]] size_t size() const { return count_; }
+    [[nodiscard]] bool empty() const { return count_ == 0; }
+
+    /// Total samples written up to this view (monotonic).
+    [[nodiscard]] uint64_t end() const { return first_ + count_; }
+
+    [[nodiscard]] double time_at(size_t i) const { return times_[time_index(i)]; }
+    [[nodiscard]] double value_at(size_t i) const { return values_[value_index(i)]; }
+
+    /// Most recent sample. UB if empty.
+    [[nodiscard]] double last_value() const { return value_at(count_ - 1); }
+    [[nodiscard]] double last_time() const { return time_at(count_ - 1); }
+
+    /// Samples [start, start + count) as contiguous spans, for the scan kernels.
+    [[nodiscard]] RingSpans time_spans(size_t start, size_t count) const {
+        return ring_spans(times_, time_physical_, first_ + start, count);
+    }
+    [[nodiscard]] RingSpans value_spans(size_t start, size_t count) const {
+        return ring_spans(values_, value_physical_, first_ + start, count);
+    }
+
+    /// Min/max pyramid over the same samples; empty for a default view.
+    [[nodiscard]] LodColumn lod() const { return lod_; }
+
+    /// Copy data into contiguous staging buffers for ImPlot.
+    void copy_to(std::vector<double> &out_times, std::vector<double> &out_values) const {
+        out_times.resize(count_);
+        out_values.resize(count_);
+        for (size_t i = 0; i < count_; ++i) {
+            out_times[i] = time_at(i);
+            out_values[i] = value_at(i);
+        }
+    }
+
+    /// Find first logical sample index where time >= target.
+    /// Returns size() if no sample satisfies the predicate.
+    [[nodiscard]] size_t lower_bound_time(double target) const {
+        const RingSpans times = time_spans(0, count_);
+        const size_t first = scan_lower_bound(times.first, target);
+        if (first < times.first.size()) {
+            return first;
+        }
+        return first + scan_lower_bound(times.second, target);
+    }
+
+    /// Find first logical sample index where time > target.
+    /// Returns size() if all samples are <= target.
+    [[nodiscard]] size_t upper_bound_time(double target) const {
+        if (target == std::numeric_limits<double>::infinity()) {
+            return count_;
+        }
+        return lower_bound_time(std::nextafter(target, std::numeric_limits<double>::infinity()));
+    }
+
+    /// Compute a visible logical range [start, start + count) for an X-axis window.
+    [[nodiscard]] std::pair<size_t, size_t> visible_range(double x_min, double x_max) const {
+        if (count_ == 0 || x_min > x_max) {
+            return {0, 0};
+        }
+
+        size_t start = lower_bound_time(x_min);
+        if (start > 0) {
+            --start;
+        }
+
+        size_t end = upper_bound_time(x_max);
+        if (end < count_) {
+            ++end;
+        }
+        if (end > count_) {
+            end = count_;
+        }
+
+        if (start >= end) {
+            return {0, 0};
+        }
+        return {start, end - start};
+    }
+
+  private:
+    friend class SignalStore;
+
+    /// Times and values may live in rings of different sizes (see SignalStore).
+    SignalView(const double *times, size_t time_physical, const double *values,
+               size_t value_physical, uint64_t first, size_t count, LodColumn lod)
+        : times_(times), values_(values), time_physical_(time_physical),
+          value_physical_(value_physical), first_(first), count_(count), lod_(lod) {}
+
+    static RingSpans ring_spans(const double *ring, size_t physical, uint64_t first, size_t count) {
+        const auto pos = static_cast<size_t>(first % physical);
+        const size_t head = std::min(count, physical - pos);
+        return {{ring + pos, head}, {ring, count - head}};
+    }
+
+    [[nodiscard]] size_t time_index(size_t logical) const {
+        return static_cast<size_t>((first_ + logical) % time_physical_);
+    }
+    [[nodiscard]] size_t value_index(size_t logical) const {
+        return static_cast<size_t>((first_ + logical) % value_physical_);
+    }
+
+    const double *times_ = nullptr;
+    const double *values_ = nullptr;
+    size_t time_physical_ = 1;
+    size_t value_physical_ = 1;
+    uint64_t first_ = 0;
+    size_t count_ = 0;
+    LodColumn lod_;
+};
+
+} // namespace daedalus::data
@@ -1,11 +1,19 @@
 #pragma once
 
+#include "daedalus/data/queue_item_weight.hpp"
+
 #include <algorithm>
 #include <atomic>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
 #include <new>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace daedalus::data {
@@ -13,58 +21,419 @@ namespace daedalus::data {
 /// Single-producer single-consumer lock-free ring buffer.
 /// Producer: network thread (IXWebSocket callbacks).
 /// Consumer: render thread (ImGui frame loop).
-/// No mutexes — pure atomic acquire/release.
+/// No mutexes. A plain queue is pure atomic acquire/release: a pop is one store
+/// of the consumer's index, and a push one store of the producer's.
+///
+/// Indices are monotonic counters. A queue constructed `evictable` also lets the
+/// producer claim and evict the oldest item when it needs room (see
+/// try_evict_oldest()). Its read side is then split into a claim index (`head_`,
+/// next slot to hand out) and a release index (`release_`, oldest slot still owned
+/// by a reader), and every pop pays for the handshake with the producer: a
+/// seq_cst store and a CAS on `head_`. Only queues that evict should ask for it.
+///
+/// Slots are a power of two so an index maps to its slot with a mask; the
+/// requested capacity still bounds how many items are queued. Each side keeps a
+/// private copy of the other side's index and reloads the shared one only when
+/// that copy says the queue is full (producer) or empty (consumer), so in steady
+/// state neither side touches the other's cache line. The bulk calls move many
+/// items per atomic publish.
 template <typename T> class SPSCQueue {
   public:
-    explicit SPSCQueue(size_t capacity)
-        : capacity_(std::max<size_t>(capacity, 2)), buffer_(capacity_) {}
+    explicit SPSCQueue(size_t capacity, bool evictable = false)
+        : capacity_(std::max<size_t>(capacity, 2)), mask_(std::bit_ceil(capacity_) - 1),
+          evictable_(evictable), buffer_(mask_ + 1) {}
 
-    /// Push an item (producer only). Returns false if full.
+    /// Push an item (producer only). Returns false if full; `item` is left untouched.
     bool try_push(T &&item) {
         const size_t tail = tail_.load(std::memory_order_relaxed);
-        const size_t next = (tail + 1) % capacity_;
-        if (next == head_.load(std::memory_order_acquire)) {
+        if (free_slots(tail, 1) == 0) {
             return false; // full
         }
-        buffer_[tail] = std::move(item);
-        tail_.store(next, std::memory_order_release);
+        buffer_[tail & mask_] = std::move(item);
+        tail_.store(tail + 1, std::memory_order_release);
         return true;
     }
 
+    /// Push up to `count` items in order with a single publish (producer only).
+    /// Returns how many were pushed; those are moved from, the rest left untouched.
+    size_t try_push_bulk(T *items, size_t count) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t n = std::min(count, free_slots(tail, count));
+        for (size_t i = 0; i < n; ++i) {
+            buffer_[(tail + i) & mask_] = std::move(items[i]);
+        }
+        if (n > 0) {
+            tail_.store(tail + n, std::memory_order_release);
+        }
+        return n;
+    }
+
     /// Pop an item (consumer only). Returns false if empty.
-    bool try_pop(T &item) {
+    bool try_pop(T &item) { return try_pop_bulk(&item, 1) == 1; }
+
+    /// Pop up to `max` items, oldest first, with a single claim (consumer only).
+    /// Returns how many were written to `out`.
+    size_t try_pop_bulk(T *out, size_t max) {
+        if (max == 0) {
+            return 0;
+        }
+        if (evictable_) {
+            return pop_evictable(out, max);
+        }
+        // Nobody else moves head_, so it is published with a plain release store.
         const size_t head = head_.load(std::memory_order_relaxed);
-        if (head == tail_.load(std::memory_order_acquire)) {
+        const size_t n = available(head, max);
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = std::move(buffer_[(head + i) & mask_]);
+        }
+        if (n > 0) {
+            head_.store(head + n, std::memory_order_release);
+        }
+        return n;
+    }
+
+    /// Remove the oldest queued item to make room (producer only; evictable
+    /// queues only). Returns false if the queue is empty or the consumer claimed
+    /// that item first. The slot becomes writable immediately unless the consumer
+    /// is mid-read, in which case the consumer's own release frees it.
+    bool try_evict_oldest(T &item) {
+        if (!evictable_) {
+            return false;
+        }
+        size_t head = head_.load(std::memory_order_seq_cst);
+        if (head == tail_.load(std::memory_order_relaxed)) {
             return false; // empty
         }
-        item = std::move(buffer_[head]);
-        head_.store((head + 1) % capacity_, std::memory_order_release);
+        if (!head_.compare_exchange_strong(head, head + 1, std::memory_order_seq_cst,
+                                           std::memory_order_seq_cst)) {
+            return false; // consumer got there first
+        }
+        item = std::move(buffer_[head & mask_]);
+        if (!consumer_busy_.load(std::memory_order_seq_cst)) {
+            advance_release(head + 1);
+        }
         return true;
     }
 
+    /// True if the producer may evict (fixed at construction).
+    [[nodiscard]] bool evictable() const { return evictable_; }
+
     /// Approximate number of items (not exact under concurrency).
     [[nodiscard]] size_t size_approx() const {
         const size_t tail = tail_.load(std::memory_order_relaxed);
         const size_t head = head_.load(std::memory_order_relaxed);
-        return (tail + capacity_ - head) % capacity_;
+        return tail >= head ? tail - head : 0;
     }
 
     /// Usable capacity (one slot reserved for full/empty distinction).
     [[nodiscard]] size_t capacity() const { return capacity_ - 1; }
 
   private:
+    /// Items the consumer may take at `head`, at most `max` (consumer only). The
+    /// producer's index is reread only when the cached one can't fill the request.
+    size_t available(size_t head, size_t max) {
+        if (head >= cached_tail_ || cached_tail_ - head < max) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+        }
+        return head < cached_tail_ ? std::min(max, cached_tail_ - head) : 0;
+    }
+
+    /// try_pop_bulk() with the eviction handshake.
+    size_t pop_evictable(T *out, size_t max) {
+        // Announce the read before claiming so an evicting producer never
+        // releases the slots out from under us (see try_evict_oldest()).
+        consumer_busy_.store(true, std::memory_order_seq_cst);
+        size_t head = head_.load(std::memory_order_seq_cst);
+        size_t n = 0;
+        do {
+            n = available(head, max);
+            if (n == 0) {
+                consumer_busy_.store(false, std::memory_order_release);
+                return 0; // empty
+            }
+        } while (!head_.compare_exchange_weak(head, head + n, std::memory_order_seq_cst,
+                                              std::memory_order_seq_cst));
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = std::move(buffer_[(head + i) & mask_]);
+        }
+        // Also covers any slots the producer evicted while we were reading. A plain
+        // store is enough: while we are busy the producer only ever tries to move
+        // release_ to a claim index at or below this one, and its CAS cannot
+        // overwrite a newer value.
+        release_.store(head_.load(std::memory_order_acquire), std::memory_order_release);
+        consumer_busy_.store(false, std::memory_order_release);
+        return n;
+    }
+
+    /// Slots the producer may fill at `tail`, at most capacity() (producer only).
+    /// The shared release index (`head_` unless evictable) is reloaded only if the
+    /// cached one shows fewer than `wanted` free slots.
+    size_t free_slots(size_t tail, size_t wanted) {
+        // Pushes never pass the cached release index, so tail - cached_release_ <= limit.
+        const size_t limit = capacity_ - 1;
+        if (limit - (tail - cached_release_) >= wanted) {
+            return limit - (tail - cached_release_);
+        }
+        if (!evictable_) {
+            cached_release_ = head_.load(std::memory_order_acquire);
+        } else {
+            cached_release_ = release_.load(std::memory_order_acquire);
+            if (tail - cached_release_ >= limit) {
+                release_evicted();
+                cached_release_ = release_.load(std::memory_order_acquire);
+            }
+        }
+        return tail - cached_release_ < limit ? limit - (tail - cached_release_) : 0;
+    }
+
+    /// Slots evicted while the consumer was mid-read stay unreleased until its next
+    /// pop. If the consumer is idle, release them now so a drained queue can never
+    /// look full (producer only).
+    void release_evicted() {
+        // Load the claim index before checking for a reader: any claim it reflects
+        // has finished reading if the consumer is no longer busy.
+        const size_t head = head_.load(std::memory_order_seq_cst);
+        if (!consumer_busy_.load(std::memory_order_seq_cst)) {
+            advance_release(head);
+        }
+    }
+
+    void advance_release(size_t target) {
+        size_t current = release_.load(std::memory_order_relaxed);
+        while (current < target &&
+               !release_.compare_exchange_weak(current, target, std::memory_order_acq_rel,
+                                               std::memory_order_relaxed)) {
+        }
+    }
+
     size_t capacity_;
+    size_t mask_;
+    bool evictable_;
     std::vector<T> buffer_;
 
-    // Separate cache lines to avoid false sharing
+    // Separate cache lines to avoid false sharing; each side's cached copy of the
+    // other's index lives next to its own. release_ and consumer_busy_ are used
+    // only by evictable queues.
     alignas(64) std::atomic<size_t> head_{0};
+    size_t cached_tail_ = 0; // consumer only
+    alignas(64) std::atomic<size_t> release_{0};
+    std::atomic<bool> consumer_busy_{false};
     alignas(64) std::atomic<size_t> tail_{0};
+    size_t cached_release_ = 0; // producer only
+};
+
+/// What an OverflowQueue does with a push that does not fit in the ring.
+enum class OverflowPolicy {
+    DropNewest,     ///< Reject the incoming item; queued items are kept.
+    DropOldest,     ///< Evict the oldest queued item to make room.
+    CoalesceLatest, ///< Evict the whole backlog; only the newest item survives.
+    Spill,          ///< Park items on an unbounded side list; nothing is ever lost.
+};
+
+[[nodiscard]] inline const char *overflow_policy_name(OverflowPolicy policy) {
+    switch (policy) {
+    case OverflowPolicy::DropNewest:
+        return "drop-newest";
+    case OverflowPolicy::DropOldest:
+        return "drop-oldest";
+    case OverflowPolicy::CoalesceLatest:
+        return "coalesce";
+    case OverflowPolicy::Spill:
+        return "spill";
+    }
+    return "unknown";
+}
+
+/// Counters for an OverflowQueue. Plain snapshot, safe to copy anywhere.
+/// Traffic counters are in frames (see QueueItemWeight); depths are in queue slots.
+struct QueueStats {
+    uint64_t pushed = 0;  // frames accepted by the queue (ring or spill list)
+    uint64_t popped = 0;  // frames delivered to the consumer
+    uint64_t dropped = 0; // frames lost to the overflow policy
+    uint64_t spilled = 0; // frames routed through the spill list
+    size_t depth = 0;     // items currently queued, spill list included
+    size_t high_water = 0;
+    size_t capacity = 0; // ring slots
+    OverflowPolicy policy = OverflowPolicy::DropNewest;
 };
 
-/// Binary telemetry frame queue (network → render thread).
-using TelemetryQueue = SPSCQueue<std::vector<uint8_t>>;
+/// SPSC queue with an explicit overflow policy and drop accounting.
+///
+/// The fast path is a plain SPSCQueue push/pop. Only when the ring is full does
+/// the policy kick in: evictions happen lock-free on the producer, and the Spill
+/// policy takes a mutex solely while the side list is in use. Items evicted by
+/// the producer are handed to the discard handler so their storage can be recycled.
+///
+/// Eviction needs an evictable ring, whose pops cost more (see SPSCQueue). The
+/// ring is made evictable only if the queue is constructed with an evicting
+/// policy (DropOldest, CoalesceLatest); on any other queue, set_policy() to one
+/// of those behaves as DropNewest.
+///
+/// Producer thread: try_push(), set_discard_handler().
+/// Consumer thread: try_pop().
+/// set_policy(), stats() and size_approx() may be called from any thread.
+template <typename T> class OverflowQueue {
+  public:
+    explicit OverflowQueue(size_t capacity, OverflowPolicy policy = OverflowPolicy::DropNewest)
+        : ring_(capacity, evicts(policy)), policy_(policy) {}
+
+    OverflowQueue(const OverflowQueue &) = delete;
+    OverflowQueue &operator=(const OverflowQueue &) = delete;
+
+    void set_policy(OverflowPolicy policy) { policy_.store(policy, std::memory_order_relaxed); }
+    [[nodiscard]] OverflowPolicy policy() const { return policy_.load(std::memory_order_relaxed); }
 
-/// JSON event string queue (network → render thread).
-using EventQueue = SPSCQueue<std::string>;
+    /// True for the policies that evict queued items.
+    [[nodiscard]] static constexpr bool evicts(OverflowPolicy policy) {
+        return policy == OverflowPolicy::DropOldest || policy == OverflowPolicy::CoalesceLatest;
+    }
+
+    /// Receives items evicted by DropOldest/CoalesceLatest (called on the producer).
+    void set_discard_handler(std::function<void(T &&)> handler) { discard_ = std::move(handler); }
+
+    /// Push an item (producer only). Returns false if the item was rejected, in
+    /// which case it is counted as dropped and left untouched for the caller.
+    bool try_push(T &&item) {
+        const uint64_t weight = QueueItemWeight<T>::of(item);
+
+        // Once items are spilled, later ones must follow them to keep FIFO order.
+        if (spill_pending_.load(std::memory_order_acquire)) {
+            spill(std::move(item), weight);
+            return true;
+        }
+        if (push_ring(std::move(item), weight)) {
+            return true;
+        }
+
+        switch (policy()) {
+        case OverflowPolicy::DropNewest:
+            break;
+        case OverflowPolicy::DropOldest:
+            evict_oldest();
+            if (push_ring(std::move(item), weight)) {
+                return true;
+            }
+            break;
+        case OverflowPolicy::CoalesceLatest:
+            while (evict_oldest()) {
+            }
+            if (push_ring(std::move(item), weight)) {
+                return true;
+            }
+            break;
+        case OverflowPolicy::Spill:
+            spill(std::move(item), weight);
+            return true;
+        }
+        dropped_.fetch_add(weight, std::memory_order_relaxed);
+        return false;
+    }
+
+    /// Pop the oldest item (consumer only). Returns false if empty.
+    bool try_pop(T &item) {
+        if (drain_.empty()) {
+            // Read the flag before the ring: while spilling, the producer no longer
+            // writes to the ring, so an empty ring means the spill list is next.
+            const bool spilling = spill_pending_.load(std::memory_order_acquire);
+            if (ring_.try_pop(item)) {
+                popped_.fetch_add(QueueItemWeight<T>::of(item), std::memory_order_relaxed);
+                return true;
+            }
+            if (!spilling) {
+                return false;
+            }
+            std::lock_guard<std::mutex> lock(spill_mutex_);
+            drain_.swap(spill_);
+            spill_pending_.store(false, std::memory_order_release);
+        }
+        if (drain_.empty()) {
+            return false;
+        }
+        item = std::move(drain_.front());
+        drain_.pop_front();
+        spill_depth_.fetch_sub(1, std::memory_order_relaxed);
+        popped_.fetch_add(QueueItemWeight<T>::of(item), std::memory_order_relaxed);
+        return true;
+    }
+
+    /// Approximate number of queued items, spill list included.
+    [[nodiscard]] size_t size_approx() const {
+        return ring_.size_approx() + spill_depth_.load(std::memory_order_relaxed);
+    }
+
+    /// Ring capacity; the Spill policy may hold more than this.
+    [[nodiscard]] size_t capacity() const { return ring_.capacity(); }
+
+    [[nodiscard]] QueueStats stats() const {
+        QueueStats s;
+        s.pushed = pushed_.load(std::memory_order_relaxed);
+        s.popped = popped_.load(std::memory_order_relaxed);
+        s.dropped = dropped_.load(std::memory_order_relaxed);
+        s.spilled = spilled_.load(std::memory_order_relaxed);
+        s.depth = size_approx();
+        s.high_water = high_water_.load(std::memory_order_relaxed);
+        s.capacity = capacity();
+        s.policy = policy();
+        return s;
+    }
+
+  private:
+    bool push_ring(T &&item, uint64_t weight) {
+        if (!ring_.try_push(std::move(item))) {
+            return false;
+        }
+        pushed_.fetch_add(weight, std::memory_order_relaxed);
+        note_depth();
+        return true;
+    }
+
+    bool evict_oldest() {
+        T evicted;
+        if (!ring_.try_evict_oldest(evicted)) {
+            return false;
+        }
+        dropped_.fetch_add(QueueItemWeight<T>::of(evicted), std::memory_order_relaxed);
+        if (discard_) {
+            discard_(std::move(evicted));
+        }
+        return true;
+    }
+
+    void spill(T &&item, uint64_t weight) {
+        {
+            std::lock_guard<std::mutex> lock(spill_mutex_);
+            spill_.push_back(std::move(item));
+            spill_depth_.fetch_add(1, std::memory_order_relaxed);
+            spill_pending_.store(true, std::memory_order_release);
+        }
+        pushed_.fetch_add(weight, std::memory_order_relaxed);
+        spilled_.fetch_add(weight, std::memory_order_relaxed);
+        note_depth();
+    }
+
+    void note_depth() {
+        const size_t depth = size_approx();
+        if (depth > high_water_.load(std::memory_order_relaxed)) {
+            high_water_.store(depth, std::memory_order_relaxed); // producer is the only writer
+        }
+    }
+
+    SPSCQueue<T> ring_;
+    std::atomic<OverflowPolicy> policy_;
+    std::function<void(T &&)> discard_;
+
+    // Spill list: touched only after the ring has overflowed under Spill.
+    std::mutex spill_mutex_;
+    std::deque<T> spill_;
+    std::atomic<bool> spill_pending_{false};
+    std::atomic<size_t> spill_depth_{0};
+    std::deque<T> drain_; // consumer-private: spilled items taken in one swap
+
+    std::atomic<uint64_t> pushed_{0};
+    std::atomic<uint64_t> popped_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> spilled_{0};
+    std::atomic<size_t> high_water_{0};
+};
 
 } // namespace daedalus::data
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "daedalus/data/history_budget.hpp"
+#include "daedalus/data/ingest_thread.hpp"
+#include "daedalus/data/signal_store.hpp"
+#include "daedalus/launch_options.hpp"
+#include "daedalus/protocol/telemetry_source.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace daedalus {
+
+/// Throughput and health of a headless run, cumulative since start().
+struct HeadlessReport {
+    double seconds = 0.0;
+    uint64_t frames = 0;  ///< Rows ingested into the store.
+    uint64_t samples = 0; ///< Values ingested (rows times their width).
+    uint64_t latency_count = 0;
+    std::chrono::nanoseconds latency_p50{};
+    std::chrono::nanoseconds latency_p99{};
+    std::chrono::nanoseconds latency_max{};
+    uint64_t frames_dropped = 0;   ///< Lost to the telemetry queue's overflow policy.
+    uint64_t rows_discarded = 0;   ///< Ingested with no matching store.
+    uint64_t frames_rejected = 0;  ///< Malformed or undecodable frames.
+    uint64_t gaps = 0;             ///< Forward jumps in the frame counter (upstream loss).
+    uint64_t missing_frames = 0;   ///< Frames skipped by those gaps.
+};
+
+/// The data pipeline without any UI: a telemetry source, the ingest thread and a
+/// SignalStore, driven through the control protocol as the app drives it
+/// (subscribe to everything on a schema, size a store and resume on an ack, drop
+/// the store on disconnect). Does not own the source.
+class HeadlessSession {
+  public:
+    explicit HeadlessSession(protocol::TelemetrySource &source,
+                             data::HistoryBudget budget = data::HistoryBudget{});
+    ~HeadlessSession();
+
+    HeadlessSession(const HeadlessSession &) = delete;
+    HeadlessSession &operator=(const HeadlessSession &) = delete;
+
+    /// Start ingesting and connect the source.
+    void start();
+    /// Disconnect the source and stop ingesting. Counters are kept.
+    void stop();
+    /// Handle the control events queued since the last call.
+    void poll();
+
+    [[nodiscard]] HeadlessReport report() const;
+    /// Every frame the source delivered so far has been ingested or discarded.
+    [[nodiscard]] bool drained(uint64_t frames_delivered) const;
+    [[nodiscard]] const std::shared_ptr<data::SignalStore> &store() const { return store_; }
+
+  private:
+    protocol::TelemetrySource &source_;
+    data::HistoryBudget budget_;
+    data::IngestThread ingest_;
+    std::shared_ptr<data::SignalStore> store_;
+    std::chrono::steady_clock::time_point started_at_;
+};
+
+/// `daedalus --headless`: run a HeadlessSession on the live stream (optionally
+/// recording it) or a replay, printing throughput every report interval and a
+/// summary at the end. Runs until SIGINT/SIGTERM, the duration elapses or the
+/// replay has been ingested. Returns the process exit code.
+int run_headless(const LaunchOptions &options);
+
+} // namespace daedalus
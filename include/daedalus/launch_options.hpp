@@ -0,0 +1,49 @@
+#pragma once
+
+#include "daedalus/protocol/client.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace daedalus {
+
+/// How daedalus was asked to run: its command line, over defaults taken from the
+/// environment (DAEDALUS_HISTORY_MB, DAEDALUS_TELEMETRY_ENCODING).
+struct LaunchOptions {
+    bool headless = false; ///< Run the pipeline without any UI (see run_headless()).
+    bool help = false;
+    std::string url = "ws://127.0.0.1:8765";
+    protocol::TelemetryEncoding encoding = protocol::TelemetryEncoding::Plain;
+    size_t history_bytes = 0; ///< Signal history budget; 0 = HistoryBudget's default.
+
+    std::string replay_path;  ///< Play this recorded session instead of connecting.
+    double replay_speed = 1.0; ///< Multiple of the recorded rate; 0 = as fast as possible.
+
+    // Headless only.
+    std::string record_path;        ///< Record the live stream to this file.
+    double duration_s = 0.0;        ///< Stop after this long; 0 = when interrupted.
+    double report_interval_s = 1.0; ///< Seconds between progress lines.
+
+    /// Arguments not understood, and options or environment values that were
+    /// malformed or out of range (e.g. "--speed 0"); those keep their default.
+    std::vector<std::string> unknown;
+};
+
+/// Parse `argv` (see kUsage). Unknown arguments and bad values are collected,
+/// not fatal.
+[[nodiscard]] LaunchOptions parse_launch_options(int argc, const char *const argv[]);
+
+inline constexpr const char *kUsage =
+    "Usage: daedalus [options]\n"
+    "  --url URL            Hermes server (default ws://127.0.0.1:8765)\n"
+    "  --encoding xor|plain Telemetry encoding to ask for\n"
+    "  --replay FILE        Play a recorded session instead of connecting\n"
+    "  --speed N|max        Replay at N times the recorded rate, or unpaced\n"
+    "  --headless           No UI: ingest, print throughput and stream health\n"
+    "  --record FILE        (headless) Record the live stream to FILE\n"
+    "  --duration SECONDS   (headless) Stop after SECONDS\n"
+    "  --interval SECONDS   (headless) Seconds between progress lines (default 1)\n"
+    "  --help               Show this help\n";
+
+} // namespace daedalus
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "daedalus/loadgen/synthetic_load.hpp"
+
+#include <ixwebsocket/IXWebSocketServer.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace daedalus::loadgen {
+
+/// A local WebSocket server that speaks the Hermes protocol (schema on connect,
+/// "subscribe" → ack, "pause"/"resume", binary "HERT" frames) with a synthetic
+/// load, so the client, queues, store and plots can be driven far beyond a real
+/// simulation's size from a test, a benchmark or the `synthetic_hermes` tool.
+///
+/// Every client gets its own SyntheticLoad (frame counter and subscription);
+/// one thread paces frames for all streaming clients at the profile's rate and
+/// burst pattern. Like Hermes, nothing streams until a client resumes. If a
+/// client's socket falls more than kMaxBufferedBytes behind, the server waits
+/// for it instead of queueing without bound.
+///
+/// The scripting calls (set_rate(), burst(), skip()) and the counters may be
+/// used from any thread while the server runs.
+class SyntheticHermes {
+  public:
+    /// Poll interval while no client is streaming or a socket is backed up.
+    static constexpr std::chrono::microseconds kIdleWait{500};
+    static constexpr size_t kMaxBufferedBytes = size_t{8} << 20;
+    /// Free ports tried when started with port 0, in case one is taken first.
+    static constexpr int kPortAttempts = 8;
+
+    /// `port` 0 picks a free port when started (see port()).
+    explicit SyntheticHermes(const LoadProfile &profile, int port = 0,
+                             std::string host = "127.0.0.1");
+    ~SyntheticHermes();
+
+    SyntheticHermes(const SyntheticHermes &) = delete;
+    SyntheticHermes &operator=(const SyntheticHermes &) = delete;
+
+    /// Listen and start the stream thread. Returns false (and logs) if the
+    /// port cannot be bound (with port 0: if kPortAttempts free ports all fail).
+    bool start();
+    /// Close every connection and stop listening.
+    void stop();
+    [[nodiscard]] bool running() const { return thread_.joinable(); }
+
+    [[nodiscard]] int port() const { return port_; }
+    /// "ws://host:port", for HermesClient.
+    [[nodiscard]] std::string url() const;
+
+    /// Change the frame rate from now on; 0 = unpaced.
+    void set_rate(double hz) { rate_hz_.store(hz, std::memory_order_relaxed); }
+    /// Send the next `frames` frames back to back, now, then resume pacing.
+    void burst(uint64_t frames) { burst_pending_.fetch_add(frames, std::memory_order_relaxed); }
+    /// Skip `frames` frame numbers on every client's stream: a one-off gap.
+    void skip(uint64_t frames) { skip_pending_.fetch_add(frames, std::memory_order_relaxed); }
+
+    [[nodiscard]] size_t clients() const;
+    /// Frames sent, summed over clients.
+    [[nodiscard]] uint64_t frames_sent() const {
+        return frames_sent_.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] uint64_t bytes_sent() const {
+        return bytes_sent_.load(std::memory_order_relaxed);
+    }
+    /// Block until frames_sent() reaches `frames`; false on timeout.
+    bool wait_for_frames(uint64_t frames, std::chrono::milliseconds timeout) const;
+
+  private:
+    struct Client {
+        SyntheticLoad load;
+        bool streaming = false;
+    };
+
+    enum class Tick { Sent, Idle, Backpressured };
+
+    void on_message(ix::WebSocket &socket, const ix::WebSocketMessagePtr &msg);
+    void run(const std::stop_token &stop);
+    /// Send one frame to every streaming client.
+    Tick tick();
+
+    LoadProfile profile_;
+    int port_;
+    std::string host_;
+    std::unique_ptr<ix::WebSocketServer> server_;
+    std::jthread thread_;
+
+    mutable std::mutex clients_mutex_;
+    std::map<ix::WebSocket *, Client> clients_;
+    std::vector<uint8_t> frame_;
+    std::string wire_;
+
+    std::atomic<double> rate_hz_;
+    std::atomic<uint64_t> burst_pending_{0};
+    std::atomic<uint64_t> skip_pending_{0};
+    std::atomic<uint64_t> frames_sent_{0};
+    std::atomic<uint64_t> bytes_sent_{0};
+};
+
+} // namespace daedalus::loadgen
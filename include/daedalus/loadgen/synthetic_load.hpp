@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace daedalus::loadgen {
+
+/// Shape of a synthetic Hermes stream.
+struct LoadProfile {
+    size_t modules = 4;
+    size_t signals_per_module = 25;
+    /// Frames per second of wall time; 0 sends as fast as the socket takes them.
+    /// Simulation time always advances 1 / sim_rate_hz per frame number.
+    double rate_hz = 1000.0;
+    double sim_rate_hz = 1000.0;
+    /// Frames released back to back at a time (1 = evenly paced). The average
+    /// rate stays rate_hz; only the arrival pattern gets peakier.
+    uint32_t burst_frames = 1;
+    /// Every gap_every frame numbers, skip gap_frames of them, as if lost
+    /// upstream (0 = no gaps).
+    uint32_t gap_every = 0;
+    uint32_t gap_frames = 1;
+    /// Stop after this many frames have been sent; 0 = never.
+    uint64_t max_frames = 0;
+};
+
+/// The content of a synthetic Hermes stream: a schema of modules × signals, the
+/// ack for a subscription, and "HERT" frames of the subscribed signals with the
+/// profile's deliberate gaps in the frame counter. Pacing and transport are the
+/// caller's (see SyntheticHermes). Not thread-safe.
+///
+/// Signal `s` (schema order, 0-based over all modules) of frame `n` carries
+/// value(s, n), so a consumer can check every sample it receives.
+class SyntheticLoad {
+  public:
+    explicit SyntheticLoad(const LoadProfile &profile);
+
+    [[nodiscard]] const LoadProfile &profile() const { return profile_; }
+    [[nodiscard]] size_t signal_count() const { return paths_.size(); }
+    /// "module.signal" of every signal, in schema order.
+    [[nodiscard]] const std::vector<std::string> &signal_paths() const { return paths_; }
+
+    [[nodiscard]] std::string schema_json() const;
+
+    /// Subscribe to the signals matching `patterns` ("*", "module.*" or a full
+    /// path) and return the ack. Later frames carry only those signals.
+    std::string subscribe(const std::vector<std::string> &patterns);
+    /// Schema indices of the subscribed signals, in frame order.
+    [[nodiscard]] const std::vector<uint32_t> &selection() const { return selection_; }
+
+    /// Write the next frame into `out`, skipping frame numbers where the profile
+    /// has a gap. The frame counter carries on from skip() and earlier frames.
+    void next_frame(std::vector<uint8_t> &out);
+    /// Skip `count` frame numbers now: a one-off gap.
+    void skip(uint64_t count) { skip_pending_ += count; }
+
+    /// Frame number of the next frame (before any gap).
+    [[nodiscard]] uint64_t next_frame_number() const { return frame_; }
+    [[nodiscard]] uint64_t frames_generated() const { return generated_; }
+    /// Frame numbers skipped, by the profile or skip().
+    [[nodiscard]] uint64_t frames_skipped() const { return skipped_; }
+
+    [[nodiscard]] static double value(size_t signal, uint64_t frame) {
+        return static_cast<double>(signal) + static_cast<double>((frame + signal) % 1000) * 1e-3;
+    }
+
+  private:
+    LoadProfile profile_;
+    std::vector<std::string> paths_;
+    std::vector<uint32_t> selection_;
+    uint64_t frame_ = 0;
+    uint64_t generated_ = 0;
+    uint64_t skipped_ = 0;
+    uint64_t skip_pending_ = 0;
+    uint64_t until_gap_ = 0;
+};
+
+} // namespace daedalus::loadgen
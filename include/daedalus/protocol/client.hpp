@@ -1,7 +1,9 @@
 #pragma once
 
-#include "daedalus/data/telemetry_queue.hpp"
+#include "daedalus/protocol/events.hpp"
 #include "daedalus/protocol/telemetry.hpp"
+#include "daedalus/protocol/telemetry_source.hpp"
+#include "daedalus/record/session_recorder.hpp"
 
 #include <ixwebsocket/IXWebSocket.h>
 #include <nlohmann/json.hpp>
@@ -14,31 +16,39 @@
 
 namespace daedalus::protocol {
 
-enum class ConnectionState { Disconnected, Connecting, Connected, Error };
+/// Telemetry frame encodings the client can ask the server for.
+enum class TelemetryEncoding {
+    Plain, ///< "HERT": every value, every frame.
+    Xor,   ///< "HERX": changed values only, XOR-compressed (see XorFrameDecoder).
+};
 
 /// WebSocket client for the Hermes protocol.
-/// Runs IXWebSocket on a background thread and pushes data to lock-free queues.
-/// The render thread polls the queues each frame.
-class HermesClient {
+/// Runs IXWebSocket on a background thread and pushes data to lock-free queues:
+/// telemetry as decoded batches, control messages as parsed ControlEvents. The
+/// render thread polls the queues each frame.
+class HermesClient : public TelemetrySource {
   public:
     explicit HermesClient(const std::string &url = "ws://127.0.0.1:8765");
-    ~HermesClient();
-
-    HermesClient(const HermesClient &) = delete;
-    HermesClient &operator=(const HermesClient &) = delete;
+    ~HermesClient() override;
 
     /// Start the WebSocket connection (non-blocking).
-    void connect();
+    void connect() override;
 
     /// Close the connection.
-    void disconnect();
+    void disconnect() override;
 
-    /// Send a subscribe command.
-    void subscribe(const std::vector<std::string> &patterns);
+    /// Send a subscribe command. Asks for typed payloads and the preferred
+    /// telemetry encoding too.
+    void subscribe(const std::vector<std::string> &patterns) override;
+
+    /// Encoding requested by the next subscribe. A server that does not know it
+    /// keeps sending plain frames; both kinds are always decoded.
+    void set_telemetry_encoding(TelemetryEncoding encoding) { encoding_ = encoding; }
+    [[nodiscard]] TelemetryEncoding telemetry_encoding() const { return encoding_; }
 
     /// Convenience control commands.
-    void pause();
-    void resume();
+    void pause() override;
+    void resume() override;
     void reset();
     void step(int count);
     void set_signal(const std::string &signal, double value);
@@ -46,12 +56,18 @@ class HermesClient {
     /// Send a generic command.
     void send_command(const std::string &action, const nlohmann::json &params = {});
 
-    /// Access the data queues (polled by render thread).
-    data::TelemetryQueue &telemetry_queue() { return telemetry_queue_; }
-    data::EventQueue &event_queue() { return event_queue_; }
+    /// Record the raw stream to `recorder` (already started), or stop recording
+    /// with nullptr (any thread). A recording that starts mid-session begins with
+    /// the current schema and subscribe ack. The caller still stop()s the old
+    /// recorder; the network thread keeps a reference until its next message.
+    void set_recorder(std::shared_ptr<record::SessionRecorder> recorder) {
+        recorder_.store(std::move(recorder), std::memory_order_release);
+    }
 
     /// Current connection state (atomic, safe from any thread).
-    [[nodiscard]] ConnectionState state() const { return state_.load(std::memory_order_relaxed); }
+    [[nodiscard]] ConnectionState state() const override {
+        return state_.load(std::memory_order_relaxed);
+    }
 
     /// Format a command as JSON (for testing).
     static nlohmann::json format_command(const std::string &action,
@@ -59,12 +75,24 @@ class HermesClient {
 
   private:
     void on_message(const ix::WebSocketMessagePtr &msg);
+    /// The recorder to write to, if any (network thread).
+    std::shared_ptr<record::SessionRecorder> current_recorder();
+    /// Record a schema or ack that was just saved as the current layout.
+    void record_layout(const std::string &text);
+    /// Make `recorder` the active one; returns true if it is new and was given
+    /// the saved layout.
+    bool adopt_recorder(const std::shared_ptr<record::SessionRecorder> &recorder);
 
     std::string url_;
     ix::WebSocket ws_;
     std::atomic<ConnectionState> state_{ConnectionState::Disconnected};
-    data::TelemetryQueue telemetry_queue_{512};
-    data::EventQueue event_queue_{128};
+    TelemetryEncoding encoding_ = TelemetryEncoding::Plain;
+
+    std::atomic<std::shared_ptr<record::SessionRecorder>> recorder_;
+    // Network thread only: the layout messages a new recording has to start with.
+    std::shared_ptr<record::SessionRecorder> active_recorder_;
+    std::string schema_text_;
+    std::string ack_text_;
 };
 
 } // namespace daedalus::protocol
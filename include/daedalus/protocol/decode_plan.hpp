@@ -0,0 +1,95 @@
+#pragma once
+
+#include "daedalus/protocol/schema.hpp"
+#include "daedalus/protocol/telemetry.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace daedalus::protocol {
+
+/// Wire type of one telemetry value, from SignalInfo::type.
+/// Values are little-endian at their natural width; bool is one byte (non-zero
+/// is true) and enum a 4-byte signed ordinal.
+enum class ValueType : uint8_t { F64, F32, I32, U32, I64, Bool, Enum };
+
+/// Map a schema type name ("f64", "f32", "i32", "u32", "i64", "bool", "enum").
+[[nodiscard]] std::optional<ValueType> parse_value_type(std::string_view name);
+
+/// Bytes one value of `type` occupies in a telemetry payload.
+[[nodiscard]] size_t value_size(ValueType type);
+
+/// True for the integer-valued types (integers, bool and enum).
+[[nodiscard]] inline bool is_integral(ValueType type) {
+    return type != ValueType::F64 && type != ValueType::F32;
+}
+
+/// Declared type of every schema signal that is not f64, by full path. Signals
+/// with an unknown type name are left out and decode as f64.
+using DeclaredTypes = std::unordered_map<std::string, ValueType>;
+[[nodiscard]] DeclaredTypes declared_types(const Schema &schema);
+
+/// Payload layout of one subscription, compiled from the schema types.
+///
+/// Values sit back to back in subscription order, each at its own width. The
+/// plan groups neighbouring signals of the same type into runs with a precomputed
+/// byte offset, so decoding is one tight loop per run rather than a type switch
+/// per value. Every value is widened to f64 for the FrameBatch.
+class DecodePlan {
+  public:
+    /// No subscription: frames decode as plain f64 payloads.
+    DecodePlan() = default;
+    explicit DecodePlan(std::vector<ValueType> types);
+    /// Plan for an ack's signal list; signals not in `declared` are f64.
+    DecodePlan(const DeclaredTypes &declared, const std::vector<std::string> &signals);
+
+    [[nodiscard]] size_t signal_count() const { return types_.size(); }
+    [[nodiscard]] size_t payload_bytes() const { return payload_bytes_; }
+    [[nodiscard]] ValueType type(size_t signal) const { return types_[signal]; }
+    [[nodiscard]] const std::vector<ValueType> &types() const { return types_; }
+    /// True if every signal is f64, i.e. the plan changes nothing. An all-i64
+    /// plan has the same payload size but not the same values.
+    [[nodiscard]] bool all_f64() const {
+        return std::ranges::all_of(types_, [](ValueType t) { return t == ValueType::F64; });
+    }
+
+    /// Widen a payload of payload_bytes() into signal_count() doubles.
+    void decode(const uint8_t *payload, double *out) const;
+
+  private:
+    struct Run {
+        ValueType type;
+        size_t first;  ///< First signal of the run.
+        size_t count;  ///< Signals in the run.
+        size_t offset; ///< Payload byte offset of the first value.
+    };
+
+    std::vector<ValueType> types_;
+    std::vector<Run> runs_;
+    size_t payload_bytes_ = 0;
+};
+
+/// Plan for the subscription `ack` describes: the declared widths when the ack
+/// confirms typed payloads, otherwise the all-f64 default. A payload's length
+/// cannot tell an i64 from an f64, so only the negotiation may pick the layout.
+[[nodiscard]] DecodePlan negotiated_plan(const DeclaredTypes &declared, const SubscribeAck &ack);
+
+/// Decode a binary telemetry frame laid out by `plan`.
+///
+/// The plan applies when the frame carries plan.signal_count() values in exactly
+/// plan.payload_bytes(), even when that is also the f64 payload size (an
+/// all-i64 frame cannot be told apart by length, so the plan wins; build it
+/// with negotiated_plan()). Any other frame is read as the plain f64 layout, so
+/// a frame from before the subscription changed still decodes. Returns false if
+/// the frame is invalid either way.
+bool decode_frame(const uint8_t *data, size_t len, const DecodePlan &plan, TelemetryHeader &hdr,
+                  std::span<const double> &values, std::vector<double> &value_storage);
+
+} // namespace daedalus::protocol
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "daedalus/data/telemetry_queue.hpp"
+#include "daedalus/protocol/schema.hpp"
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+
+namespace daedalus::protocol {
+
+enum class ConnectionState { Disconnected, Connecting, Connected, Error };
+
+/// The WebSocket connected, closed or failed. `reason` is set for Error.
+struct StateChange {
+    ConnectionState state;
+    std::string reason;
+};
+
+/// A simulation event announced by the server: {"type": "event", "event": "..."}.
+struct SimEvent {
+    std::string name;
+};
+
+/// An error reported by the server: {"type": "error", "message": "..."}.
+struct ServerError {
+    std::string message;
+};
+
+/// A text frame that could not be parsed; `reason` says why.
+struct ParseFailure {
+    std::string reason;
+};
+
+/// A control message, parsed on the network thread and handed to the render
+/// thread through the EventQueue.
+using ControlEvent =
+    std::variant<Schema, SubscribeAck, StateChange, SimEvent, ServerError, ParseFailure>;
+
+/// Parse one JSON text frame. Returns std::nullopt for messages the client does
+/// not act on (unknown types, acks other than subscribe); malformed messages come
+/// back as ParseFailure rather than throwing.
+std::optional<ControlEvent> parse_control_event(std::string_view text);
+
+/// Parsed control event queue (network → render thread).
+using EventQueue = data::OverflowQueue<ControlEvent>;
+
+} // namespace daedalus::protocol
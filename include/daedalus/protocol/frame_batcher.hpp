@@ -0,0 +1,107 @@
+#pragma once
+
+#include "daedalus/data/buffer_pool.hpp"
+#include "daedalus/data/frame_batch.hpp"
+#include "daedalus/data/telemetry_queue.hpp"
+#include "daedalus/protocol/decode_plan.hpp"
+#include "daedalus/protocol/stream_health.hpp"
+#include "daedalus/protocol/xor_frame.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace daedalus::protocol {
+
+/// Decodes binary telemetry on the network thread and groups frames into
+/// columnar FrameBatch blocks for the render thread.
+///
+/// Batching adapts to the consumer: while the render thread keeps up, every frame
+/// is published immediately; when it falls behind, frames accumulate in the open
+/// batch until it fills, ages out, or the consumer drains the queue again.
+/// Those checks run on every frame and on publish_stale(), which the pipeline
+/// calls periodically so a stream that pauses does not strand its last rows.
+/// A batch the queue rejects is dropped; the queue's stats() account for it.
+/// Thread safety: network thread only, except publish_stale() (any thread);
+/// counters may be read from any thread.
+class FrameBatcher {
+  public:
+    /// Upper bound on rows per batch regardless of signal count.
+    static constexpr size_t kMaxRows = 256;
+    /// Target size of one batch's value columns.
+    static constexpr size_t kTargetBatchBytes = 256 * 1024;
+    /// Oldest a row may get before the open batch is published anyway, provided
+    /// another frame arrives or publish_stale() runs.
+    static constexpr std::chrono::milliseconds kMaxBatchAge{5};
+
+    FrameBatcher(data::TelemetryQueue &queue, data::BatchPool &pool);
+
+    /// Decode and validate one binary message, plain ("HERT") or compressed
+    /// ("HERX"), and add it to the open batch. Returns false if the frame was
+    /// rejected (bad magic, truncated payload, compressed stream out of sync).
+    bool ingest(const uint8_t *data, size_t len);
+
+    /// Publish the open batch now, e.g. before a control message or on close.
+    void flush();
+
+    /// Publish the open batch if the consumer has drained the queue or the batch
+    /// is older than kMaxBatchAge. Safe from any thread; does nothing while a
+    /// frame is being ingested, since ingest() makes the same check.
+    void publish_stale();
+
+    /// Payload layout of the current subscription (see DecodePlan). Frames that
+    /// do not match it are still read as plain f64.
+    void set_decode_plan(DecodePlan plan) { plan_ = std::move(plan); }
+    [[nodiscard]] const DecodePlan &decode_plan() const { return plan_; }
+
+    /// Start a new stream (e.g. a new connection): compressed frames must begin
+    /// with a keyframe again.
+    void reset_stream() { xor_decoder_.reset(); }
+
+    /// Rows per batch for a given subscription width.
+    [[nodiscard]] static size_t rows_for(size_t signal_count);
+
+    [[nodiscard]] uint64_t frames_decoded() const {
+        return frames_decoded_.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] uint64_t frames_rejected() const {
+        return frames_rejected_.load(std::memory_order_relaxed);
+    }
+    /// Decoded frames that arrived compressed.
+    [[nodiscard]] uint64_t frames_compressed() const {
+        return frames_compressed_.load(std::memory_order_relaxed);
+    }
+
+    /// Sequence and rate tracking for every decoded frame.
+    [[nodiscard]] StreamHealth &health() { return health_; }
+    [[nodiscard]] const StreamHealth &health() const { return health_; }
+
+  private:
+    void open_batch(size_t signal_count);
+    /// True if the open batch should go out now (batch_mutex_ held).
+    [[nodiscard]] bool due(std::chrono::steady_clock::time_point now) const;
+    void publish();
+
+    data::TelemetryQueue &queue_;
+    data::BatchPool &pool_;
+    /// Guards the open batch and the producer side of queue_ and pool_, so
+    /// publish_stale() may run off the network thread. Uncontended per frame.
+    std::mutex batch_mutex_;
+    data::FrameBatch open_;
+    bool has_open_ = false;
+    std::chrono::steady_clock::time_point opened_at_{};
+    DecodePlan plan_;
+    XorFrameDecoder xor_decoder_;
+    std::vector<double> value_storage_;
+    StreamHealth health_;
+
+    std::atomic<uint64_t> frames_decoded_{0};
+    std::atomic<uint64_t> frames_rejected_{0};
+    std::atomic<uint64_t> frames_compressed_{0};
+};
+
+} // namespace daedalus::protocol
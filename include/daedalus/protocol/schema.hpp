@@ -4,6 +4,7 @@
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace daedalus::protocol {
@@ -26,6 +27,9 @@ struct Schema {
 struct SubscribeAck {
     uint32_t count;
     std::vector<std::string> signals;
+    /// The server echoed "payload": "typed": values are packed at their declared
+    /// widths. Without it every value is an f64, whatever the schema declares.
+    bool typed_payload = false;
 };
 
 /// Parse a schema JSON message into a Schema struct.
@@ -34,7 +38,32 @@ Schema parse_schema(const nlohmann::json &msg);
 
 /// Parse a subscribe acknowledgment message.
 /// Expects: {"type": "ack", "action": "subscribe", "count": N, "signals": [...]}
-/// The signal order in the ack defines binary telemetry payload layout.
+/// and optionally "payload": "typed". The signal order in the ack defines binary
+/// telemetry payload layout.
 SubscribeAck parse_subscribe_ack(const nlohmann::json &msg);
 
+/// The top-level "type" and "action" members of a message ("" when absent).
+struct MessageKind {
+    std::string type;
+    std::string action;
+};
+
+// Streaming parsers. These read the message text with nlohmann's SAX interface
+// and build the result directly, without a JSON DOM, so a schema or ack for tens
+// of thousands of signals costs one pass and one string per field. They accept
+// and reject the same messages as the DOM versions (modules come out in document
+// order rather than sorted). They keep no state and may run on any thread.
+
+/// Read the message kind. Stops at the type unless it is "ack", else at the
+/// action, so a schema's body is never read; `action` is filled only for acks
+/// or when it precedes the type.
+MessageKind peek_message_kind(std::string_view text);
+
+/// Parse schema message text; throws std::runtime_error like parse_schema().
+Schema parse_schema_text(std::string_view text);
+
+/// Parse subscribe-ack message text; throws std::runtime_error like
+/// parse_subscribe_ack().
+SubscribeAck parse_subscribe_ack_text(std::string_view text);
+
 } // namespace daedalus::protocol
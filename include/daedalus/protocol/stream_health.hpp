@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace daedalus::protocol {
+
+/// Snapshot of stream health counters. Plain struct, safe to copy anywhere.
+struct StreamHealthStats {
+    uint64_t frames = 0;         // frames observed (including duplicates and late ones)
+    uint64_t gaps = 0;           // forward jumps in the frame counter
+    uint64_t missing_frames = 0; // frame numbers skipped by gaps and not seen since
+    uint64_t duplicates = 0;     // frame number already received
+    uint64_t reordered = 0;      // first arrival of a frame after a newer one
+    uint64_t restarts = 0;       // large backward jumps (simulation reset)
+    uint64_t last_frame = 0;
+    double last_sim_time = 0.0;
+
+    double receive_rate_hz = 0.0; // frames received per wall-clock second
+    double sim_rate_hz = 0.0;     // frame counter advance per simulated second
+    double real_time_factor = 0.0;
+    double seconds_since_last_frame = 0.0; // wall time since the last frame; 0 before any
+};
+
+/// Watches the telemetry frame counter and timestamps for signs of trouble:
+/// gaps (frames lost upstream), duplicates, reordering and simulation restarts,
+/// plus smoothed receive rate, simulation rate and real-time factor.
+///
+/// Fed from the decode path on the network thread; stats() may be called from any
+/// thread. Each counter is individually atomic, so a snapshot is cheap but not a
+/// single consistent cut.
+class StreamHealth {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /// A backward jump this large or larger is a restart rather than a late
+    /// frame. Arrivals are tracked per frame within the window.
+    static constexpr uint64_t kReorderWindow = 64;
+    /// Wall-clock interval over which rates are measured before smoothing.
+    static constexpr std::chrono::milliseconds kRateWindow{250};
+    /// Weight of the newest window in the smoothed rates.
+    static constexpr double kRateSmoothing = 0.3;
+
+    /// Record one decoded frame header (network thread only).
+    void observe(uint64_t frame, double sim_time, Clock::time_point now);
+
+    /// Forget the sequence baseline, e.g. after a reconnect (network thread only).
+    /// Counters are kept; rates restart from zero.
+    void reset_baseline();
+
+    [[nodiscard]] StreamHealthStats stats() const { return stats(Clock::now()); }
+    [[nodiscard]] StreamHealthStats stats(Clock::time_point now) const;
+
+  private:
+    void update_rates(uint64_t frame, double sim_time, Clock::time_point now);
+    /// Slide the window forward to `frame` (network thread only).
+    void advance(uint64_t frame);
+
+    // Network-thread state
+    bool has_baseline_ = false;
+    uint64_t highest_frame_ = 0;
+    // Bit i stands for frame highest_frame_ - i: received, or skipped by a gap
+    // and counted in missing_frames_.
+    uint64_t received_ = 0;
+    uint64_t holes_ = 0;
+    bool has_window_ = false;
+    Clock::time_point window_start_{};
+    uint64_t window_frame_ = 0;
+    double window_sim_time_ = 0.0;
+    uint64_t window_received_ = 0;
+    bool rates_valid_ = false;
+
+    // Published counters
+    std::atomic<uint64_t> frames_{0};
+    std::atomic<uint64_t> gaps_{0};
+    std::atomic<uint64_t> missing_frames_{0};
+    std::atomic<uint64_t> duplicates_{0};
+    std::atomic<uint64_t> reordered_{0};
+    std::atomic<uint64_t> restarts_{0};
+    std::atomic<uint64_t> last_frame_{0};
+    std::atomic<double> last_sim_time_{0.0};
+    std::atomic<double> receive_rate_hz_{0.0};
+    std::atomic<double> sim_rate_hz_{0.0};
+    std::atomic<double> real_time_factor_{0.0};
+    std::atomic<int64_t> last_seen_ns_{0}; // steady_clock ticks of the latest frame
+};
+
+} // namespace daedalus::protocol
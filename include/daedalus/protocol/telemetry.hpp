@@ -25,6 +25,10 @@ static_assert(sizeof(TelemetryHeader) == 24);
 /// 0x54 0x52 0x45 0x48 ("T", "R", "E", "H").
 inline constexpr uint32_t kTelemetryMagic = 0x48455254;
 
+/// ASCII "HERX": the XOR-compressed variant of a telemetry frame (see
+/// XorFrameDecoder). Same header, different payload.
+inline constexpr uint32_t kCompressedTelemetryMagic = 0x48455258;
+
 /// Decode a binary telemetry frame.
 /// Returns true if the frame is valid (correct magic, sufficient length).
 /// On success, populates hdr and values.
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "daedalus/data/buffer_pool.hpp"
+#include "daedalus/data/telemetry_queue.hpp"
+#include "daedalus/protocol/decode_plan.hpp"
+#include "daedalus/protocol/events.hpp"
+#include "daedalus/protocol/frame_batcher.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace daedalus::protocol {
+
+/// Where the pipeline's telemetry and control events come from: a live Hermes
+/// connection (HermesClient) or a recorded session (record::SessionReplay).
+///
+/// A source produces on its own thread into two queues: telemetry as decoded
+/// batches, control messages as parsed ControlEvents. The render thread drives
+/// it with the Hermes commands below and polls event_queue() each frame; the
+/// ingest thread drains telemetry_queue().
+///
+/// The pipeline itself lives here so every source feeds it the same way: a
+/// source hands each frame to deliver_frame() and each control event to
+/// deliver_event(), which also keeps the decode layout in step with the schema
+/// and subscribe acks.
+class TelemetrySource {
+  public:
+    virtual ~TelemetrySource() = default;
+
+    TelemetrySource(const TelemetrySource &) = delete;
+    TelemetrySource &operator=(const TelemetrySource &) = delete;
+
+    /// Start producing (non-blocking).
+    virtual void connect() = 0;
+    /// Stop producing.
+    virtual void disconnect() = 0;
+    /// Ask for the signals matching `patterns`; answered by a SubscribeAck event.
+    virtual void subscribe(const std::vector<std::string> &patterns) = 0;
+    /// Hold / continue the telemetry stream.
+    virtual void pause() = 0;
+    virtual void resume() = 0;
+
+    /// Current connection state (atomic, safe from any thread).
+    [[nodiscard]] virtual ConnectionState state() const = 0;
+
+    /// Access the data queues (polled by render thread).
+    data::TelemetryQueue &telemetry_queue() { return telemetry_queue_; }
+    EventQueue &event_queue() { return event_queue_; }
+
+    /// Overflow behaviour when the render thread falls behind (safe from any thread).
+    /// Defaults: telemetry drops the oldest batches, control events spill so
+    /// acks and schemas are never lost. The event queue is built without
+    /// eviction, so DropOldest and CoalesceLatest act as DropNewest there.
+    void set_telemetry_overflow_policy(data::OverflowPolicy policy) {
+        telemetry_queue_.set_policy(policy);
+    }
+    void set_event_overflow_policy(data::OverflowPolicy policy) { event_queue_.set_policy(policy); }
+
+    /// Recycled batch storage. The consumer must release() every batch it pops
+    /// from telemetry_queue() so the producer can reuse it.
+    data::BatchPool &batch_pool() { return batch_pool_; }
+
+    /// Publish telemetry still waiting in the open batch once the consumer has
+    /// caught up or it has aged out (safe from any thread). Call it periodically,
+    /// e.g. from the ingest thread while idle: a stream that pauses sends no
+    /// further frame to do it.
+    void publish_stale() { batcher_.publish_stale(); }
+
+    /// Producer-thread decoder statistics.
+    [[nodiscard]] const FrameBatcher &batcher() const { return batcher_; }
+
+    /// Frame-sequence gaps, duplicates, reordering and rate estimates.
+    [[nodiscard]] StreamHealthStats stream_health() const { return batcher_.health().stats(); }
+
+  protected:
+    TelemetrySource();
+
+    // Producer thread only.
+
+    /// Decode a binary telemetry frame into the open batch.
+    bool deliver_frame(const uint8_t *data, size_t len) { return batcher_.ingest(data, len); }
+    /// Publish pending telemetry (keeping order), apply the layout a schema or
+    /// ack defines, and queue the event.
+    void deliver_event(ControlEvent &&event);
+    /// Publish pending telemetry.
+    void flush() { batcher_.flush(); }
+    /// A new stream starts: forget the layout, the decoder state and the frame
+    /// counter baseline (a new session may restart it; don't report a gap).
+    void begin_stream();
+
+  private:
+    /// Each slot holds a whole FrameBatch, so the queue buffers
+    /// kTelemetryQueueDepth × FrameBatcher::rows_for(signals) frames.
+    static constexpr size_t kTelemetryQueueDepth = 64;
+    /// Queue depth plus headroom for batches held by either thread.
+    static constexpr size_t kBatchPoolSize = kTelemetryQueueDepth + 8;
+    static constexpr size_t kBatchPoolPrewarm = 8;
+    static constexpr size_t kEventQueueDepth = 128;
+
+    data::TelemetryQueue telemetry_queue_{kTelemetryQueueDepth, data::OverflowPolicy::DropOldest};
+    EventQueue event_queue_{kEventQueueDepth, data::OverflowPolicy::Spill};
+    data::BatchPool batch_pool_{kBatchPoolSize, kBatchPoolPrewarm,
+                                [] { return data::FrameBatch{}; }};
+    FrameBatcher batcher_{telemetry_queue_, batch_pool_};
+    /// Non-f64 types from the last schema, for the next subscribe ack's decode
+    /// plan (producer thread only).
+    DeclaredTypes declared_types_;
+};
+
+} // namespace daedalus::protocol
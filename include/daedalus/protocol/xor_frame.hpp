@@ -0,0 +1,54 @@
+#pragma once
+
+#include "daedalus/protocol/telemetry.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace daedalus::protocol {
+
+/// Compressed telemetry frames ("HERX").
+///
+/// Layout after the 24-byte TelemetryHeader (magic kCompressedTelemetryMagic):
+///   flags   u8    bit 0: keyframe
+///   bitmap  ceil(count / 8) bytes, bit i (LSB first) set if signal i changed
+///   stream  one record per changed signal, bits MSB first, padded to a byte
+///
+/// Each value is the f64 bit pattern XORed with the same signal's previous value
+/// (with zero in a keyframe). A record is Gorilla-style:
+///   '0'                         the XOR fits the signal's last window:
+///                               read that many meaningful bits
+///   '1' lead(6) length-1(6)     a new window of `length` bits after `lead`
+///                               leading zeros, then the bits
+/// A keyframe forgets every previous value and window, so decoding can start or
+/// resynchronise there. Signals that do not change cost one bitmap bit.
+///
+/// Frames depend on the ones before, so the stream must be decoded in order. A
+/// malformed frame puts the decoder out of sync until the next keyframe.
+class XorFrameDecoder {
+  public:
+    static constexpr uint8_t kKeyframeFlag = 0x01;
+
+    /// Decode one compressed frame. On success `values` holds `hdr.count`
+    /// doubles, valid until the next call. Returns false for a malformed frame
+    /// or a delta frame the decoder has no matching keyframe for.
+    bool decode(const uint8_t *data, size_t len, TelemetryHeader &hdr,
+                std::span<const double> &values);
+
+    /// Forget all state; the next frame must be a keyframe.
+    void reset();
+
+    [[nodiscard]] bool synced() const { return synced_; }
+
+  private:
+    bool decode_payload(const uint8_t *data, size_t len, size_t count);
+
+    std::vector<double> values_;   ///< Last decoded row; the XOR reference.
+    std::vector<uint8_t> lead_;    ///< Leading zeros of each signal's window.
+    std::vector<uint8_t> meaning_; ///< Meaningful bits of each window; 0 = none yet.
+    bool synced_ = false;
+};
+
+} // namespace daedalus::protocol
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace daedalus::record {
+
+/// On-disk layout of a recorded session (".daedalus" file), little-endian.
+///
+///   SessionFileHeader                      64 bytes
+///   record, record, ...                    each a RecordHeader + payload,
+///                                          padded to 8 bytes
+///   Index record                           IndexEntry[], added on close
+///   SessionTrailer                         48 bytes, added on close
+///
+/// Records are appended in the order the network thread received them:
+/// the raw text of every schema and subscribe ack (which define the layout of
+/// the frames after them) and every raw binary telemetry frame, "HERT" or "HERX",
+/// byte for byte as it came off the wire.
+///
+/// The index is sparse: an entry for the first frame after each layout change and
+/// then one at least every SessionIndexer::kSpacingBytes of records, always at a
+/// frame decoding can start from (any "HERT" frame, a "HERX" keyframe). A
+/// recording may span several simulation runs (a reconnect to a restarted Hermes
+/// begins again at frame 0); each run is a segment, and frame numbers and times
+/// only increase within one. A file
+/// without a valid trailer was not closed cleanly; its records up to the first
+/// incomplete one are intact and the index can be rebuilt from them.
+struct SessionFileHeader {
+    char magic[8];         ///< kSessionMagic
+    uint32_t version;      ///< kSessionVersion
+    uint32_t header_bytes; ///< sizeof(SessionFileHeader); records start here
+    uint64_t created_unix_ns;
+    uint8_t reserved[40];
+};
+static_assert(sizeof(SessionFileHeader) == 64);
+
+inline constexpr char kSessionMagic[8] = {'D', 'A', 'E', 'D', 'S', 'E', 'S', 'S'};
+inline constexpr uint32_t kSessionVersion = 2;
+
+enum class RecordKind : uint32_t {
+    Text = 1,  ///< A JSON control message (schema or subscribe ack).
+    Frame = 2, ///< A binary telemetry frame.
+    Index = 3, ///< The seek index, IndexEntry[] in file order; the last record.
+};
+
+struct RecordHeader {
+    uint32_t kind;        ///< RecordKind
+    uint32_t size;        ///< Payload bytes, excluding padding.
+    uint64_t received_ns; ///< Receive time, nanoseconds since the recording started.
+};
+static_assert(sizeof(RecordHeader) == 16);
+
+inline constexpr size_t kRecordAlignment = 8;
+
+/// Bytes a record with a `size`-byte payload occupies in the file.
+[[nodiscard]] constexpr size_t record_bytes(size_t size) {
+    return sizeof(RecordHeader) +
+           (size + kRecordAlignment - 1) / kRecordAlignment * kRecordAlignment;
+}
+
+/// Offset of a record that does not exist.
+inline constexpr uint64_t kNoRecord = UINT64_MAX;
+
+/// One point of the seek index.
+struct IndexEntry {
+    double time;            ///< Sim time of the frame.
+    uint64_t frame;         ///< Frame number of the frame.
+    uint64_t offset;        ///< File offset of the frame's record.
+    uint64_t schema_offset; ///< Record of the schema in force there, or kNoRecord.
+    uint64_t ack_offset;    ///< Record of the subscribe ack in force there, or kNoRecord.
+    uint32_t segment;       ///< Simulation run the frame belongs to, from 0.
+    uint32_t reserved;
+};
+static_assert(sizeof(IndexEntry) == 48);
+
+/// Last 48 bytes of a cleanly closed session file.
+struct SessionTrailer {
+    char magic[8];         ///< kTrailerMagic
+    uint64_t index_offset; ///< The Index record; also where the stream records end.
+    uint64_t entry_count;
+    uint64_t frame_records; ///< Telemetry frames in the file.
+    double last_time;       ///< Sim time of the last frame.
+    uint64_t last_frame;    ///< Frame number of the last frame.
+};
+static_assert(sizeof(SessionTrailer) == 48);
+
+inline constexpr char kTrailerMagic[8] = {'D', 'A', 'E', 'D', 'I', 'N', 'D', 'X'};
+
+} // namespace daedalus::record
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "daedalus/record/session_format.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace daedalus::record {
+
+/// Header fields of a recorded telemetry frame.
+struct FrameInfo {
+    uint64_t frame = 0;
+    double time = 0.0;
+    bool seekable = false; ///< Decoding can start here: "HERT", or a "HERX" keyframe.
+};
+
+/// Read the header of a Frame record's payload; nullopt if it is not a telemetry frame.
+[[nodiscard]] std::optional<FrameInfo> frame_info(std::span<const uint8_t> payload);
+
+/// Builds a session's seek index from its records, in file order. The recorder's
+/// writer feeds it every record as it writes, so closing only appends the result;
+/// SessionReader feeds it a scan of a file that was never closed.
+///
+/// A frame number lower than the previous frame's starts a new segment (see
+/// session_format.hpp), which always gets an entry of its own.
+class SessionIndexer {
+  public:
+    /// Most record bytes between two index entries (when a seekable frame comes).
+    /// Reaching a time from its entry reads at most about this much.
+    static constexpr uint64_t kSpacingBytes = uint64_t{256} << 10;
+
+    /// Account for the record at file offset `offset`.
+    void add(uint64_t offset, RecordKind kind, std::span<const uint8_t> payload);
+
+    [[nodiscard]] const std::vector<IndexEntry> &entries() const { return entries_; }
+    [[nodiscard]] uint64_t frame_records() const { return frame_records_; }
+    [[nodiscard]] double last_time() const { return last_time_; }
+    [[nodiscard]] uint64_t last_frame() const { return last_frame_; }
+    /// Segments seen so far.
+    [[nodiscard]] uint32_t segments() const { return frame_records_ > 0 ? segment_ + 1 : 0; }
+
+    /// The Index record and trailer that close a file whose records end at
+    /// `records_end`.
+    [[nodiscard]] std::vector<uint8_t> finish(uint64_t records_end) const;
+
+  private:
+    std::vector<IndexEntry> entries_;
+    uint64_t schema_offset_ = kNoRecord;
+    uint64_t ack_offset_ = kNoRecord;
+    bool layout_changed_ = true; ///< No entry since the schema, ack or segment changed.
+    uint32_t segment_ = 0;
+    uint64_t frame_records_ = 0;
+    double last_time_ = 0.0;
+    uint64_t last_frame_ = 0;
+};
+
+} // namespace daedalus::record
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "daedalus/record/session_format.hpp"
+#include "daedalus/record/session_index.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+
+namespace daedalus::record {
+
+/// Read access to a recorded session (see session_format.hpp).
+///
+/// The file is mapped read-only and never loaded: opening a cleanly closed file
+/// reads its header and trailer and views the index in place, and a seek is a
+/// binary search of the index, so both take the same few page faults for a file
+/// of any size. Records are read straight from the mapping as they are visited.
+///
+/// A file without a valid trailer (the recorder crashed or the disk filled) is
+/// scanned once, record header to record header, to rebuild the index in memory;
+/// the scan stops at the first incomplete record. repair() writes the rebuilt
+/// index to the file so later opens are fast again.
+///
+/// Frame numbers and times restart with each simulation run in the recording,
+/// so seeks search one segment of the index (see session_format.hpp).
+/// Thread safety: const methods from any thread once open() has returned.
+class SessionReader {
+  public:
+    /// A record, viewing the mapping.
+    struct Record {
+        RecordKind kind;
+        uint64_t offset; ///< File offset of the record header.
+        uint64_t received_ns;
+        std::span<const uint8_t> payload;
+
+        /// File offset of the record after this one.
+        [[nodiscard]] uint64_t next() const { return offset + record_bytes(payload.size()); }
+    };
+
+    SessionReader() = default;
+    ~SessionReader();
+
+    SessionReader(const SessionReader &) = delete;
+    SessionReader &operator=(const SessionReader &) = delete;
+
+    /// Map `path` and load or rebuild its index. Returns false, with a message on
+    /// stderr, if the file cannot be mapped or is not a session file.
+    bool open(const std::string &path);
+    void close();
+    [[nodiscard]] bool is_open() const { return data_ != nullptr; }
+
+    /// True if the file had no valid trailer and the index was rebuilt.
+    [[nodiscard]] bool recovered() const { return recovered_; }
+
+    /// Truncate a recovered file after its last complete record and append the
+    /// rebuilt index and trailer. Returns false, with a message on stderr, on failure.
+    bool repair();
+
+    /// File offsets of the first record and just past the last stream record.
+    [[nodiscard]] uint64_t records_begin() const { return records_begin_; }
+    [[nodiscard]] uint64_t records_end() const { return records_end_; }
+
+    /// The record at `offset`; nullopt at records_end() or for an offset that
+    /// does not start a complete record.
+    [[nodiscard]] std::optional<Record> read(uint64_t offset) const;
+
+    [[nodiscard]] std::span<const IndexEntry> index() const { return index_; }
+    [[nodiscard]] uint64_t frame_records() const { return frame_records_; }
+    [[nodiscard]] double last_time() const { return last_time_; }
+    [[nodiscard]] uint64_t last_frame() const { return last_frame_; }
+
+    /// Simulation runs in the recording; index entries carry their segment.
+    [[nodiscard]] uint32_t segments() const;
+    /// Segment of the record at `offset`: that of the last index entry at or
+    /// before it, or 0 ahead of the first.
+    [[nodiscard]] uint32_t segment_at(uint64_t offset) const;
+
+    /// Where to start decoding to reach sim time `time` / frame number `frame` in
+    /// run `segment`: the segment's last index entry at or before it, or its
+    /// first entry if it comes earlier. Decode forward from the entry's record
+    /// with the layout of its schema and ack records. nullptr if the segment has
+    /// no entries.
+    [[nodiscard]] const IndexEntry *seek_time(double time, uint32_t segment) const;
+    [[nodiscard]] const IndexEntry *seek_frame(uint64_t frame, uint32_t segment) const;
+
+  private:
+    /// Use the trailer's index; false if the trailer or index is not valid.
+    bool load_index();
+    /// Scan the records, rebuilding the index.
+    void rebuild_index();
+    /// The index entries of `segment` (entries are in segment order).
+    [[nodiscard]] std::span<const IndexEntry> segment_entries(uint32_t segment) const;
+
+    std::string path_;
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+    uint64_t records_begin_ = 0;
+    uint64_t records_end_ = 0;
+    std::span<const IndexEntry> index_; ///< In the mapping, or rebuilt_'s.
+    SessionIndexer rebuilt_;
+    uint64_t frame_records_ = 0;
+    double last_time_ = 0.0;
+    uint64_t last_frame_ = 0;
+    bool recovered_ = false;
+};
+
+} // namespace daedalus::record
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "daedalus/data/byte_ring.hpp"
+#include "daedalus/record/session_format.hpp"
+#include "daedalus/record/session_index.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace daedalus::record {
+
+/// Counters of one recording (any thread).
+struct RecorderStats {
+    uint64_t records = 0;       ///< Accepted from the network thread.
+    uint64_t bytes_written = 0; ///< Reached the file, headers included.
+    uint64_t dropped = 0;       ///< Refused because the ring was full or too small.
+    uint64_t syncs = 0;         ///< fdatasync() calls.
+    bool failed = false;        ///< A write failed; later records are dropped.
+};
+
+/// Appends the raw Hermes stream to a session file (see session_format.hpp).
+///
+/// The network thread copies each message into a ByteRing and returns; it never
+/// waits for the disk. A writer thread drains the ring into large sequential
+/// writes and fdatasync()s the file every sync interval, so a crash loses at most
+/// that much. If the disk falls behind far enough to fill the ring, records are
+/// dropped and counted rather than stalling the WebSocket. The default ring holds
+/// well over a second of 1 kHz × 5k-signal frames (40 MB/s).
+///
+/// The writer indexes each record as it writes it; stop() appends the finished
+/// index and trailer, so closing costs one small write however long the session.
+///
+/// record_text()/record_frame() come from one producer thread; start(), stop()
+/// and stats() from any other.
+class SessionRecorder {
+  public:
+    struct Options {
+        size_t ring_bytes = size_t{128} << 20;
+        size_t write_chunk = size_t{4} << 20; ///< Bytes gathered per write().
+        std::chrono::milliseconds sync_interval{1000};
+    };
+
+    /// Poll interval of the writer while the ring is empty.
+    static constexpr std::chrono::milliseconds kIdleWait{2};
+
+    SessionRecorder() : SessionRecorder(Options{}) {}
+    explicit SessionRecorder(Options options);
+    ~SessionRecorder();
+
+    SessionRecorder(const SessionRecorder &) = delete;
+    SessionRecorder &operator=(const SessionRecorder &) = delete;
+
+    /// Create (truncate) `path`, write the file header and start the writer.
+    /// Returns false, with a message on stderr, if the file cannot be created.
+    bool start(const std::string &path);
+    /// Write out everything recorded so far and the index, sync and close the file.
+    void stop();
+    [[nodiscard]] bool recording() const { return recording_.load(std::memory_order_acquire); }
+    [[nodiscard]] const std::string &path() const { return path_; }
+
+    /// Producer: append a JSON control message / a binary telemetry frame.
+    /// Returns false if the record was dropped (or nothing is being recorded).
+    bool record_text(std::string_view text);
+    bool record_frame(const uint8_t *data, size_t len);
+
+    [[nodiscard]] RecorderStats stats() const;
+
+  private:
+    bool record(RecordKind kind, const uint8_t *data, size_t len);
+    void run(const std::stop_token &stop);
+    /// Write the gathered bytes; returns false on error.
+    bool write_out();
+
+    Options options_;
+    data::ByteRing ring_;
+    std::chrono::steady_clock::time_point started_at_{};
+    std::string path_;
+    int fd_ = -1;
+    std::vector<uint8_t> pending_; ///< Writer only: bytes gathered for the next write().
+    SessionIndexer indexer_;       ///< Writer only.
+    uint64_t file_offset_ = 0;     ///< Writer only: where the next record lands.
+    std::jthread thread_;
+    std::atomic<bool> recording_{false};
+
+    std::atomic<uint64_t> records_{0};
+    std::atomic<uint64_t> bytes_written_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> syncs_{0};
+    std::atomic<bool> failed_{false};
+};
+
+} // namespace daedalus::record
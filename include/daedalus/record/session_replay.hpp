@@ -0,0 +1,109 @@
+#pragma once
+
+#include "daedalus/protocol/telemetry_source.hpp"
+#include "daedalus/record/session_reader.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace daedalus::record {
+
+/// Plays a recorded session (see session_format.hpp) into the live pipeline, so
+/// everything downstream of HermesClient, plotter included, works on recordings.
+///
+/// A background thread reads the mapped file in order. Schemas and subscribe acks
+/// become the same ControlEvents a live connection produces; frames are decoded
+/// into the same batches. Frames are paced by when they were originally received,
+/// divided by the speed; at kMaxSpeed they go as fast as the pipeline takes them,
+/// which makes a repeatable end-to-end ingest benchmark without a server.
+///
+/// It behaves like a Hermes server to its consumer: frames after a subscribe ack
+/// wait for resume(), and pause() holds playback. Subscribe requests are ignored;
+/// the recorded subscription is what plays. A replay never drops telemetry: when
+/// the telemetry queue is full, the reader waits for the ingest thread.
+/// At the end of the file the replay stays connected, holding the last data.
+///
+/// connect(), disconnect() and seek() from one controlling thread; the rest from
+/// any thread.
+class SessionReplay : public protocol::TelemetrySource {
+  public:
+    /// Speed for "as fast as possible".
+    static constexpr double kMaxSpeed = 0.0;
+    /// Poll interval while paused, at the end, or while the telemetry queue is full.
+    static constexpr std::chrono::microseconds kIdleWait{500};
+
+    explicit SessionReplay(std::string path, double speed = 1.0);
+    ~SessionReplay() override;
+
+    /// Open the file and play it from the start. The state goes Connected, or
+    /// Error (with a StateChange event) if the file cannot be read.
+    void connect() override;
+    /// Stop playing and close the file.
+    void disconnect() override;
+    void subscribe(const std::vector<std::string> & /*patterns*/) override {}
+    void pause() override { paused_.store(true, std::memory_order_release); }
+    void resume() override { paused_.store(false, std::memory_order_release); }
+
+    [[nodiscard]] protocol::ConnectionState state() const override {
+        return state_.load(std::memory_order_relaxed);
+    }
+
+    /// Playback speed: 1 = as recorded, 10 = ten times faster, kMaxSpeed = unpaced.
+    void set_speed(double speed) { speed_.store(speed, std::memory_order_relaxed); }
+    [[nodiscard]] double speed() const { return speed_.load(std::memory_order_relaxed); }
+
+    /// Continue from the last index entry at or before sim time `time` in the
+    /// simulation run being played (see SessionReader::seek_time()). The schema
+    /// and ack in force there are sent again, so the consumer starts afresh, and
+    /// frames wait for resume() as after any ack.
+    void seek(double time);
+
+    [[nodiscard]] const std::string &path() const { return path_; }
+    /// Sim time of the last frame played.
+    [[nodiscard]] double position() const { return position_.load(std::memory_order_relaxed); }
+    /// Sim time of the recording's last frame (once connected).
+    [[nodiscard]] double end_time() const { return end_time_; }
+    /// True once every frame has been played.
+    [[nodiscard]] bool finished() const { return finished_.load(std::memory_order_acquire); }
+    [[nodiscard]] uint64_t frames_played() const {
+        return frames_played_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    void run(const std::stop_token &stop);
+    /// Send the layout recorded at `entry` and return the offset to play from.
+    uint64_t start_at(const IndexEntry &entry);
+    /// Send a schema or ack record as its ControlEvent.
+    void deliver_text(uint64_t offset);
+    /// Wait until `record` is due at the current speed. Returns false if a stop,
+    /// pause or seek interrupted the wait.
+    bool wait_until_due(const SessionReader::Record &record, const std::stop_token &stop);
+    /// Wait for room in the telemetry queue; false on stop.
+    bool wait_for_room(const std::stop_token &stop);
+
+    std::string path_;
+    SessionReader reader_;
+    double end_time_ = 0.0;
+    std::jthread thread_;
+    std::atomic<protocol::ConnectionState> state_{protocol::ConnectionState::Disconnected};
+    std::atomic<double> speed_;
+    std::atomic<bool> paused_{false};
+    std::atomic<bool> seek_pending_{false};
+    std::atomic<double> seek_time_{0.0};
+    std::atomic<double> position_{0.0};
+    std::atomic<bool> finished_{false};
+    std::atomic<uint64_t> frames_played_{0};
+
+    // Replay thread only: pacing anchor, the wall time `anchor_received_` is due at.
+    bool anchored_ = false;
+    double anchor_speed_ = 1.0;
+    std::chrono::steady_clock::time_point anchor_wall_{};
+    uint64_t anchor_received_ = 0;
+};
+
+} // namespace daedalus::record
@@ -1,12 +1,11 @@
 #pragma once
 
-#include "daedalus/data/signal_buffer.hpp"
+#include "daedalus/data/signal_store.hpp"
 
 #include <implot/implot.h>
 
 #include <cstddef>
 #include <functional>
-#include <map>
 #include <optional>
 #include <string>
 #include <vector>
@@ -66,7 +65,7 @@ class PlotManager {
     void set_current_time(double time);
     [[nodiscard]] double current_time() const;
 
-    void render(const std::map<size_t, data::SignalBuffer> &signal_buffers);
+    void render(const data::StoreSnapshot &history);
     void render_toolbar();
     void clear();
     void clear_panel_signals();
@@ -79,15 +78,15 @@ class PlotManager {
     bool add_signal_to_active_or_new_panel(size_t buffer_index, const std::string &label,
                                            ImAxis y_axis = ImAxis_Y1);
     [[nodiscard]] std::optional<size_t> active_panel_index() const;
+    /// Whether a signal is drawn on any panel.
+    [[nodiscard]] bool is_plotted(size_t buffer_index) const;
 
   private:
-    void render_panel(size_t index, PlotPanel &panel,
-                      const std::map<size_t, data::SignalBuffer> &signal_buffers,
+    void render_panel(size_t index, PlotPanel &panel, const data::StoreSnapshot &history,
                       bool &request_close);
     void render_panel_context_menu(PlotPanel &panel, bool &request_close);
     void render_statistics_overlay(const PlotPanel &panel, const ImVec2 &plot_pos,
-                                   const ImVec2 &plot_size,
-                                   const std::map<size_t, data::SignalBuffer> &signal_buffers,
+                                   const ImVec2 &plot_size, const data::StoreSnapshot &history,
                                    double x_min, double x_max);
     [[nodiscard]] std::string derive_axis_label(const PlotPanel &panel, ImAxis axis,
                                                 const char *fallback) const;
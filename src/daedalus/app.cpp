@@ -1,51 +1,112 @@
 #include "daedalus/app.hpp"
-#include "daedalus/protocol/telemetry.hpp"
+
+#include "daedalus/headless.hpp"
+#include "daedalus/launch_options.hpp"
 
 #include <GLFW/glfw3.h>
 #include <hello_imgui/hello_imgui.h>
 #include <imgui.h>
 #include <immapp/immapp.h>
-#include <nlohmann/json.hpp>
 
-#include <algorithm>
-#include <cctype>
 #include <cstdio>
 #include <cstdlib>
+#include <ctime>
 #include <string_view>
+#include <utility>
+#include <variant>
 
 namespace daedalus {
 
 namespace {
 
-[[nodiscard]] std::string to_lower_ascii(std::string_view input) {
-    std::string lowered(input);
-    std::transform(lowered.begin(), lowered.end(), lowered.begin(),
-                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
-    return lowered;
+/// Status bar readout for one network → render queue, e.g. "TLM 3/63 hw 40 drop 120".
+/// Drops are highlighted; the tooltip carries the full counter set.
+void render_queue_stats(const char *name, const data::QueueStats &stats) {
+    ImGui::SameLine();
+    ImGui::TextDisabled("|");
+    ImGui::SameLine();
+    ImGui::Text("%s %zu/%zu hw %zu", name, stats.depth, stats.capacity, stats.high_water);
+    if (stats.dropped > 0) {
+        ImGui::SameLine();
+        ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.0f, 1.0f), "drop %llu",
+                           static_cast<unsigned long long>(stats.dropped));
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("%s queue (%s)\nDepth: %zu / %zu\nHigh-water: %zu\n"
+                          "Pushed: %llu  Popped: %llu\nDropped: %llu  Spilled: %llu",
+                          name, data::overflow_policy_name(stats.policy), stats.depth,
+                          stats.capacity, stats.high_water,
+                          static_cast<unsigned long long>(stats.pushed),
+                          static_cast<unsigned long long>(stats.popped),
+                          static_cast<unsigned long long>(stats.dropped),
+                          static_cast<unsigned long long>(stats.spilled));
+    }
 }
 
-[[nodiscard]] bool node_matches_filter(const data::SignalTreeNode &node,
-                                       std::string_view normalized_filter) {
-    if (normalized_filter.empty()) {
-        return true;
+/// Status bar readout for frame-sequence health, e.g. "60.0 Hz RTF 1.00x gaps 2".
+void render_stream_health(const protocol::StreamHealthStats &health) {
+    if (health.frames == 0) {
+        return;
     }
-
-    const std::string lowered_name = to_lower_ascii(node.name);
-    if (lowered_name.find(normalized_filter) != std::string::npos) {
-        return true;
+    ImGui::SameLine();
+    ImGui::TextDisabled("|");
+    ImGui::SameLine();
+    if (health.seconds_since_last_frame > 1.0) {
+        ImGui::TextDisabled("stalled %.0fs", health.seconds_since_last_frame);
+    } else {
+        ImGui::Text("%.1f Hz RTF %.2fx", health.receive_rate_hz, health.real_time_factor);
     }
-
-    const std::string lowered_path = to_lower_ascii(node.full_path);
-    if (lowered_path.find(normalized_filter) != std::string::npos) {
-        return true;
+    // Name only what happened, e.g. "gaps 2 dup 5"; duplicates or reordering
+    // alone lost nothing, so they do not show as gaps.
+    char issues[96] = "";
+    size_t used = 0;
+    auto note = [&](const char *label, uint64_t count) {
+        if (count > 0 && used < sizeof(issues)) {
+            const int n = std::snprintf(issues + used, sizeof(issues) - used, "%s%s %llu",
+                                        used > 0 ? " " : "", label,
+                                        static_cast<unsigned long long>(count));
+            used += n > 0 ? static_cast<size_t>(n) : 0;
+        }
+    };
+    note("gaps", health.gaps);
+    note("dup", health.duplicates);
+    note("reord", health.reordered);
+    if (used > 0) {
+        ImGui::SameLine();
+        ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.0f, 1.0f), "%s", issues);
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Frame %llu at t=%.3f s\nReceive rate: %.1f Hz\n"
+                          "Sim rate: %.1f Hz  RTF: %.2fx\nGaps: %llu (%llu frames missing)\n"
+                          "Duplicates: %llu  Reordered: %llu  Restarts: %llu",
+                          static_cast<unsigned long long>(health.last_frame), health.last_sim_time,
+                          health.receive_rate_hz, health.sim_rate_hz, health.real_time_factor,
+                          static_cast<unsigned long long>(health.gaps),
+                          static_cast<unsigned long long>(health.missing_frames),
+                          static_cast<unsigned long long>(health.duplicates),
+                          static_cast<unsigned long long>(health.reordered),
+                          static_cast<unsigned long long>(health.restarts));
     }
+}
 
-    for (const auto &child : node.children) {
-        if (node_matches_filter(*child, normalized_filter)) {
-            return true;
-        }
+/// Status bar readout for signal history memory, e.g. "HIST 812/2048 MB".
+void render_history_usage(const data::SignalStore &store, const data::HistoryBudget &budget) {
+    constexpr double kMiB = 1024.0 * 1024.0;
+    ImGui::SameLine();
+    ImGui::TextDisabled("|");
+    ImGui::SameLine();
+    const size_t used = store.memory_bytes();
+    ImGui::Text("HIST %.0f/%.0f MB", static_cast<double>(used) / kMiB,
+                static_cast<double>(budget.budget_bytes()) / kMiB);
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Signal history\nUsed: %.1f MB of %.1f MB budget\n"
+                          "Fixed (time, pyramids, guard): %.1f MB\n"
+                          "Full-rate window: up to %zu samples\nWriter guard band: %zu rows",
+                          static_cast<double>(used) / kMiB,
+                          static_cast<double>(budget.budget_bytes()) / kMiB,
+                          static_cast<double>(store.fixed_bytes()) / kMiB, store.capacity(),
+                          store.guard());
     }
-    return false;
 }
 
 } // namespace
@@ -53,7 +114,20 @@ namespace {
 App::App() = default;
 App::~App() = default;
 
-int App::run(int /*argc*/, char * /*argv*/[]) {
+int App::run(int argc, char *argv[]) {
+    const LaunchOptions options = parse_launch_options(argc, argv);
+    if (options.help) {
+        std::printf("%s", kUsage);
+        return 0;
+    }
+    for (const auto &arg : options.unknown) {
+        std::fprintf(stderr, "[Daedalus] Ignoring argument: %s\n", arg.c_str());
+    }
+    // No UI at all: nothing below (GLFW, ImGui) is touched
+    if (options.headless) {
+        return run_headless(options);
+    }
+
     // Register GLFW error callback before initialization for diagnostics.
     // This is safe to call before glfwInit() (Hello ImGui handles that).
     glfwSetErrorCallback([](int error, const char *description) {
@@ -68,8 +142,27 @@ int App::run(int /*argc*/, char * /*argv*/[]) {
         unsetenv("WAYLAND_DISPLAY");
     }
 
-    // Create Hermes client
-    client_ = std::make_unique<protocol::HermesClient>(server_url_);
+    // Signal history budget, shared by every subscribed signal
+    if (options.history_bytes > 0) {
+        history_budget_ = data::HistoryBudget(options.history_bytes);
+    }
+
+    // Telemetry source: a recorded session if asked for, else the Hermes server
+    server_url_ = options.url;
+    if (!options.replay_path.empty()) {
+        auto replay =
+            std::make_unique<record::SessionReplay>(options.replay_path, options.replay_speed);
+        replay_ = replay.get();
+        source_ = std::move(replay);
+    } else {
+        auto client = std::make_unique<protocol::HermesClient>(server_url_);
+        client->set_telemetry_encoding(options.encoding);
+        client_ = client.get();
+        source_ = std::move(client);
+    }
+    ingest_ = std::make_unique<data::IngestThread>(source_->telemetry_queue(),
+                                                   source_->batch_pool());
+    ingest_->set_idle_hook([source = source_.get()] { source->publish_stale(); });
     plot_manager_.set_signal_unit_lookup(
         [this](const std::string &signal_path) -> std::optional<std::string> {
             const auto it = signal_units_.find(signal_path);
@@ -126,17 +219,29 @@ int App::run(int /*argc*/, char * /*argv*/[]) {
     // Status bar: connection status
     runner_params.callbacks.ShowStatus = [this] { render_connection_status(); };
 
-    // Per-frame processing: poll queues and process data
-    runner_params.callbacks.BeforeImGuiRender = [this] {
+    // Per-frame processing: handle control events, then pin the store the
+    // ingest thread has written so far for every widget drawn this frame
+    runner_params.callbacks.PreNewFrame = [this] {
         process_events();
-        process_telemetry();
+        rebalance_history();
+        begin_frame_snapshot();
     };
+    runner_params.callbacks.BeforeImGuiRender = [this] { end_frame_snapshot(); };
 
-    // Connect to Hermes on startup
-    runner_params.callbacks.PostInit = [this] { client_->connect(); };
+    // Connect (or start the replay) and start ingesting on startup
+    runner_params.callbacks.PostInit = [this] {
+        ingest_->start();
+        source_->connect();
+    };
 
     // Disconnect on exit
-    runner_params.callbacks.BeforeExit = [this] { client_->disconnect(); };
+    runner_params.callbacks.BeforeExit = [this] {
+        source_->disconnect();
+        ingest_->stop();
+        if (recorder_) {
+            toggle_recording();
+        }
+    };
 
     // Run with ImmApp (includes ImPlot initialization for future use)
     ImmApp::AddOnsParams addons;
@@ -147,106 +252,127 @@ int App::run(int /*argc*/, char * /*argv*/[]) {
 }
 
 void App::process_events() {
-    std::string json_str;
+    protocol::ControlEvent event;
     // Drain all queued events this frame
-    while (client_->event_queue().try_pop(json_str)) {
-        handle_event(json_str);
+    while (source_->event_queue().try_pop(event)) {
+        handle_event(event);
     }
 }
 
-void App::handle_event(const std::string &json_str) {
-    try {
-        auto msg = nlohmann::json::parse(json_str);
-        std::string type = msg.value("type", "");
-
-        if (type == "schema") {
-            current_schema_ = protocol::parse_schema(msg);
-            signal_tree_.build_from_schema(current_schema_);
-            signal_units_.clear();
-            for (const auto &module : current_schema_.modules) {
-                for (const auto &signal : module.signals) {
-                    if (!signal.unit.has_value()) {
-                        continue;
-                    }
-                    signal_units_.emplace(module.name + "." + signal.name, signal.unit.value());
-                }
-            }
-            schema_received_ = true;
-
-            // Auto-subscribe to all signals
-            client_->subscribe({"*"});
-            std::printf("[Daedalus] Schema received: %zu modules\n",
-                        current_schema_.modules.size());
-
-        } else if (type == "ack") {
-            std::string action = msg.value("action", "");
-            if (action == "subscribe") {
-                auto ack = protocol::parse_subscribe_ack(msg);
-                signal_tree_.update_subscription(ack);
-
-                // Create signal buffers for each subscribed signal
-                subscribed_signals_ = ack.signals;
-                signal_buffers_.clear();
-                for (size_t i = 0; i < ack.signals.size(); ++i) {
-                    signal_buffers_.emplace(i, data::SignalBuffer{});
+void App::handle_event(protocol::ControlEvent &event) {
+    if (auto *schema = std::get_if<protocol::Schema>(&event)) {
+        current_schema_ = std::move(*schema);
+        signal_tree_.build_from_schema(current_schema_);
+        signal_units_.clear();
+        for (const auto &module : current_schema_.modules) {
+            for (const auto &signal : module.signals) {
+                if (!signal.unit.has_value()) {
+                    continue;
                 }
-                plot_manager_.clear_panel_signals();
-
-                std::printf("[Daedalus] Subscribed to %u signals\n", ack.count);
-
-                // Start telemetry flow
-                client_->resume();
-            }
-        } else if (type == "event") {
-            std::string event = msg.value("event", "");
-            std::printf("[Daedalus] Event: %s\n", event.c_str());
-
-        } else if (type == "error") {
-            std::string message = msg.value("message", "");
-            std::fprintf(stderr, "[Daedalus] Error: %s\n", message.c_str());
-
-        } else if (type == "connection") {
-            std::string event = msg.value("event", "");
-            std::printf("[Daedalus] Connection: %s\n", event.c_str());
-
-            if (event == "disconnected") {
-                // Reset state for reconnection
-                schema_received_ = false;
-                subscribed_signals_.clear();
-                signal_buffers_.clear();
-                signal_units_.clear();
-                signal_tree_.clear();
-                plot_manager_.clear_panel_signals();
+                signal_units_.emplace(module.name + "." + signal.name, signal.unit.value());
             }
         }
-    } catch (const std::exception &e) {
-        std::fprintf(stderr, "[Daedalus] Failed to parse event: %s\n", e.what());
+        schema_received_ = true;
+
+        // Auto-subscribe to all signals
+        source_->subscribe({"*"});
+        std::printf("[Daedalus] Schema received: %zu modules\n", current_schema_.modules.size());
+
+    } else if (auto *ack = std::get_if<protocol::SubscribeAck>(&event)) {
+        signal_tree_.update_subscription(*ack);
+        signal_types_ =
+            protocol::DecodePlan(protocol::declared_types(current_schema_), ack->signals).types();
+
+        // Size the history for each subscribed signal within the budget
+        subscribed_signals_ = std::move(ack->signals);
+        store_ = std::make_shared<data::SignalStore>(
+            subscribed_signals_.size(), history_budget_.plan(subscribed_signals_.size()));
+        ingest_->set_store(store_);
+        rebalance_changes_.assign(subscribed_signals_.size(), 0);
+        rebalance_samples_ = 0;
+        plot_manager_.clear_panel_signals();
+
+        std::printf("[Daedalus] Subscribed to %u signals (history %zu MB of %zu MB)\n", ack->count,
+                    store_->memory_bytes() >> 20, history_budget_.budget_bytes() >> 20);
+
+        // Start telemetry flow
+        source_->resume();
+
+    } else if (const auto *sim_event = std::get_if<protocol::SimEvent>(&event)) {
+        std::printf("[Daedalus] Event: %s\n", sim_event->name.c_str());
+
+    } else if (const auto *error = std::get_if<protocol::ServerError>(&event)) {
+        std::fprintf(stderr, "[Daedalus] Error: %s\n", error->message.c_str());
+
+    } else if (const auto *failure = std::get_if<protocol::ParseFailure>(&event)) {
+        std::fprintf(stderr, "[Daedalus] Failed to parse event: %s\n", failure->reason.c_str());
+
+    } else if (const auto *change = std::get_if<protocol::StateChange>(&event)) {
+        switch (change->state) {
+        case protocol::ConnectionState::Connected:
+            std::printf("[Daedalus] Connection: connected\n");
+            break;
+        case protocol::ConnectionState::Error:
+            std::printf("[Daedalus] Connection: error (%s)\n", change->reason.c_str());
+            break;
+        case protocol::ConnectionState::Disconnected:
+            std::printf("[Daedalus] Connection: disconnected\n");
+            // Reset state for reconnection
+            schema_received_ = false;
+            subscribed_signals_.clear();
+            signal_types_.clear();
+            store_.reset();
+            ingest_->set_store(nullptr);
+            rebalance_changes_.clear();
+            rebalance_samples_ = 0;
+            signal_units_.clear();
+            signal_tree_.clear();
+            plot_manager_.clear_panel_signals();
+            break;
+        case protocol::ConnectionState::Connecting:
+            break;
+        }
     }
 }
 
-void App::process_telemetry() {
-    std::vector<uint8_t> frame_data;
-    std::vector<double> value_storage;
-    // Drain all queued telemetry frames this frame
-    while (client_->telemetry_queue().try_pop(frame_data)) {
-        protocol::TelemetryHeader hdr{};
-        std::span<const double> values;
-
-        if (protocol::decode_frame(frame_data.data(), frame_data.size(), hdr, values,
-                                   value_storage)) {
-            for (uint32_t i = 0; i < hdr.count; ++i) {
-                auto it = signal_buffers_.find(i);
-                if (it != signal_buffers_.end()) {
-                    it->second.push(hdr.time, values[i]);
-                }
-            }
-            plot_manager_.set_current_time(hdr.time);
-        }
+void App::begin_frame_snapshot() {
+    frame_snapshot_ = store_ ? store_->snapshot() : data::StoreSnapshot{};
+    if (!frame_snapshot_.empty()) {
+        plot_manager_.set_current_time(frame_snapshot_.last_time());
+    }
+}
+
+void App::end_frame_snapshot() { frame_snapshot_ = data::StoreSnapshot{}; }
+
+void App::rebalance_history() {
+    constexpr auto kRebalanceInterval = std::chrono::seconds(2);
+    const auto now = std::chrono::steady_clock::now();
+    if (!store_ || now - last_rebalance_ < kRebalanceInterval) {
+        return;
     }
+    last_rebalance_ = now;
+
+    // Nothing new to learn from a paused stream
+    const uint64_t samples = store_->samples();
+    const uint64_t rows = samples - rebalance_samples_;
+    if (rows == 0) {
+        return;
+    }
+
+    std::vector<data::SignalDemand> demand(store_->signal_count());
+    for (size_t s = 0; s < demand.size(); ++s) {
+        const uint64_t changes = store_->column_changes(s);
+        demand[s].plotted = plot_manager_.is_plotted(s);
+        demand[s].activity =
+            static_cast<double>(changes - rebalance_changes_[s]) / static_cast<double>(rows);
+        rebalance_changes_[s] = changes;
+    }
+    rebalance_samples_ = samples;
+    history_budget_.rebalance(*store_, demand);
 }
 
 void App::render_connection_status() {
-    auto state = client_->state();
+    auto state = source_->state();
     ImVec4 color = ImVec4(0.6f, 0.6f, 0.6f, 1.0f);
     const char *label = "Unknown";
 
@@ -278,7 +404,25 @@ void App::render_connection_status() {
     ImGui::SameLine();
     ImGui::TextDisabled("|");
     ImGui::SameLine();
-    ImGui::Text("%s", server_url_.c_str());
+    if (replay_ != nullptr) {
+        ImGui::Text("%s", replay_->path().c_str());
+        ImGui::SameLine();
+        ImGui::TextDisabled("|");
+        ImGui::SameLine();
+        const double speed = replay_->speed();
+        if (speed <= record::SessionReplay::kMaxSpeed) {
+            ImGui::Text("Replay %.1f/%.1f s max", replay_->position(), replay_->end_time());
+        } else {
+            ImGui::Text("Replay %.1f/%.1f s %gx", replay_->position(), replay_->end_time(),
+                        speed);
+        }
+        if (replay_->finished()) {
+            ImGui::SameLine();
+            ImGui::TextDisabled("(end)");
+        }
+    } else {
+        ImGui::Text("%s", server_url_.c_str());
+    }
 
     if (!subscribed_signals_.empty()) {
         ImGui::SameLine();
@@ -286,6 +430,57 @@ void App::render_connection_status() {
         ImGui::SameLine();
         ImGui::Text("%zu signals", subscribed_signals_.size());
     }
+
+    render_stream_health(source_->stream_health());
+    if (store_) {
+        render_history_usage(*store_, history_budget_);
+    }
+    render_queue_stats("TLM", source_->telemetry_queue().stats());
+    render_queue_stats("EVT", source_->event_queue().stats());
+
+    if (client_ == nullptr) {
+        return; // only a live stream can be recorded
+    }
+    ImGui::SameLine();
+    ImGui::TextDisabled("|");
+    ImGui::SameLine();
+    if (ImGui::SmallButton(recorder_ ? "Stop recording" : "Record")) {
+        toggle_recording();
+    }
+    if (recorder_) {
+        const auto stats = recorder_->stats();
+        ImGui::SameLine();
+        ImGui::TextColored(ImVec4(1.0f, 0.2f, 0.2f, 1.0f), "REC %.1f MB",
+                           static_cast<double>(stats.bytes_written) / (1024.0 * 1024.0));
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("%s\nRecords: %llu  Dropped: %llu%s", recorder_->path().c_str(),
+                              static_cast<unsigned long long>(stats.records),
+                              static_cast<unsigned long long>(stats.dropped),
+                              stats.failed ? "\nWrite failed" : "");
+        }
+    }
+}
+
+void App::toggle_recording() {
+    if (recorder_) {
+        client_->set_recorder(nullptr);
+        recorder_->stop();
+        std::printf("[Daedalus] Recording stopped: %s (%llu records)\n",
+                    recorder_->path().c_str(),
+                    static_cast<unsigned long long>(recorder_->stats().records));
+        recorder_.reset();
+        return;
+    }
+
+    char path[64];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(path, sizeof(path), "session-%Y%m%d-%H%M%S.daedalus", std::localtime(&now));
+    auto recorder = std::make_shared<record::SessionRecorder>();
+    if (recorder->start(path)) {
+        client_->set_recorder(recorder);
+        recorder_ = std::move(recorder);
+        std::printf("[Daedalus] Recording to %s\n", path);
+    }
 }
 
 void App::render_signal_tree() {
@@ -294,92 +489,112 @@ void App::render_signal_tree() {
         return;
     }
 
-    const bool apply_tree_open_request = tree_open_state_request_.has_value();
-
-    // Search filter
+    // Search filter; the tree re-evaluates it only when the text changes.
     static char filter[128] = "";
     ImGui::InputTextWithHint("##filter", "Filter signals...", filter, sizeof(filter));
     ImGui::Separator();
-
-    const std::string normalized_filter = to_lower_ascii(std::string_view(filter));
-    auto &root = signal_tree_.root();
-    for (auto &child : root.children) {
-        if (node_matches_filter(*child, normalized_filter)) {
-            render_signal_tree_node(*child, normalized_filter);
+    signal_tree_.set_filter(filter);
+
+    // Only the rows on screen are submitted, so an expanded 100k-signal tree costs
+    // no more per frame than a collapsed one.
+    const auto &rows = signal_tree_.rows();
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(rows.size()));
+    while (clipper.Step()) {
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+            render_signal_tree_row(rows[static_cast<size_t>(i)]);
         }
     }
+    clipper.End();
 
     if (ImGui::BeginPopupContextWindow("signal_tree_context", ImGuiPopupFlags_MouseButtonRight)) {
         if (ImGui::MenuItem("Expand all trees")) {
-            tree_open_state_request_ = true;
+            signal_tree_.set_all_expanded(true);
         }
         if (ImGui::MenuItem("Collapse all trees")) {
-            tree_open_state_request_ = false;
+            signal_tree_.set_all_expanded(false);
         }
         ImGui::EndPopup();
     }
-    if (apply_tree_open_request) {
-        tree_open_state_request_.reset();
-    }
 }
 
-void App::render_signal_tree_node(const data::SignalTreeNode &node, std::string_view filter) {
-    ImGui::PushID(node.full_path.c_str());
+void App::render_signal_tree_row(const data::SignalTreeRow &row) {
+    const data::SignalTreeNode &node = *row.node;
+    const float indent = static_cast<float>(row.depth) * ImGui::GetStyle().IndentSpacing;
+    if (indent > 0.0f) {
+        ImGui::Indent(indent);
+    }
+    // Node strings view the tree's path buffer and are not NUL-terminated.
+    const std::string_view path = node.full_path;
+    const int path_len = static_cast<int>(path.size());
+    ImGui::PushID(path.data(), path.data() + path.size());
 
     if (node.is_leaf) {
         // Leaf node: show signal name + current value
         ImGuiTreeNodeFlags leaf_flags = ImGuiTreeNodeFlags_Leaf |
                                         ImGuiTreeNodeFlags_NoTreePushOnOpen |
                                         ImGuiTreeNodeFlags_SpanAvailWidth;
-        ImGui::TreeNodeEx(node.name.c_str(), leaf_flags);
+        ImGui::TreeNodeEx("node", leaf_flags, "%.*s", static_cast<int>(node.name.size()),
+                          node.name.data());
 
         // Drag source + double-click quick-add for plotting.
         if (node.signal_index.has_value()) {
             if (ImGui::BeginDragDropSource(ImGuiDragDropFlags_SourceNoHoldToOpenOthers)) {
                 views::DragDropSignalPayload payload{};
                 payload.buffer_index = node.signal_index.value();
-                std::snprintf(payload.label, sizeof(payload.label), "%s", node.full_path.c_str());
+                std::snprintf(payload.label, sizeof(payload.label), "%.*s", path_len, path.data());
                 ImGui::SetDragDropPayload(views::kDndSignalPayloadType, &payload, sizeof(payload));
-                ImGui::TextUnformatted(node.full_path.c_str());
+                ImGui::TextUnformatted(path.data(), path.data() + path.size());
                 ImGui::EndDragDropSource();
             }
 
             if (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left)) {
                 plot_manager_.add_signal_to_active_or_new_panel(node.signal_index.value(),
-                                                                node.full_path);
+                                                                std::string(path));
             }
         }
 
         // Show current value on the same line
         if (node.signal_index.has_value()) {
-            auto it = signal_buffers_.find(node.signal_index.value());
-            if (it != signal_buffers_.end() && !it->second.empty()) {
+            const auto *series = frame_snapshot_.find(node.signal_index.value());
+            if (series != nullptr && !series->empty()) {
+                const size_t index = node.signal_index.value();
+                const bool integral =
+                    index < signal_types_.size() && protocol::is_integral(signal_types_[index]);
                 ImGui::SameLine();
-                ImGui::TextDisabled("%.4f", it->second.last_value());
+                if (integral) {
+                    ImGui::TextDisabled("%.0f", series->last_value());
+                } else {
+                    ImGui::TextDisabled("%.4f", series->last_value());
+                }
+                if (ImGui::IsItemHovered() && store_) {
+                    ImGui::SetTooltip("History: %zu of %zu samples at full rate\n%.1f KiB",
+                                      series->size(), store_->column_capacity(index),
+                                      static_cast<double>(store_->column_bytes(index)) / 1024.0);
+                }
             }
         }
     } else {
-        // Internal node: expandable tree
-        if (tree_open_state_request_.has_value()) {
-            ImGui::SetNextItemOpen(tree_open_state_request_.value(), ImGuiCond_Always);
-        }
-        bool open = ImGui::TreeNodeEx(node.name.c_str(), ImGuiTreeNodeFlags_SpanAvailWidth);
-        if (open) {
-            for (auto &child : node.children) {
-                if (node_matches_filter(*child, filter)) {
-                    render_signal_tree_node(*child, filter);
-                }
-            }
-            ImGui::TreePop();
+        // Internal node: the tree owns the open state; children are rows of their own.
+        const bool expanded = signal_tree_.expanded(node);
+        ImGui::SetNextItemOpen(expanded, ImGuiCond_Always);
+        const bool open = ImGui::TreeNodeEx(
+            "node", ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_NoTreePushOnOpen,
+            "%.*s", static_cast<int>(node.name.size()), node.name.data());
+        if (open != expanded) {
+            signal_tree_.set_expanded(node, open); // rows are rebuilt next frame
         }
     }
 
     ImGui::PopID();
+    if (indent > 0.0f) {
+        ImGui::Unindent(indent);
+    }
 }
 
 void App::render_plot_workspace() {
     plot_manager_.render_toolbar();
-    plot_manager_.render(signal_buffers_);
+    plot_manager_.render(frame_snapshot_);
 }
 
 } // namespace daedalus
@@ -0,0 +1,128 @@
+#include "daedalus/data/history_budget.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace daedalus::data {
+
+namespace {
+
+/// Doubles of a budget left for full-rate samples once `fixed` bytes are taken.
+double sample_budget(size_t budget_bytes, size_t fixed) {
+    const size_t free_bytes = budget_bytes > fixed ? budget_bytes - fixed : 0;
+    return static_cast<double>(free_bytes) * (1.0 - HistoryBudget::kReserve) / sizeof(double);
+}
+
+/// Bytes of a store's fixed costs for `signal_count` signals (see
+/// SignalStore::fixed_bytes()), without allocating it. Ring padding is taken at
+/// its worst case.
+size_t fixed_bytes(size_t signal_count, const StoreGeometry &geometry) {
+    constexpr size_t kPerLine = SignalStore::kColumnAlignment / sizeof(double);
+    const LodLayout layout(geometry.capacity, geometry.guard, geometry.archive_buckets);
+    const size_t pyramid = (layout.column_doubles() + kPerLine - 1) / kPerLine * kPerLine;
+    return (geometry.capacity + geometry.guard + (signal_count + 1) * (pyramid + kPerLine) +
+            signal_count * geometry.guard) *
+           sizeof(double);
+}
+
+double weight(const SignalDemand &demand) {
+    const double activity = std::clamp(demand.activity, 0.0, 1.0);
+    const double scale = demand.plotted ? HistoryBudget::kPlottedWeight : 1.0;
+    return scale * (HistoryBudget::kIdleWeight + (1.0 - HistoryBudget::kIdleWeight) * activity);
+}
+
+} // namespace
+
+StoreGeometry HistoryBudget::plan(size_t signal_count) const {
+    const size_t columns = std::max<size_t>(signal_count, 1);
+    const size_t share = budget_bytes_ / columns;
+
+    // A plotted column may grow to kPlottedWeight equal shares of the sample half.
+    StoreGeometry geometry;
+    geometry.capacity =
+        std::clamp(static_cast<size_t>(kPlottedWeight) * share / 2 / sizeof(double),
+                   SignalStore::kMinColumnCapacity, kMaxCapacity);
+
+    // Trade archive depth, then guard band, then the largest window for fixed cost.
+    while (fixed_bytes(signal_count, geometry) > budget_bytes_ / 2) {
+        if (geometry.archive_buckets > kMinArchiveBuckets) {
+            geometry.archive_buckets /= 2;
+        } else if (geometry.guard > kMinGuard) {
+            geometry.guard /= 2;
+        } else if (geometry.capacity > SignalStore::kMinColumnCapacity) {
+            geometry.capacity = std::max(geometry.capacity / 2, SignalStore::kMinColumnCapacity);
+        } else {
+            break;
+        }
+    }
+
+    const double samples = sample_budget(budget_bytes_, fixed_bytes(signal_count, geometry));
+    geometry.column_capacity =
+        std::clamp(static_cast<size_t>(samples) / columns,
+                   std::min(SignalStore::kMinColumnCapacity, geometry.capacity),
+                   geometry.capacity);
+    return geometry;
+}
+
+std::vector<size_t> HistoryBudget::allocate(const SignalStore &store,
+                                            std::span<const SignalDemand> demand) const {
+    const size_t count = store.signal_count();
+    const size_t lo = std::min(SignalStore::kMinColumnCapacity, store.capacity());
+    const size_t hi = store.capacity();
+
+    std::vector<double> weights(count);
+    for (size_t s = 0; s < count; ++s) {
+        weights[s] = weight(s < demand.size() ? demand[s] : SignalDemand{});
+    }
+
+    // Water-fill: columns that hit the cap soonest relative to their weight are
+    // settled first, and what they cannot use flows to the rest.
+    std::vector<size_t> order(count);
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::sort(order.begin(), order.end(),
+              [&weights](size_t a, size_t b) { return weights[a] > weights[b]; });
+
+    double remaining = sample_budget(budget_bytes_, store.fixed_bytes());
+    double weight_left = std::accumulate(weights.begin(), weights.end(), 0.0);
+
+    std::vector<size_t> targets(count, lo);
+    for (const size_t s : order) {
+        const double share = weight_left > 0.0 ? remaining * weights[s] / weight_left : 0.0;
+        targets[s] = std::clamp(static_cast<size_t>(share), lo, hi);
+        remaining = std::max(0.0, remaining - static_cast<double>(targets[s]));
+        weight_left -= weights[s];
+    }
+    return targets;
+}
+
+size_t HistoryBudget::rebalance(SignalStore &store, std::span<const SignalDemand> demand) const {
+    const std::vector<size_t> targets = allocate(store, demand);
+
+    std::vector<size_t> next(targets.size());
+    size_t total = store.fixed_bytes();
+    for (size_t s = 0; s < targets.size(); ++s) {
+        const auto current = static_cast<double>(store.column_capacity(s));
+        const auto target = static_cast<double>(targets[s]);
+        const bool moved = target > current * (1.0 + kHysteresis) ||
+                           target * (1.0 + kHysteresis) < current;
+        next[s] = moved ? targets[s] : store.column_capacity(s);
+        total += next[s] * sizeof(double);
+    }
+    // Columns held back by hysteresis must not push the store over budget.
+    if (total > budget_bytes_) {
+        for (size_t s = 0; s < targets.size(); ++s) {
+            next[s] = std::min(next[s], targets[s]);
+        }
+    }
+
+    size_t resized = 0;
+    for (size_t s = 0; s < next.size(); ++s) {
+        if (next[s] != store.column_capacity(s)) {
+            store.set_column_capacity(s, next[s]);
+            ++resized;
+        }
+    }
+    return resized;
+}
+
+} // namespace daedalus::data
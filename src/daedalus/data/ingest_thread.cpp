@@ -0,0 +1,84 @@
+#include "daedalus/data/ingest_thread.hpp"
+
+#include <utility>
+
+namespace daedalus::data {
+
+IngestThread::IngestThread(TelemetryQueue &queue, BatchPool &pool) : queue_(queue), pool_(pool) {}
+
+IngestThread::~IngestThread() { stop(); }
+
+void IngestThread::start() {
+    if (thread_.joinable()) {
+        return;
+    }
+    thread_ = std::jthread([this](std::stop_token stop) { run(stop); });
+}
+
+void IngestThread::stop() {
+    if (thread_.joinable()) {
+        thread_.request_stop();
+        thread_.join();
+    }
+}
+
+void IngestThread::set_store(std::shared_ptr<SignalStore> store) {
+    std::lock_guard<std::mutex> lock(store_mutex_);
+    next_store_ = std::move(store);
+    store_generation_.fetch_add(1, std::memory_order_release);
+}
+
+void IngestThread::run(const std::stop_token &stop) {
+    std::shared_ptr<SignalStore> store;
+    uint64_t generation = 0;
+    FrameBatch batch;
+
+    auto refresh_store = [&] {
+        const uint64_t latest = store_generation_.load(std::memory_order_acquire);
+        if (latest == generation) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(store_mutex_);
+        store = next_store_;
+        generation = latest;
+        return true;
+    };
+
+    while (!stop.stop_requested()) {
+        refresh_store();
+        if (!queue_.try_pop(batch)) {
+            if (idle_hook_) {
+                idle_hook_();
+            }
+            std::this_thread::sleep_for(kIdleWait);
+            continue;
+        }
+
+        size_t row = 0;
+        if (store && batch.signal_count == store->signal_count()) {
+            while (row < batch.rows && !stop.stop_requested()) {
+                const size_t written = store->append_rows(batch, row);
+                if (written > 0) {
+                    row += written;
+                    continue;
+                }
+                // The render thread holds a snapshot we would overrun; wait it out
+                // unless the store is being replaced anyway.
+                pinned_waits_.fetch_add(1, std::memory_order_relaxed);
+                if (refresh_store()) {
+                    break;
+                }
+                std::this_thread::sleep_for(kPinnedWait);
+            }
+        }
+        if (row > 0) {
+            ingest_latency_.record(std::chrono::steady_clock::now() - batch.received_at);
+        }
+        rows_ingested_.fetch_add(row, std::memory_order_relaxed);
+        samples_ingested_.fetch_add(row * batch.signal_count, std::memory_order_relaxed);
+        rows_discarded_.fetch_add(batch.rows - row, std::memory_order_relaxed);
+        pool_.release(std::move(batch));
+    }
+}
+
+} // namespace daedalus::data
@@ -0,0 +1,263 @@
+#include "daedalus/data/scan_kernels.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define DAEDALUS_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+namespace daedalus::data {
+
+namespace {
+
+constexpr double kInf = std::numeric_limits<double>::infinity();
+/// Binary search narrows to this many elements before the linear count takes over.
+constexpr size_t kLinearSearch = 32;
+
+// --- Scalar ------------------------------------------------------------------
+
+RangeStats stats_scalar(const double *values, size_t n) {
+    RangeStats stats;
+    if (n == 0) {
+        return stats;
+    }
+    double lo = kInf;
+    double hi = -kInf;
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        lo = values[i] < lo ? values[i] : lo;
+        hi = values[i] > hi ? values[i] : hi;
+        sum += values[i];
+    }
+    stats.merge(lo, hi, sum, n);
+    return stats;
+}
+
+size_t crossing_scalar(const double *values, size_t n, double threshold) {
+    for (size_t i = 1; i < n; ++i) {
+        if ((values[i - 1] >= threshold) != (values[i] >= threshold)) {
+            return i;
+        }
+    }
+    return n;
+}
+
+/// Narrow [lo, hi) to at most kLinearSearch elements still containing the bound.
+void narrow_lower_bound(const double *values, double target, size_t &lo, size_t &hi) {
+    while (hi - lo > kLinearSearch) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (values[mid] < target) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+}
+
+size_t lower_bound_scalar(const double *values, size_t n, double target) {
+    size_t lo = 0;
+    size_t hi = n;
+    narrow_lower_bound(values, target, lo, hi);
+    while (lo < hi && values[lo] < target) {
+        ++lo;
+    }
+    return lo;
+}
+
+constexpr ScanKernels kScalar{ScanIsa::Scalar, stats_scalar, crossing_scalar,
+                              lower_bound_scalar};
+
+#ifdef DAEDALUS_SCAN_X86
+
+// --- SSE2 --------------------------------------------------------------------
+// min/max take the accumulator as the second operand: on a NaN input they return
+// it unchanged, which matches the scalar kernels.
+
+__attribute__((target("sse2"))) RangeStats stats_sse2(const double *values, size_t n) {
+    __m128d lo = _mm_set1_pd(kInf);
+    __m128d hi = _mm_set1_pd(-kInf);
+    __m128d sum = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const __m128d v = _mm_loadu_pd(values + i);
+        lo = _mm_min_pd(v, lo);
+        hi = _mm_max_pd(v, hi);
+        sum = _mm_add_pd(sum, v);
+    }
+    alignas(16) double l[2];
+    alignas(16) double h[2];
+    alignas(16) double s[2];
+    _mm_store_pd(l, lo);
+    _mm_store_pd(h, hi);
+    _mm_store_pd(s, sum);
+    RangeStats stats = stats_scalar(values + i, n - i);
+    stats.merge(std::min(l[0], l[1]), std::max(h[0], h[1]), s[0] + s[1], i);
+    return stats;
+}
+
+__attribute__((target("sse2"))) size_t crossing_sse2(const double *values, size_t n,
+                                                     double threshold) {
+    const __m128d t = _mm_set1_pd(threshold);
+    size_t i = 1;
+    for (; i + 2 <= n; i += 2) {
+        const __m128d prev = _mm_cmpge_pd(_mm_loadu_pd(values + i - 1), t);
+        const __m128d curr = _mm_cmpge_pd(_mm_loadu_pd(values + i), t);
+        const int mask = _mm_movemask_pd(_mm_xor_pd(prev, curr));
+        if (mask != 0) {
+            return i + static_cast<size_t>(std::countr_zero(static_cast<unsigned>(mask)));
+        }
+    }
+    const size_t rest = crossing_scalar(values + i - 1, n - i + 1, threshold);
+    return i - 1 + rest;
+}
+
+__attribute__((target("sse2"))) size_t lower_bound_sse2(const double *values, size_t n,
+                                                        double target) {
+    size_t lo = 0;
+    size_t hi = n;
+    narrow_lower_bound(values, target, lo, hi);
+    // Sorted input: the bound is lo plus the number of elements below target.
+    const __m128d t = _mm_set1_pd(target);
+    size_t below = 0;
+    size_t i = lo;
+    for (; i + 2 <= hi; i += 2) {
+        const int mask = _mm_movemask_pd(_mm_cmplt_pd(_mm_loadu_pd(values + i), t));
+        below += static_cast<size_t>(std::popcount(static_cast<unsigned>(mask)));
+    }
+    for (; i < hi; ++i) {
+        below += values[i] < target ? 1 : 0;
+    }
+    return lo + below;
+}
+
+constexpr ScanKernels kSse2{ScanIsa::Sse2, stats_sse2, crossing_sse2, lower_bound_sse2};
+
+// --- AVX2 --------------------------------------------------------------------
+
+__attribute__((target("avx2"))) RangeStats stats_avx2(const double *values, size_t n) {
+    // Two accumulators per quantity hide the add latency.
+    __m256d lo0 = _mm256_set1_pd(kInf);
+    __m256d lo1 = lo0;
+    __m256d hi0 = _mm256_set1_pd(-kInf);
+    __m256d hi1 = hi0;
+    __m256d sum0 = _mm256_setzero_pd();
+    __m256d sum1 = sum0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256d a = _mm256_loadu_pd(values + i);
+        const __m256d b = _mm256_loadu_pd(values + i + 4);
+        lo0 = _mm256_min_pd(a, lo0);
+        lo1 = _mm256_min_pd(b, lo1);
+        hi0 = _mm256_max_pd(a, hi0);
+        hi1 = _mm256_max_pd(b, hi1);
+        sum0 = _mm256_add_pd(sum0, a);
+        sum1 = _mm256_add_pd(sum1, b);
+    }
+    alignas(32) double l[4];
+    alignas(32) double h[4];
+    alignas(32) double s[4];
+    _mm256_store_pd(l, _mm256_min_pd(lo0, lo1));
+    _mm256_store_pd(h, _mm256_max_pd(hi0, hi1));
+    _mm256_store_pd(s, _mm256_add_pd(sum0, sum1));
+    RangeStats stats = stats_sse2(values + i, n - i);
+    stats.merge(std::min(std::min(l[0], l[1]), std::min(l[2], l[3])),
+                std::max(std::max(h[0], h[1]), std::max(h[2], h[3])), (s[0] + s[1]) + (s[2] + s[3]),
+                i);
+    return stats;
+}
+
+__attribute__((target("avx2"))) size_t crossing_avx2(const double *values, size_t n,
+                                                     double threshold) {
+    const __m256d t = _mm256_set1_pd(threshold);
+    size_t i = 1;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d prev = _mm256_cmp_pd(_mm256_loadu_pd(values + i - 1), t, _CMP_GE_OQ);
+        const __m256d curr = _mm256_cmp_pd(_mm256_loadu_pd(values + i), t, _CMP_GE_OQ);
+        const int mask = _mm256_movemask_pd(_mm256_xor_pd(prev, curr));
+        if (mask != 0) {
+            return i + static_cast<size_t>(std::countr_zero(static_cast<unsigned>(mask)));
+        }
+    }
+    const size_t rest = crossing_scalar(values + i - 1, n - i + 1, threshold);
+    return i - 1 + rest;
+}
+
+__attribute__((target("avx2"))) size_t lower_bound_avx2(const double *values, size_t n,
+                                                        double target) {
+    size_t lo = 0;
+    size_t hi = n;
+    narrow_lower_bound(values, target, lo, hi);
+    const __m256d t = _mm256_set1_pd(target);
+    size_t below = 0;
+    size_t i = lo;
+    for (; i + 4 <= hi; i += 4) {
+        const __m256d lt = _mm256_cmp_pd(_mm256_loadu_pd(values + i), t, _CMP_LT_OQ);
+        below += static_cast<size_t>(
+            std::popcount(static_cast<unsigned>(_mm256_movemask_pd(lt))));
+    }
+    for (; i < hi; ++i) {
+        below += values[i] < target ? 1 : 0;
+    }
+    return lo + below;
+}
+
+constexpr ScanKernels kAvx2{ScanIsa::Avx2, stats_avx2, crossing_avx2, lower_bound_avx2};
+
+#endif // DAEDALUS_SCAN_X86
+
+ScanIsa detect() {
+#ifdef DAEDALUS_SCAN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return ScanIsa::Avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return ScanIsa::Sse2;
+    }
+#endif
+    return ScanIsa::Scalar;
+}
+
+} // namespace
+
+const char *scan_isa_name(ScanIsa isa) {
+    switch (isa) {
+    case ScanIsa::Avx2:
+        return "avx2";
+    case ScanIsa::Sse2:
+        return "sse2";
+    case ScanIsa::Scalar:
+        break;
+    }
+    return "scalar";
+}
+
+ScanIsa detected_scan_isa() {
+    static const ScanIsa isa = detect();
+    return isa;
+}
+
+bool scan_isa_supported(ScanIsa isa) { return isa <= detected_scan_isa(); }
+
+const ScanKernels &scan_kernels(ScanIsa isa) {
+    isa = std::min(isa, detected_scan_isa());
+#ifdef DAEDALUS_SCAN_X86
+    if (isa == ScanIsa::Avx2) {
+        return kAvx2;
+    }
+    if (isa == ScanIsa::Sse2) {
+        return kSse2;
+    }
+#endif
+    return kScalar;
+}
+
+const ScanKernels &scan_kernels() {
+    static const ScanKernels &best = scan_kernels(detected_scan_isa());
+    return best;
+}
+
+} // namespace daedalus::data
@@ -0,0 +1,302 @@
+#include "daedalus/data/signal_lod.hpp"
+
+#include "daedalus/data/signal_view.hpp"
+
+#include <algorithm>
+
+namespace daedalus::data {
+
+namespace {
+
+/// Write the extremes of `values`, in the order they occur, and their mean to
+/// out[0..3).
+void store_summary(double *out, const double *values, size_t n, double mean) {
+    size_t lo = 0;
+    size_t hi = 0;
+    for (size_t i = 1; i < n; ++i) {
+        if (values[i] < values[lo]) {
+            lo = i;
+        }
+        if (values[i] > values[hi]) {
+            hi = i;
+        }
+    }
+    out[0] = values[std::min(lo, hi)];
+    out[1] = values[std::max(lo, hi)];
+    out[2] = mean;
+}
+
+/// First bucket in [lo, hi) for which `pred` is false (pred must be monotonic).
+template <typename Pred> uint64_t partition_buckets(uint64_t lo, uint64_t hi, Pred pred) {
+    while (lo < hi) {
+        const uint64_t mid = lo + (hi - lo) / 2;
+        if (pred(mid)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+} // namespace
+
+LodLayout::LodLayout(size_t capacity, size_t guard, size_t archive_buckets) {
+    // Levels stop once two buckets would no longer fit in the largest full-rate
+    // window; coarser ones would only add reach.
+    const size_t readable = std::max<size_t>(archive_buckets, 2);
+    size_t offset = 0;
+    for (unsigned shift = kBaseShift; (size_t{2} << shift) <= capacity; ++shift) {
+        const size_t slots = readable + (guard >> shift) + 3;
+        readable_.push_back(readable);
+        slots_.push_back(slots);
+        offsets_.push_back(offset);
+        offset += kEntryDoubles * slots;
+    }
+    column_doubles_ = offset;
+}
+
+void lod_update(double *pyramid, const LodLayout &layout, const double *ring, size_t physical,
+                uint64_t from, uint64_t to) {
+    constexpr size_t kBaseWidth = size_t{1} << LodLayout::kBaseShift;
+    constexpr size_t kEntry = LodLayout::kEntryDoubles;
+    double values[kBaseWidth];
+
+    for (size_t level = 0; level < layout.levels(); ++level) {
+        const unsigned shift = LodLayout::shift(level);
+        const uint64_t first = from >> shift;
+        const uint64_t last = to >> shift;
+        if (first == last) {
+            break; // No bucket completed here, so none above either.
+        }
+
+        double *out = pyramid + layout.offset(level);
+        for (uint64_t b = first; b < last; ++b) {
+            const size_t slot = static_cast<size_t>(b % layout.slots(level));
+            if (level == 0) {
+                size_t idx = static_cast<size_t>((b << shift) % physical);
+                double sum = 0.0;
+                for (double &value : values) {
+                    value = ring[idx];
+                    sum += value;
+                    idx = idx + 1 == physical ? 0 : idx + 1;
+                }
+                store_summary(out + kEntry * slot, values, kBaseWidth,
+                              sum / static_cast<double>(kBaseWidth));
+                continue;
+            }
+
+            // Both children of a completed bucket are complete and still in their ring.
+            const double *below = pyramid + layout.offset(level - 1);
+            const size_t child_slots = layout.slots(level - 1);
+            const double *left = below + kEntry * static_cast<size_t>((2 * b) % child_slots);
+            const double *right = below + kEntry * static_cast<size_t>((2 * b + 1) % child_slots);
+            const double children[4] = {left[0], left[1], right[0], right[1]};
+            store_summary(out + kEntry * slot, children, 4, 0.5 * (left[2] + right[2]));
+        }
+    }
+}
+
+RangeStats range_stats(const SignalView &view, size_t start, size_t count) {
+    RangeStats stats;
+    const LodColumn lod = view.lod();
+    const uint64_t view_first = view.end() - view.size();
+    const uint64_t end = view_first + start + count;
+
+    // Raw samples [raw, pos) not yet folded in.
+    uint64_t raw = view_first + start;
+    const auto flush_raw = [&](uint64_t pos) {
+        const RingSpans spans = view.value_spans(static_cast<size_t>(raw - view_first),
+                                                 static_cast<size_t>(pos - raw));
+        stats.merge(scan_stats(spans.first));
+        stats.merge(scan_stats(spans.second));
+    };
+
+    uint64_t pos = raw;
+    while (pos < end) {
+        // Largest bucket that starts here, fits the range and is still retained.
+        uint64_t width = 0;
+        for (size_t level = lod.levels(); level-- > 0;) {
+            const unsigned shift = LodLayout::shift(level);
+            const uint64_t bucket = pos >> shift;
+            if (pos % (uint64_t{1} << shift) != 0 || ((bucket + 1) << shift) > end ||
+                bucket + lod.layout().readable(level) < view.end() >> shift) {
+                continue;
+            }
+            flush_raw(pos);
+            width = uint64_t{1} << shift;
+            const double a = lod.extreme(level, bucket, 0);
+            const double b = lod.extreme(level, bucket, 1);
+            stats.merge(std::min(a, b), std::max(a, b),
+                        lod.mean(level, bucket) * static_cast<double>(width),
+                        static_cast<size_t>(width));
+            raw = pos + width;
+            break;
+        }
+        pos += width > 0 ? width : 1;
+    }
+    flush_raw(end);
+    return stats;
+}
+
+DecimatedSeries::DecimatedSeries(const SignalView &view, double x_min, double x_max,
+                                 size_t max_points)
+    : view_(&view), lod_(view.lod()) {
+    if (view.empty()) {
+        return;
+    }
+
+    auto [start, count] = view.visible_range(x_min, x_max);
+    const bool evicted = view.end() > view.size();
+    if (lod_.levels() > 0 && evicted && x_min < view.time_at(0)) {
+        decimate_archive(x_min, x_max, start + count, max_points);
+        return;
+    }
+    if (count == 0) {
+        start = 0;
+        count = view.size();
+    }
+    decimate_samples(start, count, max_points);
+}
+
+void DecimatedSeries::decimate_samples(size_t start, size_t count, size_t max_points) {
+    start_ = start;
+    head_ = count;
+    if (max_points < 2 || count <= max_points || lod_.levels() == 0) {
+        return;
+    }
+
+    // Each bucket draws two points, so it must span count / (max_points / 2) samples,
+    // and the level must still hold every bucket in the range.
+    const LodLayout &layout = lod_.layout();
+    const size_t min_width = (2 * count + max_points - 1) / max_points;
+    size_t level = 0;
+    while (level + 1 < layout.levels() &&
+           ((size_t{1} << LodLayout::shift(level)) < min_width ||
+            (count >> LodLayout::shift(level)) + 2 > layout.readable(level))) {
+        ++level;
+    }
+    const unsigned shift = LodLayout::shift(level);
+
+    const uint64_t view_first = view_->end() - view_->size();
+    const uint64_t abs_start = view_first + start;
+    const uint64_t abs_end = abs_start + count;
+    const uint64_t newest = view_->end() >> shift;
+    const uint64_t oldest = newest > layout.readable(level) ? newest - layout.readable(level) : 0;
+    const uint64_t first_bucket =
+        std::max((abs_start + (uint64_t{1} << shift) - 1) >> shift, oldest);
+    const uint64_t end_bucket = abs_end >> shift;
+    if (end_bucket <= first_bucket) {
+        return;
+    }
+
+    level_ = level;
+    shift_ = shift;
+    first_bucket_ = first_bucket;
+    buckets_ = end_bucket - first_bucket;
+    head_ = static_cast<size_t>((first_bucket << shift) - abs_start);
+    tail_start_ = static_cast<size_t>((end_bucket << shift) - view_first);
+    tail_ = static_cast<size_t>(abs_end - (end_bucket << shift));
+}
+
+void DecimatedSeries::decimate_archive(double x_min, double x_max, size_t end,
+                                       size_t max_points) {
+    const uint64_t view_first = view_->end() - view_->size();
+    const LodLayout &layout = lod_.layout();
+
+    for (size_t level = 0; level < layout.levels(); ++level) {
+        const unsigned shift = LodLayout::shift(level);
+        const uint64_t newest = view_->end() >> shift; // exclusive; complete buckets only
+        const uint64_t readable = layout.readable(level);
+        const uint64_t oldest = newest > readable ? newest - readable : 0;
+        const bool coarsest = level + 1 == layout.levels();
+        if (!coarsest && oldest > 0 && lod_.first_time(level, oldest) > x_min) {
+            continue; // This level has already forgotten the start of the window.
+        }
+
+        uint64_t lo = partition_buckets(
+            oldest, newest, [&](uint64_t b) { return lod_.last_time(level, b) < x_min; });
+        uint64_t hi = partition_buckets(
+            lo, newest, [&](uint64_t b) { return lod_.first_time(level, b) <= x_max; });
+        if (lo > oldest) {
+            --lo;
+        }
+        if (hi < newest) {
+            ++hi;
+        }
+        if (!coarsest && 2 * (hi - lo) > max_points) {
+            continue;
+        }
+
+        archived_ = true;
+        level_ = level;
+        shift_ = shift;
+        first_bucket_ = lo;
+        buckets_ = hi - lo;
+        if (hi == newest) {
+            // Bridge to the newest samples with at most one bucket per finer level;
+            // the finest ends within 8 samples of the end, well inside the view.
+            uint64_t next = newest << shift; // first sample not yet drawn
+            for (size_t finer = level; finer-- > 0;) {
+                const unsigned finer_shift = LodLayout::shift(finer);
+                const uint64_t bucket = next >> finer_shift;
+                if (bucket < view_->end() >> finer_shift) {
+                    steps_.emplace_back(finer, bucket);
+                    next += uint64_t{1} << finer_shift;
+                }
+            }
+            tail_start_ = static_cast<size_t>(std::max(next, view_first) - view_first);
+            tail_ = end > tail_start_ ? end - tail_start_ : 0;
+        }
+        return;
+    }
+
+    // No level has a complete bucket yet.
+    decimate_samples(0, end, max_points);
+}
+
+size_t DecimatedSeries::raw_index(size_t i) const {
+    if (i < head_) {
+        return start_ + i;
+    }
+    return tail_start_ + (i - head_ - static_cast<size_t>(2 * (buckets_ + steps_.size())));
+}
+
+bool DecimatedSeries::bucket_at(size_t i, size_t &level, uint64_t &bucket) const {
+    if (i < head_) {
+        return false;
+    }
+    const size_t j = i - head_;
+    if (j < 2 * buckets_) {
+        level = level_;
+        bucket = first_bucket_ + j / 2;
+        return true;
+    }
+    const size_t k = j - static_cast<size_t>(2 * buckets_);
+    if (k < 2 * steps_.size()) {
+        level = steps_[k / 2].first;
+        bucket = steps_[k / 2].second;
+        return true;
+    }
+    return false;
+}
+
+double DecimatedSeries::time_at(size_t i) const {
+    size_t level = 0;
+    uint64_t bucket = 0;
+    if (!bucket_at(i, level, bucket)) {
+        return view_->time_at(raw_index(i));
+    }
+    return (i - head_) % 2 != 0 ? lod_.last_time(level, bucket) : lod_.first_time(level, bucket);
+}
+
+double DecimatedSeries::value_at(size_t i) const {
+    size_t level = 0;
+    uint64_t bucket = 0;
+    if (!bucket_at(i, level, bucket)) {
+        return view_->value_at(raw_index(i));
+    }
+    return lod_.extreme(level, bucket, (i - head_) % 2);
+}
+
+} // namespace daedalus::data
@@ -0,0 +1,225 @@
+#include "daedalus/data/signal_store.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace daedalus::data {
+
+namespace {
+
+/// Copy `n` samples into a ring of `physical` slots starting at slot `pos`.
+void copy_into_ring(double *ring, size_t physical, size_t pos, const double *src, size_t n) {
+    const size_t first = std::min(n, physical - pos);
+    std::copy_n(src, first, ring + pos);
+    std::copy_n(src + first, n - first, ring);
+}
+
+/// Cache-aligned, zero-filled array of `count` doubles.
+double *allocate_column_storage(size_t count) {
+    const std::align_val_t alignment{SignalStore::kColumnAlignment};
+    auto *data = static_cast<double *>(
+        ::operator new[](std::max<size_t>(count, 1) * sizeof(double), alignment));
+    std::fill_n(data, count, 0.0);
+    return data;
+}
+
+size_t round_to_cache_line(size_t doubles) {
+    constexpr size_t kPerLine = SignalStore::kColumnAlignment / sizeof(double);
+    return (doubles + kPerLine - 1) / kPerLine * kPerLine;
+}
+
+} // namespace
+
+StoreSnapshot::~StoreSnapshot() { release(); }
+
+StoreSnapshot::StoreSnapshot(StoreSnapshot &&other) noexcept
+    : store_(std::move(other.store_)), series_(std::move(other.series_)),
+      samples_(other.samples_) {
+    other.store_.reset();
+}
+
+StoreSnapshot &StoreSnapshot::operator=(StoreSnapshot &&other) noexcept {
+    if (this != &other) {
+        release();
+        store_ = std::move(other.store_);
+        series_ = std::move(other.series_);
+        samples_ = other.samples_;
+        other.store_.reset();
+    }
+    return *this;
+}
+
+void StoreSnapshot::release() {
+    if (store_) {
+        store_->unpin();
+        store_.reset();
+    }
+    series_.clear();
+    samples_ = 0;
+}
+
+SignalStore::SignalStore(size_t signal_count, size_t capacity, size_t guard,
+                         size_t archive_buckets)
+    : SignalStore(signal_count, StoreGeometry{capacity, guard, archive_buckets, 0}) {}
+
+SignalStore::SignalStore(size_t signal_count, const StoreGeometry &geometry)
+    : signal_count_(signal_count), capacity_(std::max<size_t>(geometry.capacity, 1)),
+      guard_(std::max<size_t>(geometry.guard, 1)), physical_(capacity_ + guard_),
+      times_(allocate_column_storage(round_to_cache_line(physical_))),
+      lod_layout_(capacity_, guard_, geometry.archive_buckets),
+      lod_stride_(round_to_cache_line(lod_layout_.column_doubles())),
+      lod_storage_(allocate_column_storage((signal_count_ + 1) * lod_stride_)),
+      columns_(std::make_unique<Column[]>(signal_count_)) {
+    const size_t initial = geometry.column_capacity == 0
+                               ? capacity_
+                               : std::clamp(geometry.column_capacity,
+                                            std::min(kMinColumnCapacity, capacity_), capacity_);
+    for (size_t s = 0; s < signal_count_; ++s) {
+        const size_t physical = round_to_cache_line(initial + guard_);
+        Column &column = columns_[s];
+        column.owner = std::make_unique<ValueRing>(
+            ValueRing{initial, physical, 0, AlignedArray(allocate_column_storage(physical))});
+        column.ring.store(column.owner.get(), std::memory_order_relaxed);
+        column.capacity.store(initial, std::memory_order_relaxed);
+    }
+}
+
+void SignalStore::set_column_capacity(size_t signal, size_t capacity) {
+    if (signal >= signal_count_) {
+        return;
+    }
+    const size_t clamped = std::clamp(capacity, std::min(kMinColumnCapacity, capacity_), capacity_);
+    columns_[signal].requested.store(clamped, std::memory_order_release);
+}
+
+size_t SignalStore::column_bytes(size_t signal) const {
+    return (round_to_cache_line(column_capacity(signal) + guard_) + lod_stride_) * sizeof(double);
+}
+
+size_t SignalStore::fixed_bytes() const {
+    size_t bytes = memory_bytes();
+    for (size_t s = 0; s < signal_count_; ++s) {
+        bytes -= column_capacity(s) * sizeof(double);
+    }
+    return bytes;
+}
+
+size_t SignalStore::memory_bytes() const {
+    size_t bytes = (round_to_cache_line(physical_) + lod_stride_) * sizeof(double);
+    for (size_t s = 0; s < signal_count_; ++s) {
+        bytes += column_bytes(s);
+    }
+    return bytes;
+}
+
+void SignalStore::apply_capacity_requests(uint64_t written) {
+    reclaim_retired();
+    for (size_t s = 0; s < signal_count_; ++s) {
+        Column &column = columns_[s];
+        const size_t requested = column.requested.exchange(0, std::memory_order_acquire);
+        if (requested == 0 || requested == column.capacity.load(std::memory_order_relaxed)) {
+            continue;
+        }
+
+        // Carry over the newest samples both rings can hold. The old ring is left
+        // untouched, so a snapshot still reading it stays consistent.
+        const ValueRing *old = column.owner.get();
+        const size_t physical = round_to_cache_line(requested + guard_);
+        const size_t keep = static_cast<size_t>(
+            std::min<uint64_t>({written - old->first_valid, old->physical, physical}));
+        auto ring = std::make_unique<ValueRing>(ValueRing{
+            requested, physical, written - keep, AlignedArray(allocate_column_storage(physical))});
+        for (uint64_t i = written - keep; i < written; ++i) {
+            ring->data[i % physical] = old->data[i % old->physical];
+        }
+        column.ring.store(ring.get(), std::memory_order_seq_cst);
+        column.capacity.store(requested, std::memory_order_relaxed);
+
+        // An even epoch means no snapshot was between pin and unpin, and any later
+        // one loads the new ring. Otherwise wait for that snapshot to be released.
+        retired_.push_back({reader_epoch_.load(std::memory_order_seq_cst),
+                            std::exchange(column.owner, std::move(ring))});
+    }
+    reclaim_retired();
+}
+
+void SignalStore::reclaim_retired() {
+    const uint64_t epoch = reader_epoch_.load(std::memory_order_seq_cst);
+    std::erase_if(retired_, [epoch](const RetiredRing &retired) {
+        return retired.epoch % 2 == 0 || epoch > retired.epoch;
+    });
+}
+
+size_t SignalStore::append_rows(const FrameBatch &batch, size_t first_row) {
+    if (batch.signal_count != signal_count_ || first_row >= batch.rows) {
+        return 0;
+    }
+
+    const uint64_t written = samples_.load(std::memory_order_relaxed);
+    apply_capacity_requests(written);
+
+    // A chunk never exceeds the guard band, so even a chunk already in flight when
+    // the reader pins cannot reach the samples that snapshot sees.
+    const uint64_t pin = pin_.load(std::memory_order_seq_cst);
+    uint64_t allowed = guard_;
+    if (pin != kUnpinned) {
+        allowed = pin + guard_ > written ? pin + guard_ - written : 0;
+    }
+    const size_t rows = static_cast<size_t>(std::min<uint64_t>(batch.rows - first_row, allowed));
+    if (rows == 0) {
+        return 0;
+    }
+
+    // FrameBatch is already columnar, so each column is one or two straight copies.
+    const double *times = batch.time_column().data() + first_row;
+    copy_into_ring(times_.get(), physical_, static_cast<size_t>(written % physical_), times, rows);
+    lod_update(lod_column(0), lod_layout_, times_.get(), physical_, written, written + rows);
+    for (size_t s = 0; s < signal_count_; ++s) {
+        Column &column = columns_[s];
+        const ValueRing *ring = column.owner.get();
+        const double *values = batch.column(s).data() + first_row;
+        copy_into_ring(ring->data.get(), ring->physical,
+                       static_cast<size_t>(written % ring->physical), values, rows);
+        lod_update(lod_column(s + 1), lod_layout_, ring->data.get(), ring->physical, written,
+                   written + rows);
+
+        uint64_t changes = 0;
+        double last = column.last_value;
+        for (size_t r = 0; r < rows; ++r) {
+            changes += values[r] != last ? 1 : 0;
+            last = values[r];
+        }
+        column.last_value = last;
+        column.changes.fetch_add(changes, std::memory_order_relaxed);
+    }
+    samples_.store(written + rows, std::memory_order_seq_cst);
+    return rows;
+}
+
+StoreSnapshot SignalStore::snapshot() {
+    // Enter the read epoch before loading any ring, so the writer keeps every ring
+    // this snapshot sees until unpin().
+    reader_epoch_.fetch_add(1, std::memory_order_seq_cst);
+
+    // Pin before reading the final count: the writer then stays within guard_ rows
+    // of `end` (see append_rows()).
+    pin_.store(samples_.load(std::memory_order_acquire), std::memory_order_seq_cst);
+    const uint64_t end = samples_.load(std::memory_order_seq_cst);
+
+    StoreSnapshot snap;
+    snap.store_ = shared_from_this();
+    snap.samples_ = end;
+    snap.series_.reserve(signal_count_);
+    for (size_t s = 0; s < signal_count_; ++s) {
+        const ValueRing *ring = columns_[s].ring.load(std::memory_order_seq_cst);
+        const uint64_t valid = end > ring->first_valid ? end - ring->first_valid : 0;
+        const size_t count =
+            static_cast<size_t>(std::min<uint64_t>({end, ring->capacity, valid}));
+        const LodColumn lod(lod_column(0), lod_column(s + 1), &lod_layout_);
+        snap.series_.push_back(SignalView(times_.get(), physical_, ring->data.get(),
+                                          ring->physical, end - count, count, lod));
+    }
+    return snap;
+}
+
+} // namespace daedalus::data
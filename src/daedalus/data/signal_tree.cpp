@@ -1,62 +1,120 @@
 #include "daedalus/data/signal_tree.hpp"
 
 #include <algorithm>
-#include <sstream>
+#include <bit>
+#include <cctype>
+#include <functional>
+#include <utility>
 
 namespace daedalus::data {
 
-SignalTreeNode *SignalTreeNode::find_child(const std::string &child_name) const {
-    for (auto &child : children) {
-        if (child->name == child_name) {
-            return child.get();
-        }
-    }
-    return nullptr;
+namespace {
+
+[[nodiscard]] std::string to_lower_ascii(std::string_view input) {
+    std::string lowered(input);
+    std::transform(lowered.begin(), lowered.end(), lowered.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return lowered;
 }
 
+} // namespace
+
+SignalTree::SignalTree() { clear(); }
+
 void SignalTree::build_from_schema(const protocol::Schema &schema) {
+    // Keep the browser's open groups open across schema updates.
+    std::vector<std::string> expanded_paths;
+    for (const SignalTreeNode *node : nodes_) {
+        if (expanded_[node->preorder] && node->preorder != 0) {
+            expanded_paths.emplace_back(node->full_path);
+        }
+    }
+
     clear();
-    root_.name = "<root>";
 
-    for (auto &mod : schema.modules) {
-        for (auto &sig : mod.signals) {
+    // The path buffer is sized exactly. Every signal and module is at least one
+    // node, so the arena and hash table start there and grow if groups need more.
+    size_t path_bytes = 0;
+    size_t min_nodes = 1 + schema.modules.size();
+    for (const auto &mod : schema.modules) {
+        for (const auto &sig : mod.signals) {
+            path_bytes += mod.name.size() + 1 + sig.name.size();
+        }
+        min_nodes += mod.signals.size();
+    }
+    paths_.resize(path_bytes);
+    arena_.reserve_blocks(min_nodes);
+    rehash(min_nodes);
+    std::vector<uint32_t> parents{kNoNode};
+    parents.reserve(min_nodes);
+
+    char *out = paths_.data();
+    for (const auto &mod : schema.modules) {
+        for (const auto &sig : mod.signals) {
             // Full path: "module.signal_name"
-            std::string full_path = mod.name + "." + sig.name;
-            auto &node = ensure_path(full_path);
-            node.is_leaf = true;
+            const std::string_view path(out, mod.name.size() + 1 + sig.name.size());
+            out = std::copy(mod.name.begin(), mod.name.end(), out);
+            *out++ = '.';
+            out = std::copy(sig.name.begin(), sig.name.end(), out);
+
+            // Walk the prefixes ending at each dot, creating the nodes that are new.
+            uint32_t parent = 0;
+            size_t begin = 0;
+            for (;;) {
+                if (2 * (arena_.size() + 1) > path_slots_.size()) {
+                    rehash(path_slots_.size()); // keep the table at most half full
+                }
+                const size_t dot = path.find('.', begin);
+                const std::string_view prefix = path.substr(0, dot);
+                uint32_t &slot = path_slot(prefix);
+                if (slot == kNoNode) {
+                    slot = static_cast<uint32_t>(arena_.size());
+                    SignalTreeNode &node = arena_.emplace_back();
+                    node.full_path = prefix;
+                    node.name = prefix.substr(begin);
+                    parents.push_back(parent);
+                }
+                parent = slot;
+                if (dot == std::string_view::npos) {
+                    break;
+                }
+                begin = dot + 1;
+            }
+            arena_[parent].is_leaf = true;
         }
     }
+    link_children(parents);
+    index_nodes();
+    for (const auto &path : expanded_paths) {
+        if (const uint32_t index = find_index(path); index != kNoNode) {
+            expanded_[arena_[index].preorder] = true;
+        }
+    }
+    apply_filter(false);
 }
 
 void SignalTree::update_subscription(const protocol::SubscribeAck &ack) {
-    for (auto &entry : path_index_) {
-        SignalTreeNode *node = entry.second;
-        if (node->is_leaf) {
-            node->signal_index.reset();
-        }
+    for (size_t i = 0; i < arena_.size(); ++i) {
+        arena_[i].signal_index.reset();
     }
 
     for (size_t i = 0; i < ack.signals.size(); ++i) {
-        auto it = path_index_.find(ack.signals[i]);
-        if (it != path_index_.end()) {
-            it->second->signal_index = i;
+        if (const uint32_t index = find_index(ack.signals[i]); index != kNoNode) {
+            arena_[index].signal_index = i;
         }
     }
 }
 
-const SignalTreeNode *SignalTree::find(const std::string &path) const {
-    auto it = path_index_.find(path);
-    if (it != path_index_.end()) {
-        return it->second;
-    }
-    return nullptr;
+const SignalTreeNode *SignalTree::find(std::string_view path) const {
+    const uint32_t index = find_index(path);
+    return index != kNoNode ? &arena_[index] : nullptr;
 }
 
 std::vector<std::string> SignalTree::all_signals() const {
     std::vector<std::string> result;
-    for (auto &[path, node] : path_index_) {
-        if (node->is_leaf) {
-            result.push_back(path);
+    for (size_t i = 0; i < arena_.size(); ++i) {
+        if (arena_[i].is_leaf) {
+            result.emplace_back(arena_[i].full_path);
         }
     }
     std::sort(result.begin(), result.end());
@@ -64,38 +122,172 @@ std::vector<std::string> SignalTree::all_signals() const {
 }
 
 void SignalTree::clear() {
-    root_.children.clear();
-    root_.full_path.clear();
-    root_.is_leaf = false;
-    root_.signal_index.reset();
-    path_index_.clear();
-}
-
-SignalTreeNode &SignalTree::ensure_path(const std::string &full_path) {
-    SignalTreeNode *current = &root_;
-    std::istringstream stream(full_path);
-    std::string segment;
-    std::string built_path;
-
-    while (std::getline(stream, segment, '.')) {
-        if (!built_path.empty()) {
-            built_path += ".";
+    // Fresh vectors, so a cleared tree gives its memory back.
+    paths_ = {};
+    arena_.clear();
+    arena_.emplace_back().name = "<root>";
+    child_slots_ = {};
+    rehash(1);
+    index_nodes();
+    apply_filter(false);
+}
+
+bool SignalTree::set_filter(std::string_view text) {
+    if (text == filter_text_) {
+        return false;
+    }
+    std::string lowered = to_lower_ascii(text);
+    const bool narrowing = !filter_.empty() && lowered.find(filter_) != std::string::npos;
+    filter_text_ = std::string(text);
+    if (lowered == filter_) {
+        return false; // only the case changed
+    }
+    filter_ = std::move(lowered);
+    apply_filter(narrowing);
+    return true;
+}
+
+void SignalTree::set_expanded(const SignalTreeNode &node, bool expanded) {
+    if (expanded_[node.preorder] != expanded) {
+        expanded_[node.preorder] = expanded;
+        rows_dirty_ = true;
+    }
+}
+
+void SignalTree::set_all_expanded(bool expanded) {
+    for (const SignalTreeNode *node : nodes_) {
+        expanded_[node->preorder] = expanded && !node->is_leaf;
+    }
+    rows_dirty_ = true;
+}
+
+const std::vector<SignalTreeRow> &SignalTree::rows() {
+    if (rows_dirty_) {
+        rebuild_rows();
+        rows_dirty_ = false;
+    }
+    return rows_;
+}
+
+void SignalTree::rebuild_rows() {
+    rows_.clear();
+    // Same walk as index_nodes(), pruned at hidden and collapsed nodes.
+    std::vector<SignalTreeRow> stack;
+    const auto &top = arena_.front().children;
+    for (auto it = top.rbegin(); it != top.rend(); ++it) {
+        stack.push_back({*it, 0});
+    }
+    while (!stack.empty()) {
+        const SignalTreeRow row = stack.back();
+        stack.pop_back();
+        if (!visible(*row.node)) {
+            continue;
+        }
+        rows_.push_back(row);
+        if (!expanded_[row.node->preorder]) {
+            continue;
+        }
+        for (auto it = row.node->children.rbegin(); it != row.node->children.rend(); ++it) {
+            stack.push_back({*it, row.depth + 1});
+        }
+    }
+}
+
+void SignalTree::index_nodes() {
+    nodes_.clear();
+    parents_.clear();
+    nodes_.reserve(arena_.size());
+    parents_.reserve(arena_.size());
+    lowered_.resize(paths_.size());
+    std::transform(paths_.begin(), paths_.end(), lowered_.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    // Iterative preorder walk; children are pushed in reverse to keep their order.
+    std::vector<std::pair<SignalTreeNode *, size_t>> stack{{&arena_[0], 0}};
+    while (!stack.empty()) {
+        auto [node, parent] = stack.back();
+        stack.pop_back();
+        node->preorder = nodes_.size();
+        nodes_.push_back(node);
+        parents_.push_back(parent);
+        for (auto it = node->children.rbegin(); it != node->children.rend(); ++it) {
+            stack.emplace_back(*it, node->preorder);
+        }
+    }
+    matches_.assign(nodes_.size(), false);
+    visible_.assign(nodes_.size(), false);
+    expanded_.assign(nodes_.size(), false);
+    rows_dirty_ = true;
+}
+
+void SignalTree::apply_filter(bool narrowing) {
+    rows_dirty_ = true;
+    if (filter_.empty()) {
+        return; // visible() short-circuits
+    }
+    for (size_t i = 1; i < nodes_.size(); ++i) { // the root has no path
+        // A narrower filter can only match paths the previous one matched.
+        if (!narrowing || matches_[i]) {
+            matches_[i] = lowered_path(*nodes_[i]).find(filter_) != std::string_view::npos;
+        }
+    }
+    // Children follow their parent in preorder, so a reverse pass sees every
+    // descendant of a node before the node itself.
+    visible_.assign(nodes_.size(), false);
+    for (size_t i = nodes_.size(); i-- > 1;) {
+        if (matches_[i] || visible_[i]) {
+            visible_[i] = true;
+            visible_[parents_[i]] = true;
         }
-        built_path += segment;
-
-        auto *child = current->find_child(segment);
-        if (child == nullptr) {
-            auto new_node = std::make_unique<SignalTreeNode>();
-            new_node->name = segment;
-            new_node->full_path = built_path;
-            child = new_node.get();
-            current->children.push_back(std::move(new_node));
+    }
+}
+
+uint32_t &SignalTree::path_slot(std::string_view path) {
+    const size_t mask = path_slots_.size() - 1;
+    for (size_t i = std::hash<std::string_view>{}(path) & mask;; i = (i + 1) & mask) {
+        uint32_t &slot = path_slots_[i];
+        if (slot == kNoNode || arena_[slot].full_path == path) {
+            return slot;
+        }
+    }
+}
+
+uint32_t SignalTree::find_index(std::string_view path) const {
+    const size_t mask = path_slots_.size() - 1;
+    for (size_t i = std::hash<std::string_view>{}(path) & mask;; i = (i + 1) & mask) {
+        const uint32_t slot = path_slots_[i];
+        if (slot == kNoNode || arena_[slot].full_path == path) {
+            return slot;
         }
-        path_index_[built_path] = child;
-        current = child;
     }
+}
 
-    return *current;
+void SignalTree::rehash(size_t nodes) {
+    // At most half full, so probes stay short and always reach an empty slot.
+    path_slots_.assign(std::bit_ceil(std::max<size_t>(2 * nodes, 2)), kNoNode);
+    for (size_t i = 1; i < arena_.size(); ++i) {
+        path_slot(arena_[i].full_path) = static_cast<uint32_t>(i);
+    }
+}
+
+void SignalTree::link_children(const std::vector<uint32_t> &parents) {
+    // Counting sort by parent. Siblings keep creation order, which is schema order.
+    std::vector<uint32_t> offsets(arena_.size() + 1, 0);
+    for (size_t i = 1; i < arena_.size(); ++i) {
+        ++offsets[parents[i] + 1];
+    }
+    for (size_t i = 1; i < offsets.size(); ++i) {
+        offsets[i] += offsets[i - 1];
+    }
+    child_slots_.resize(arena_.size() - 1);
+    for (size_t i = 1; i < arena_.size(); ++i) {
+        child_slots_[offsets[parents[i]]++] = &arena_[i];
+    }
+    // Each offset now marks the end of its run; the previous one marks the start.
+    for (size_t i = 0; i < arena_.size(); ++i) {
+        const uint32_t begin = i == 0 ? 0 : offsets[i - 1];
+        arena_[i].children = {child_slots_.data() + begin, offsets[i] - begin};
+    }
 }
 
 } // namespace daedalus::data
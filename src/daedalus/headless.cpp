@@ -0,0 +1,238 @@
+#include "daedalus/headless.hpp"
+
+#include "daedalus/protocol/client.hpp"
+#include "daedalus/record/session_recorder.hpp"
+#include "daedalus/record/session_replay.hpp"
+
+#include <csignal>
+#include <cstdio>
+#include <thread>
+#include <utility>
+#include <variant>
+
+namespace daedalus {
+
+namespace {
+
+/// How often run_headless() handles control events and checks for the end.
+constexpr std::chrono::milliseconds kPollInterval{10};
+
+volatile std::sig_atomic_t g_interrupted = 0;
+
+extern "C" void on_interrupt(int /*signal*/) { g_interrupted = 1; }
+
+double to_ms(std::chrono::nanoseconds duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+/// One progress line: rates over the interval since `before`, latency and drops so far.
+void print_progress(const HeadlessReport &now, const HeadlessReport &before) {
+    const double dt = now.seconds - before.seconds;
+    if (dt <= 0.0) {
+        return;
+    }
+    std::printf("[Daedalus] %7.1f s: %9.0f frames/s %8.2f M samples/s | latency p50 %.3f ms "
+                "p99 %.3f ms | dropped %llu, gaps %llu\n",
+                now.seconds, static_cast<double>(now.frames - before.frames) / dt,
+                static_cast<double>(now.samples - before.samples) / dt / 1e6,
+                to_ms(now.latency_p50), to_ms(now.latency_p99),
+                static_cast<unsigned long long>(now.frames_dropped),
+                static_cast<unsigned long long>(now.gaps));
+    std::fflush(stdout);
+}
+
+void print_summary(const HeadlessReport &report,
+                   const std::shared_ptr<record::SessionRecorder> &recorder) {
+    const double seconds = report.seconds > 0.0 ? report.seconds : 1.0;
+    std::printf("[Daedalus] Headless run: %.1f s\n", report.seconds);
+    std::printf("  frames          %llu (%.0f/s)\n", static_cast<unsigned long long>(report.frames),
+                static_cast<double>(report.frames) / seconds);
+    std::printf("  samples         %llu (%.2f M/s)\n",
+                static_cast<unsigned long long>(report.samples),
+                static_cast<double>(report.samples) / seconds / 1e6);
+    std::printf("  ingest latency  p50 %.3f ms, p99 %.3f ms, max %.3f ms (%llu batches)\n",
+                to_ms(report.latency_p50), to_ms(report.latency_p99), to_ms(report.latency_max),
+                static_cast<unsigned long long>(report.latency_count));
+    std::printf("  dropped         %llu frames (queue overflow), %llu rows discarded, "
+                "%llu frames rejected\n",
+                static_cast<unsigned long long>(report.frames_dropped),
+                static_cast<unsigned long long>(report.rows_discarded),
+                static_cast<unsigned long long>(report.frames_rejected));
+    std::printf("  upstream gaps   %llu (%llu frames missing)\n",
+                static_cast<unsigned long long>(report.gaps),
+                static_cast<unsigned long long>(report.missing_frames));
+    if (recorder) {
+        const auto stats = recorder->stats();
+        std::printf("  recorded        %s: %llu records, %.1f MB, %llu dropped%s\n",
+                    recorder->path().c_str(), static_cast<unsigned long long>(stats.records),
+                    static_cast<double>(stats.bytes_written) / (1024.0 * 1024.0),
+                    static_cast<unsigned long long>(stats.dropped),
+                    stats.failed ? ", write failed" : "");
+    }
+}
+
+} // namespace
+
+HeadlessSession::HeadlessSession(protocol::TelemetrySource &source, data::HistoryBudget budget)
+    : source_(source), budget_(budget), ingest_(source.telemetry_queue(), source.batch_pool()),
+      started_at_(std::chrono::steady_clock::now()) {
+    ingest_.set_idle_hook([&source] { source.publish_stale(); });
+}
+
+HeadlessSession::~HeadlessSession() { stop(); }
+
+void HeadlessSession::start() {
+    started_at_ = std::chrono::steady_clock::now();
+    ingest_.start();
+    source_.connect();
+}
+
+void HeadlessSession::stop() {
+    if (!ingest_.running()) {
+        return;
+    }
+    source_.disconnect();
+    poll();
+    ingest_.stop();
+}
+
+void HeadlessSession::poll() {
+    protocol::ControlEvent event;
+    while (source_.event_queue().try_pop(event)) {
+        if (const auto *schema = std::get_if<protocol::Schema>(&event)) {
+            std::printf("[Daedalus] Schema received: %zu modules\n", schema->modules.size());
+            source_.subscribe({"*"});
+        } else if (const auto *ack = std::get_if<protocol::SubscribeAck>(&event)) {
+            store_ = std::make_shared<data::SignalStore>(ack->signals.size(),
+                                                         budget_.plan(ack->signals.size()));
+            ingest_.set_store(store_);
+            std::printf("[Daedalus] Subscribed to %u signals (history %zu MB of %zu MB)\n",
+                        ack->count, store_->memory_bytes() >> 20, budget_.budget_bytes() >> 20);
+            source_.resume();
+        } else if (const auto *error = std::get_if<protocol::ServerError>(&event)) {
+            std::fprintf(stderr, "[Daedalus] Error: %s\n", error->message.c_str());
+        } else if (const auto *failure = std::get_if<protocol::ParseFailure>(&event)) {
+            std::fprintf(stderr, "[Daedalus] Failed to parse event: %s\n",
+                         failure->reason.c_str());
+        } else if (const auto *change = std::get_if<protocol::StateChange>(&event)) {
+            if (change->state == protocol::ConnectionState::Error) {
+                std::fprintf(stderr, "[Daedalus] Connection: error (%s)\n",
+                             change->reason.c_str());
+            } else if (change->state == protocol::ConnectionState::Disconnected) {
+                store_.reset();
+                ingest_.set_store(nullptr);
+            }
+        }
+    }
+}
+
+HeadlessReport HeadlessSession::report() const {
+    HeadlessReport report;
+    report.seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - started_at_).count();
+    report.frames = ingest_.rows_ingested();
+    report.samples = ingest_.samples_ingested();
+    const auto &latency = ingest_.ingest_latency();
+    report.latency_count = latency.count();
+    report.latency_p50 = latency.quantile(0.50);
+    report.latency_p99 = latency.quantile(0.99);
+    report.latency_max = latency.max();
+    report.frames_dropped = source_.telemetry_queue().stats().dropped;
+    report.rows_discarded = ingest_.rows_discarded();
+    report.frames_rejected = source_.batcher().frames_rejected();
+    const auto health = source_.stream_health();
+    report.gaps = health.gaps;
+    report.missing_frames = health.missing_frames;
+    return report;
+}
+
+bool HeadlessSession::drained(uint64_t frames_delivered) const {
+    return source_.telemetry_queue().size_approx() == 0 &&
+           ingest_.rows_ingested() + ingest_.rows_discarded() >= frames_delivered;
+}
+
+int run_headless(const LaunchOptions &options) {
+    std::unique_ptr<protocol::TelemetrySource> source;
+    protocol::HermesClient *client = nullptr;
+    record::SessionReplay *replay = nullptr;
+    if (!options.replay_path.empty()) {
+        auto playback =
+            std::make_unique<record::SessionReplay>(options.replay_path, options.replay_speed);
+        replay = playback.get();
+        source = std::move(playback);
+    } else {
+        auto live = std::make_unique<protocol::HermesClient>(options.url);
+        live->set_telemetry_encoding(options.encoding);
+        client = live.get();
+        source = std::move(live);
+    }
+
+    std::shared_ptr<record::SessionRecorder> recorder;
+    if (!options.record_path.empty()) {
+        if (client == nullptr) {
+            std::fprintf(stderr, "[Daedalus] --record applies to live streams; ignoring\n");
+        } else {
+            recorder = std::make_shared<record::SessionRecorder>();
+            if (!recorder->start(options.record_path)) {
+                return 1;
+            }
+            client->set_recorder(recorder);
+            std::printf("[Daedalus] Recording to %s\n", options.record_path.c_str());
+        }
+    }
+
+    HeadlessSession session(*source, options.history_bytes > 0
+                                         ? data::HistoryBudget(options.history_bytes)
+                                         : data::HistoryBudget{});
+    g_interrupted = 0;
+    std::signal(SIGINT, on_interrupt);
+    std::signal(SIGTERM, on_interrupt);
+
+    using Clock = std::chrono::steady_clock;
+    const auto interval = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(options.report_interval_s > 0.0 ? options.report_interval_s
+                                                                       : 1.0));
+    const auto deadline =
+        options.duration_s > 0.0
+            ? Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                 std::chrono::duration<double>(options.duration_s))
+            : Clock::time_point::max();
+    auto next_report = Clock::now() + interval;
+
+    session.start();
+    auto last_report = session.report();
+    bool failed = false;
+    while (g_interrupted == 0 && Clock::now() < deadline) {
+        session.poll();
+        // The live client reconnects by itself; a replay that cannot be read will not
+        if (replay != nullptr && source->state() == protocol::ConnectionState::Error) {
+            failed = true;
+            break;
+        }
+        if (replay != nullptr && replay->finished() && session.drained(replay->frames_played())) {
+            break;
+        }
+        if (Clock::now() >= next_report) {
+            const auto report = session.report();
+            print_progress(report, last_report);
+            last_report = report;
+            next_report += interval;
+        }
+        std::this_thread::sleep_for(kPollInterval);
+    }
+
+    if (client != nullptr) {
+        client->set_recorder(nullptr);
+    }
+    const auto report = session.report();
+    session.stop();
+    if (recorder) {
+        recorder->stop();
+    }
+    print_summary(report, recorder);
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+    return failed ? 1 : 0;
+}
+
+} // namespace daedalus
@@ -0,0 +1,105 @@
+#include "daedalus/launch_options.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace daedalus {
+
+namespace {
+
+/// The whole of `text` as a finite number, or nothing.
+std::optional<double> parse_number(const std::string &text) {
+    char *end = nullptr;
+    const double value = std::strtod(text.c_str(), &end);
+    if (text.empty() || end != text.c_str() + text.size() || !std::isfinite(value)) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+std::optional<protocol::TelemetryEncoding> parse_encoding(std::string_view name) {
+    if (name == "xor") {
+        return protocol::TelemetryEncoding::Xor;
+    }
+    if (name == "plain") {
+        return protocol::TelemetryEncoding::Plain;
+    }
+    return std::nullopt;
+}
+
+/// A replay speed: a positive multiple, or "max" (0, unpaced).
+std::optional<double> parse_speed(const std::string &text) {
+    if (text == "max") {
+        return 0.0;
+    }
+    const auto speed = parse_number(text);
+    return speed && *speed > 0.0 ? speed : std::nullopt;
+}
+
+} // namespace
+
+LaunchOptions parse_launch_options(int argc, const char *const argv[]) {
+    LaunchOptions options;
+    if (const char *budget_mb = std::getenv("DAEDALUS_HISTORY_MB")) {
+        options.history_bytes = static_cast<size_t>(std::strtoull(budget_mb, nullptr, 10)) << 20;
+    }
+    if (const char *encoding = std::getenv("DAEDALUS_TELEMETRY_ENCODING")) {
+        if (const auto parsed = parse_encoding(encoding)) {
+            options.encoding = *parsed;
+        } else {
+            options.unknown.push_back(std::string("DAEDALUS_TELEMETRY_ENCODING=") + encoding);
+        }
+    }
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "--headless") {
+            options.headless = true;
+        } else if (arg == "--help" || arg == "-h") {
+            options.help = true;
+        } else if (arg == "--url" && has_value) {
+            options.url = argv[++i];
+        } else if (arg == "--encoding" && has_value) {
+            const std::string value = argv[++i];
+            if (const auto encoding = parse_encoding(value)) {
+                options.encoding = *encoding;
+            } else {
+                options.unknown.push_back(std::string(arg) + " " + value);
+            }
+        } else if (arg == "--replay" && has_value) {
+            options.replay_path = argv[++i];
+        } else if (arg == "--speed" && has_value) {
+            const std::string value = argv[++i];
+            if (const auto speed = parse_speed(value)) {
+                options.replay_speed = *speed;
+            } else {
+                options.unknown.push_back(std::string(arg) + " " + value);
+            }
+        } else if (arg == "--record" && has_value) {
+            options.record_path = argv[++i];
+        } else if (arg == "--duration" && has_value) {
+            const std::string value = argv[++i];
+            if (const auto seconds = parse_number(value); seconds && *seconds >= 0.0) {
+                options.duration_s = *seconds;
+            } else {
+                options.unknown.push_back(std::string(arg) + " " + value);
+            }
+        } else if (arg == "--interval" && has_value) {
+            const std::string value = argv[++i];
+            if (const auto seconds = parse_number(value); seconds && *seconds > 0.0) {
+                options.report_interval_s = *seconds;
+            } else {
+                options.unknown.push_back(std::string(arg) + " " + value);
+            }
+        } else {
+            options.unknown.emplace_back(arg);
+        }
+    }
+    return options;
+}
+
+} // namespace daedalus
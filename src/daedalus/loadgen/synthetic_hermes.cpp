@@ -0,0 +1,241 @@
+#include "daedalus/loadgen/synthetic_hermes.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <tuple>
+#include <utility>
+
+namespace daedalus::loadgen {
+
+namespace {
+
+/// A port on `host` that nothing listens on right now, or 0.
+int free_port(const std::string &host) {
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return 0;
+    }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = 0;
+    ::inet_pton(AF_INET, host.c_str(), &addr.sin_addr);
+    socklen_t length = sizeof(addr);
+    int port = 0;
+    if (::bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0 &&
+        ::getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &length) == 0) {
+        port = ntohs(addr.sin_port);
+    }
+    ::close(fd);
+    return port;
+}
+
+std::string error_json(const std::string &message) {
+    return nlohmann::json{{"type", "error"}, {"message", message}}.dump();
+}
+
+} // namespace
+
+SyntheticHermes::SyntheticHermes(const LoadProfile &profile, int port, std::string host)
+    : profile_(profile), port_(port), host_(std::move(host)), rate_hz_(profile.rate_hz) {}
+
+SyntheticHermes::~SyntheticHermes() { stop(); }
+
+bool SyntheticHermes::start() {
+    if (running()) {
+        return true;
+    }
+    // A free port can be taken by someone else before the server binds it, so a
+    // picked port that fails to listen is replaced by a fresh one.
+    const bool pick_port = port_ == 0;
+    int port = port_;
+    std::string error;
+    for (int attempt = 0; attempt < (pick_port ? kPortAttempts : 1); ++attempt) {
+        if (pick_port) {
+            port = free_port(host_);
+        }
+        server_ = std::make_unique<ix::WebSocketServer>(port, host_);
+        server_->disablePerMessageDeflate();
+        server_->setOnClientMessageCallback(
+            [this](const std::shared_ptr<ix::ConnectionState> & /*state*/, ix::WebSocket &socket,
+                   const ix::WebSocketMessagePtr &msg) { on_message(socket, msg); });
+        bool listening = false;
+        std::tie(listening, error) = server_->listen();
+        if (listening) {
+            break;
+        }
+        server_.reset();
+    }
+    if (!server_) {
+        std::fprintf(stderr, "[Daedalus] Synthetic Hermes cannot listen on %s:%d: %s\n",
+                     host_.c_str(), port, error.c_str());
+        return false;
+    }
+    port_ = port;
+    server_->start();
+    thread_ = std::jthread([this](std::stop_token stop) { run(stop); });
+    return true;
+}
+
+void SyntheticHermes::stop() {
+    if (thread_.joinable()) {
+        thread_.request_stop();
+        thread_.join();
+    }
+    if (server_) {
+        server_->stop();
+        server_.reset();
+    }
+    std::lock_guard lock(clients_mutex_);
+    clients_.clear();
+}
+
+std::string SyntheticHermes::url() const {
+    return "ws://" + host_ + ":" + std::to_string(port_);
+}
+
+size_t SyntheticHermes::clients() const {
+    std::lock_guard lock(clients_mutex_);
+    return clients_.size();
+}
+
+bool SyntheticHermes::wait_for_frames(uint64_t frames, std::chrono::milliseconds timeout) const {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (frames_sent() < frames) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+void SyntheticHermes::on_message(ix::WebSocket &socket, const ix::WebSocketMessagePtr &msg) {
+    std::lock_guard lock(clients_mutex_);
+    switch (msg->type) {
+    case ix::WebSocketMessageType::Open: {
+        // Like Hermes: the layout first, frames only once subscribed and resumed
+        auto &client = clients_.insert_or_assign(&socket, Client{SyntheticLoad(profile_)})
+                           .first->second;
+        socket.sendText(client.load.schema_json());
+        break;
+    }
+    case ix::WebSocketMessageType::Close:
+        clients_.erase(&socket);
+        break;
+    case ix::WebSocketMessageType::Message: {
+        const auto it = clients_.find(&socket);
+        if (it == clients_.end() || msg->binary) {
+            break;
+        }
+        auto &client = it->second;
+        const auto command = nlohmann::json::parse(msg->str, nullptr, false);
+        const std::string action =
+            command.is_object() ? command.value("action", std::string{}) : std::string{};
+        if (action == "subscribe") {
+            std::vector<std::string> patterns;
+            if (command.contains("params") && command["params"].contains("signals")) {
+                for (const auto &pattern : command["params"]["signals"]) {
+                    if (pattern.is_string()) {
+                        patterns.push_back(pattern.get<std::string>());
+                    }
+                }
+            }
+            // Frames of the new layout wait for the next resume
+            client.streaming = false;
+            socket.sendText(client.load.subscribe(patterns));
+        } else if (action == "resume") {
+            client.streaming = true;
+        } else if (action == "pause") {
+            client.streaming = false;
+        } else {
+            socket.sendText(error_json("Unsupported command: " + msg->str));
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void SyntheticHermes::run(const std::stop_token &stop) {
+    using Clock = std::chrono::steady_clock;
+    const uint64_t group = std::max<uint32_t>(profile_.burst_frames, 1);
+    // Frames are due `ticks` frame periods after `base`, a burst group at a time.
+    auto base = Clock::now();
+    uint64_t ticks = 0;
+    double rate = rate_hz_.load(std::memory_order_relaxed);
+    // Restart the schedule from now, so idle time or a burst is not made up for
+    const auto rebase = [&] {
+        base = Clock::now();
+        ticks = 0;
+        rate = rate_hz_.load(std::memory_order_relaxed);
+    };
+
+    while (!stop.stop_requested()) {
+        if (rate_hz_.load(std::memory_order_relaxed) != rate) {
+            rebase();
+        }
+        const bool bursting = burst_pending_.load(std::memory_order_relaxed) > 0;
+        if (!bursting && rate > 0.0) {
+            const auto due = base + std::chrono::duration_cast<Clock::duration>(
+                                        std::chrono::duration<double>(
+                                            static_cast<double>(ticks / group * group) / rate));
+            const auto now = Clock::now();
+            if (now < due) {
+                std::this_thread::sleep_until(std::min(due, now + kIdleWait));
+                continue;
+            }
+        }
+        switch (tick()) {
+        case Tick::Sent:
+            if (!bursting) {
+                ++ticks;
+            } else if (burst_pending_.fetch_sub(1, std::memory_order_relaxed) == 1) {
+                rebase();
+            }
+            break;
+        case Tick::Idle:
+            std::this_thread::sleep_for(kIdleWait);
+            rebase();
+            break;
+        case Tick::Backpressured:
+            std::this_thread::sleep_for(kIdleWait);
+            break;
+        }
+    }
+}
+
+SyntheticHermes::Tick SyntheticHermes::tick() {
+    std::lock_guard lock(clients_mutex_);
+    // Hold everyone back for a slow socket, so all clients see the same frame times
+    for (const auto &[socket, client] : clients_) {
+        if (client.streaming && socket->bufferedAmount() > kMaxBufferedBytes) {
+            return Tick::Backpressured;
+        }
+    }
+    const uint64_t skip = skip_pending_.exchange(0, std::memory_order_relaxed);
+    bool sent = false;
+    for (auto &[socket, client] : clients_) {
+        client.load.skip(skip);
+        if (!client.streaming || (profile_.max_frames > 0 &&
+                                  client.load.frames_generated() >= profile_.max_frames)) {
+            continue;
+        }
+        client.load.next_frame(frame_);
+        wire_.assign(reinterpret_cast<const char *>(frame_.data()), frame_.size());
+        socket->sendBinary(wire_);
+        frames_sent_.fetch_add(1, std::memory_order_relaxed);
+        bytes_sent_.fetch_add(wire_.size(), std::memory_order_relaxed);
+        sent = true;
+    }
+    return sent ? Tick::Sent : Tick::Idle;
+}
+
+} // namespace daedalus::loadgen
@@ -0,0 +1,90 @@
+#include "daedalus/loadgen/synthetic_load.hpp"
+
+#include "daedalus/protocol/telemetry.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cstring>
+#include <string_view>
+
+namespace daedalus::loadgen {
+
+namespace {
+
+std::string module_name(size_t m) { return "m" + std::to_string(m); }
+std::string signal_name(size_t s) { return "s" + std::to_string(s); }
+
+} // namespace
+
+SyntheticLoad::SyntheticLoad(const LoadProfile &profile) : profile_(profile) {
+    paths_.reserve(profile_.modules * profile_.signals_per_module);
+    for (size_t m = 0; m < profile_.modules; ++m) {
+        for (size_t s = 0; s < profile_.signals_per_module; ++s) {
+            paths_.push_back(module_name(m) + "." + signal_name(s));
+        }
+    }
+}
+
+std::string SyntheticLoad::schema_json() const {
+    nlohmann::json modules = nlohmann::json::object();
+    for (size_t m = 0; m < profile_.modules; ++m) {
+        nlohmann::json signals = nlohmann::json::array();
+        for (size_t s = 0; s < profile_.signals_per_module; ++s) {
+            signals.push_back({{"name", signal_name(s)}, {"type", "f64"}});
+        }
+        modules[module_name(m)] = {{"signals", std::move(signals)}};
+    }
+    return nlohmann::json{{"type", "schema"}, {"modules", std::move(modules)}}.dump();
+}
+
+std::string SyntheticLoad::subscribe(const std::vector<std::string> &patterns) {
+    selection_.clear();
+    nlohmann::json signals = nlohmann::json::array();
+    for (size_t i = 0; i < paths_.size(); ++i) {
+        const std::string_view path = paths_[i];
+        for (const auto &pattern : patterns) {
+            const bool match =
+                pattern == "*" || pattern == path ||
+                (pattern.size() >= 2 && pattern.ends_with(".*") &&
+                 path.starts_with(std::string_view(pattern).substr(0, pattern.size() - 1)));
+            if (match) {
+                selection_.push_back(static_cast<uint32_t>(i));
+                signals.push_back(paths_[i]);
+                break;
+            }
+        }
+    }
+    return nlohmann::json{{"type", "ack"},
+                          {"action", "subscribe"},
+                          {"count", selection_.size()},
+                          {"signals", std::move(signals)}}
+        .dump();
+}
+
+void SyntheticLoad::next_frame(std::vector<uint8_t> &out) {
+    if (profile_.gap_every > 0 && until_gap_ == profile_.gap_every) {
+        skip_pending_ += profile_.gap_frames;
+        until_gap_ = 0;
+    }
+    frame_ += skip_pending_;
+    skipped_ += skip_pending_;
+    skip_pending_ = 0;
+
+    const protocol::TelemetryHeader hdr{
+        protocol::kTelemetryMagic, frame_,
+        static_cast<double>(frame_) / (profile_.sim_rate_hz > 0.0 ? profile_.sim_rate_hz : 1.0),
+        static_cast<uint32_t>(selection_.size())};
+    out.resize(sizeof(hdr) + selection_.size() * sizeof(double));
+    std::memcpy(out.data(), &hdr, sizeof(hdr));
+    auto *values = out.data() + sizeof(hdr);
+    for (const uint32_t signal : selection_) {
+        const double v = value(signal, frame_);
+        std::memcpy(values, &v, sizeof(v));
+        values += sizeof(v);
+    }
+    ++frame_;
+    ++generated_;
+    ++until_gap_;
+}
+
+} // namespace daedalus::loadgen
@@ -1,6 +1,8 @@
 #include "daedalus/protocol/client.hpp"
 
 #include <cstdint>
+#include <utility>
+#include <variant>
 
 namespace daedalus::protocol {
 
@@ -32,7 +34,12 @@ void HermesClient::subscribe(const std::vector<std::string> &patterns) {
     for (auto &p : patterns) {
         signals_arr.push_back(p);
     }
-    send_command("subscribe", {{"signals", signals_arr}});
+    // Typed payloads are always decodable; the ack says whether the server packs them.
+    nlohmann::json params = {{"signals", signals_arr}, {"payload", "typed"}};
+    if (encoding_ == TelemetryEncoding::Xor) {
+        params["encoding"] = "xor";
+    }
+    send_command("subscribe", params);
 }
 
 void HermesClient::pause() { send_command("pause"); }
@@ -64,41 +71,46 @@ void HermesClient::on_message(const ix::WebSocketMessagePtr &msg) {
     switch (msg->type) {
     case ix::WebSocketMessageType::Message:
         if (msg->binary) {
-            // Binary telemetry frame — validate magic before queueing
-            auto &data = msg->str;
-            if (data.size() >= sizeof(TelemetryHeader)) {
-                uint32_t magic = 0;
-                std::memcpy(&magic, data.data(), sizeof(magic));
-                if (magic == kTelemetryMagic) {
-                    std::vector<uint8_t> frame(data.begin(), data.end());
-                    telemetry_queue_.try_push(std::move(frame));
-                }
+            // Binary telemetry frame — validate and decode into the open batch
+            const auto &data = msg->str;
+            const auto *bytes = reinterpret_cast<const uint8_t *>(data.data());
+            if (const auto recorder = current_recorder()) {
+                recorder->record_frame(bytes, data.size());
             }
+            deliver_frame(bytes, data.size());
         } else {
-            // Text frame (JSON) — push raw string for render thread to parse
-            event_queue_.try_push(std::string(msg->str));
+            // Text frame (JSON) — parsed here so the render thread only dispatches
+            if (auto event = parse_control_event(msg->str)) {
+                // A new recording has to start with the current layout.
+                if (std::holds_alternative<Schema>(*event)) {
+                    schema_text_ = msg->str;
+                    ack_text_.clear();
+                    record_layout(msg->str);
+                } else if (std::holds_alternative<SubscribeAck>(*event)) {
+                    ack_text_ = msg->str;
+                    record_layout(msg->str);
+                }
+                deliver_event(std::move(*event));
+            }
         }
         break;
 
     case ix::WebSocketMessageType::Open:
         state_.store(ConnectionState::Connected, std::memory_order_relaxed);
-        event_queue_.try_push(R"({"type":"connection","event":"connected"})");
+        begin_stream();
+        schema_text_.clear();
+        ack_text_.clear();
+        deliver_event(StateChange{ConnectionState::Connected, {}});
         break;
 
     case ix::WebSocketMessageType::Close:
         state_.store(ConnectionState::Disconnected, std::memory_order_relaxed);
-        event_queue_.try_push(R"({"type":"connection","event":"disconnected"})");
+        deliver_event(StateChange{ConnectionState::Disconnected, {}});
         break;
 
     case ix::WebSocketMessageType::Error:
         state_.store(ConnectionState::Error, std::memory_order_relaxed);
-        {
-            nlohmann::json event;
-            event["type"] = "connection";
-            event["event"] = "error";
-            event["message"] = msg->errorInfo.reason;
-            event_queue_.try_push(event.dump());
-        }
+        deliver_event(StateChange{ConnectionState::Error, msg->errorInfo.reason});
         break;
 
     default:
@@ -106,4 +118,37 @@ void HermesClient::on_message(const ix::WebSocketMessagePtr &msg) {
     }
 }
 
+std::shared_ptr<record::SessionRecorder> HermesClient::current_recorder() {
+    auto recorder = recorder_.load(std::memory_order_acquire);
+    adopt_recorder(recorder);
+    return recorder;
+}
+
+void HermesClient::record_layout(const std::string &text) {
+    auto recorder = recorder_.load(std::memory_order_acquire);
+    // A recorder seen for the first time gets the saved layout, `text` included.
+    if (!adopt_recorder(recorder) && recorder) {
+        recorder->record_text(text);
+    }
+}
+
+bool HermesClient::adopt_recorder(const std::shared_ptr<record::SessionRecorder> &recorder) {
+    // Holding the active recorder keeps its address from being reused by the next.
+    if (recorder == active_recorder_) {
+        return false;
+    }
+    active_recorder_ = recorder;
+    if (!recorder) {
+        return false;
+    }
+    // A new recording: lead with the layout of the frames that will follow.
+    if (!schema_text_.empty()) {
+        recorder->record_text(schema_text_);
+        if (!ack_text_.empty()) {
+            recorder->record_text(ack_text_);
+        }
+    }
+    return true;
+}
+
 } // namespace daedalus::protocol
@@ -0,0 +1,151 @@
+#include "daedalus/protocol/decode_plan.hpp"
+
+#include <cstring>
+#include <utility>
+
+namespace daedalus::protocol {
+
+namespace {
+
+/// Widen `count` packed little-endian values of type T.
+template <typename T> void widen(const uint8_t *in, size_t count, double *out) {
+    for (size_t i = 0; i < count; ++i) {
+        T value;
+        std::memcpy(&value, in + i * sizeof(T), sizeof(T));
+        out[i] = static_cast<double>(value);
+    }
+}
+
+} // namespace
+
+std::optional<ValueType> parse_value_type(std::string_view name) {
+    if (name == "f64") {
+        return ValueType::F64;
+    }
+    if (name == "f32") {
+        return ValueType::F32;
+    }
+    if (name == "i32") {
+        return ValueType::I32;
+    }
+    if (name == "u32") {
+        return ValueType::U32;
+    }
+    if (name == "i64") {
+        return ValueType::I64;
+    }
+    if (name == "bool") {
+        return ValueType::Bool;
+    }
+    if (name == "enum") {
+        return ValueType::Enum;
+    }
+    return std::nullopt;
+}
+
+size_t value_size(ValueType type) {
+    switch (type) {
+    case ValueType::F64:
+    case ValueType::I64:
+        return 8;
+    case ValueType::F32:
+    case ValueType::I32:
+    case ValueType::U32:
+    case ValueType::Enum:
+        return 4;
+    case ValueType::Bool:
+        return 1;
+    }
+    return 8;
+}
+
+DeclaredTypes declared_types(const Schema &schema) {
+    DeclaredTypes types;
+    for (const auto &mod : schema.modules) {
+        for (const auto &sig : mod.signals) {
+            const auto type = parse_value_type(sig.type);
+            if (type.has_value() && *type != ValueType::F64) {
+                types.emplace(mod.name + "." + sig.name, *type);
+            }
+        }
+    }
+    return types;
+}
+
+DecodePlan::DecodePlan(std::vector<ValueType> types) : types_(std::move(types)) {
+    for (size_t s = 0; s < types_.size(); ++s) {
+        if (runs_.empty() || runs_.back().type != types_[s]) {
+            runs_.push_back({types_[s], s, 0, payload_bytes_});
+        }
+        ++runs_.back().count;
+        payload_bytes_ += value_size(types_[s]);
+    }
+}
+
+DecodePlan::DecodePlan(const DeclaredTypes &declared, const std::vector<std::string> &signals)
+    : DecodePlan([&] {
+          std::vector<ValueType> types(signals.size(), ValueType::F64);
+          if (!declared.empty()) {
+              for (size_t s = 0; s < signals.size(); ++s) {
+                  if (const auto it = declared.find(signals[s]); it != declared.end()) {
+                      types[s] = it->second;
+                  }
+              }
+          }
+          return types;
+      }()) {}
+
+void DecodePlan::decode(const uint8_t *payload, double *out) const {
+    for (const Run &run : runs_) {
+        const uint8_t *in = payload + run.offset;
+        double *dst = out + run.first;
+        switch (run.type) {
+        case ValueType::F64:
+            std::memcpy(dst, in, run.count * sizeof(double));
+            break;
+        case ValueType::F32:
+            widen<float>(in, run.count, dst);
+            break;
+        case ValueType::I32:
+        case ValueType::Enum:
+            widen<int32_t>(in, run.count, dst);
+            break;
+        case ValueType::U32:
+            widen<uint32_t>(in, run.count, dst);
+            break;
+        case ValueType::I64:
+            widen<int64_t>(in, run.count, dst);
+            break;
+        case ValueType::Bool:
+            for (size_t i = 0; i < run.count; ++i) {
+                dst[i] = in[i] != 0 ? 1.0 : 0.0;
+            }
+            break;
+        }
+    }
+}
+
+DecodePlan negotiated_plan(const DeclaredTypes &declared, const SubscribeAck &ack) {
+    if (!ack.typed_payload) {
+        return {};
+    }
+    return {declared, ack.signals};
+}
+
+bool decode_frame(const uint8_t *data, size_t len, const DecodePlan &plan, TelemetryHeader &hdr,
+                  std::span<const double> &values, std::vector<double> &value_storage) {
+    if (plan.all_f64() || len < sizeof(TelemetryHeader)) {
+        return decode_frame(data, len, hdr, values, value_storage);
+    }
+    std::memcpy(&hdr, data, sizeof(TelemetryHeader));
+    if (hdr.magic != kTelemetryMagic || hdr.count != plan.signal_count() ||
+        len - sizeof(TelemetryHeader) != plan.payload_bytes()) {
+        return decode_frame(data, len, hdr, values, value_storage);
+    }
+    value_storage.resize(hdr.count);
+    plan.decode(data + sizeof(TelemetryHeader), value_storage.data());
+    values = std::span<const double>(value_storage.data(), hdr.count);
+    return true;
+}
+
+} // namespace daedalus::protocol
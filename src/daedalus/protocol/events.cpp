@@ -0,0 +1,34 @@
+#include "daedalus/protocol/events.hpp"
+
+#include <exception>
+
+namespace daedalus::protocol {
+
+std::optional<ControlEvent> parse_control_event(std::string_view text) {
+    try {
+        const auto kind = peek_message_kind(text);
+        if (kind.type == "schema") {
+            return parse_schema_text(text);
+        }
+        if (kind.type == "ack") {
+            if (kind.action == "subscribe") {
+                return parse_subscribe_ack_text(text);
+            }
+            return std::nullopt;
+        }
+        // The remaining messages are small; a DOM is fine for them.
+        if (kind.type == "event") {
+            const auto msg = nlohmann::json::parse(text);
+            return SimEvent{msg.value("event", "")};
+        }
+        if (kind.type == "error") {
+            const auto msg = nlohmann::json::parse(text);
+            return ServerError{msg.value("message", "")};
+        }
+    } catch (const std::exception &e) {
+        return ParseFailure{e.what()};
+    }
+    return std::nullopt;
+}
+
+} // namespace daedalus::protocol
@@ -0,0 +1,108 @@
+#include "daedalus/protocol/frame_batcher.hpp"
+#include "daedalus/protocol/telemetry.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace daedalus::protocol {
+
+FrameBatcher::FrameBatcher(data::TelemetryQueue &queue, data::BatchPool &pool)
+    : queue_(queue), pool_(pool) {}
+
+size_t FrameBatcher::rows_for(size_t signal_count) {
+    if (signal_count == 0) {
+        return kMaxRows;
+    }
+    const size_t rows = kTargetBatchBytes / (signal_count * sizeof(double));
+    return std::clamp<size_t>(rows, 1, kMaxRows);
+}
+
+bool FrameBatcher::ingest(const uint8_t *data, size_t len) {
+    TelemetryHeader hdr{};
+    std::span<const double> values;
+    uint32_t magic = 0;
+    if (len >= sizeof(magic)) {
+        std::memcpy(&magic, data, sizeof(magic));
+    }
+    const bool compressed = magic == kCompressedTelemetryMagic;
+    const bool decoded = compressed ? xor_decoder_.decode(data, len, hdr, values)
+                                    : decode_frame(data, len, plan_, hdr, values, value_storage_);
+    if (!decoded) {
+        frames_rejected_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (compressed) {
+        frames_compressed_.fetch_add(1, std::memory_order_relaxed);
+    }
+    const auto now = std::chrono::steady_clock::now();
+    health_.observe(hdr.frame, hdr.time, now);
+
+    std::lock_guard<std::mutex> lock(batch_mutex_);
+    // A new subscription changes the row width; never mix layouts in one batch.
+    if (has_open_ && open_.signal_count != hdr.count) {
+        publish();
+        if (has_open_) {
+            has_open_ = false;
+            pool_.reclaim(std::move(open_));
+        }
+    }
+    if (!has_open_) {
+        open_batch(hdr.count);
+    }
+
+    if (open_.empty()) {
+        open_.received_at = now;
+    }
+    open_.append(hdr.frame, hdr.time, values);
+    frames_decoded_.fetch_add(1, std::memory_order_relaxed);
+
+    if (open_.full() || due(now)) {
+        publish();
+    }
+    return true;
+}
+
+void FrameBatcher::flush() {
+    std::lock_guard<std::mutex> lock(batch_mutex_);
+    if (has_open_) {
+        publish();
+    }
+}
+
+void FrameBatcher::publish_stale() {
+    std::unique_lock<std::mutex> lock(batch_mutex_, std::try_to_lock);
+    if (lock.owns_lock() && has_open_ && due(std::chrono::steady_clock::now())) {
+        publish();
+    }
+}
+
+bool FrameBatcher::due(std::chrono::steady_clock::time_point now) const {
+    const bool consumer_idle = queue_.size_approx() == 0;
+    const bool aged = now - opened_at_ >= kMaxBatchAge;
+    return consumer_idle || aged;
+}
+
+void FrameBatcher::open_batch(size_t signal_count) {
+    open_ = pool_.acquire();
+    if (open_.reset(signal_count, rows_for(signal_count))) {
+        pool_.note_allocation();
+    }
+    has_open_ = true;
+    opened_at_ = std::chrono::steady_clock::now();
+}
+
+void FrameBatcher::publish() {
+    if (!has_open_ || open_.empty()) {
+        return;
+    }
+    if (queue_.try_push(std::move(open_))) {
+        has_open_ = false;
+        return;
+    }
+    // Rejected by the queue's overflow policy (already counted as dropped):
+    // discard the rows but keep the storage for the next batch.
+    open_.rows = 0;
+    opened_at_ = std::chrono::steady_clock::now();
+}
+
+} // namespace daedalus::protocol
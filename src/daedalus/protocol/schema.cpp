@@ -1,7 +1,323 @@
 #include "daedalus/protocol/schema.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
 namespace daedalus::protocol {
 
+namespace {
+
+/// Base for the streaming parsers. Tracks nesting, skips whole values a parser
+/// declines in on_open(), and turns malformed JSON into std::runtime_error.
+/// Depth is the number of open containers the parser accepted: members of the
+/// top-level object arrive at depth 1.
+class StreamingParser : public nlohmann::json::json_sax_t {
+  public:
+    /// A scalar value: `text` is set for strings, `unsigned_value` for
+    /// non-negative integers.
+    struct Scalar {
+        std::string *text = nullptr;
+        std::optional<uint64_t> unsigned_value;
+    };
+
+    /// Run the parser over `text`. Returns false if a subclass stopped early.
+    bool run(std::string_view text) {
+        return nlohmann::json::sax_parse(text.begin(), text.end(), this);
+    }
+
+    bool null() override { return scalar({}); }
+    bool boolean(bool) override { return scalar({}); }
+    bool number_integer(number_integer_t) override { return scalar({}); }
+    bool number_unsigned(number_unsigned_t value) override { return scalar({nullptr, value}); }
+    bool number_float(number_float_t, const string_t &) override { return scalar({}); }
+    bool string(string_t &value) override { return scalar({&value, std::nullopt}); }
+    bool binary(binary_t &) override { return scalar({}); }
+
+    bool start_object(std::size_t) override { return open(true); }
+    bool start_array(std::size_t) override { return open(false); }
+    bool end_object() override { return close(); }
+    bool end_array() override { return close(); }
+
+    bool key(string_t &value) override {
+        if (skipped_ == 0) {
+            on_key(value);
+        }
+        return !done_;
+    }
+
+    bool parse_error(std::size_t position, const std::string &,
+                     const nlohmann::json::exception &ex) override {
+        throw std::runtime_error("Malformed JSON at byte " + std::to_string(position) + ": " +
+                                 ex.what());
+    }
+
+  protected:
+    [[nodiscard]] size_t depth() const { return depth_; }
+    /// Stop parsing after the current event.
+    void finish() { done_ = true; }
+
+    virtual void on_key(std::string &key) = 0;
+    virtual void on_scalar(Scalar &value) = 0;
+    /// A container opens as a value at depth(); return false to skip it whole.
+    virtual bool on_open(bool object) = 0;
+    /// An accepted container at depth() closes.
+    virtual void on_close() {}
+
+  private:
+    bool scalar(Scalar value) {
+        if (skipped_ == 0) {
+            on_scalar(value);
+        }
+        return !done_;
+    }
+
+    bool open(bool object) {
+        if (skipped_ > 0 || !on_open(object)) {
+            ++skipped_;
+        } else {
+            ++depth_;
+        }
+        return !done_;
+    }
+
+    bool close() {
+        if (skipped_ > 0) {
+            --skipped_;
+        } else {
+            on_close();
+            --depth_;
+        }
+        return !done_;
+    }
+
+    size_t depth_ = 0;
+    size_t skipped_ = 0; ///< Open containers inside a skipped value.
+    bool done_ = false;
+};
+
+class MessageKindParser final : public StreamingParser {
+  public:
+    MessageKind kind;
+
+  private:
+    void on_key(std::string &key) override {
+        field_ = key == "type" ? &kind.type : key == "action" ? &kind.action : nullptr;
+    }
+    void on_scalar(Scalar &value) override {
+        if (depth() == 1 && field_ != nullptr && value.text != nullptr) {
+            *field_ = std::move(*value.text);
+            // Only acks are told apart by their action.
+            if (!kind.type.empty() && (kind.type != "ack" || !kind.action.empty())) {
+                finish();
+            }
+        }
+    }
+    bool on_open(bool) override { return depth() == 0; }
+
+    std::string *field_ = nullptr;
+};
+
+/// {"type": "schema", "modules": {"<module>": {"signals": [{"name", "type", "unit"}]}}}
+/// Depth 1: message, 2: modules, 3: one module, 4: its signals, 5: one signal.
+class SchemaParser final : public StreamingParser {
+  public:
+    Schema schema;
+    std::string type;
+    bool has_modules = false;
+
+  private:
+    enum class Key { Other, Type, Modules, Signals, Name, SignalType, Unit };
+
+    void on_key(std::string &key) override {
+        switch (depth()) {
+        case 1:
+            key_ = key == "type" ? Key::Type : key == "modules" ? Key::Modules : Key::Other;
+            break;
+        case 2:
+            schema.modules.push_back({std::move(key), {}});
+            has_signals_ = false;
+            break;
+        case 3:
+            key_ = key == "signals" ? Key::Signals : Key::Other;
+            break;
+        case 5:
+            key_ = key == "name"   ? Key::Name
+                   : key == "type" ? Key::SignalType
+                   : key == "unit" ? Key::Unit
+                                   : Key::Other;
+            break;
+        default:
+            break;
+        }
+    }
+
+    void on_scalar(Scalar &value) override {
+        check_container(false, false);
+        if (value.text == nullptr) {
+            return;
+        }
+        if (depth() == 1 && key_ == Key::Type) {
+            type = std::move(*value.text);
+        } else if (depth() == 5 && key_ == Key::Name) {
+            signal_.name = std::move(*value.text);
+            has_name_ = true;
+        } else if (depth() == 5 && key_ == Key::SignalType) {
+            signal_.type = std::move(*value.text);
+            has_type_ = true;
+        } else if (depth() == 5 && key_ == Key::Unit) {
+            signal_.unit = std::move(*value.text);
+        }
+    }
+
+    bool on_open(bool object) override {
+        check_container(true, object);
+        switch (depth()) {
+        case 0:
+            return true;
+        case 1:
+            has_modules = has_modules || key_ == Key::Modules;
+            return key_ == Key::Modules;
+        case 2:
+            return true;
+        case 3:
+            has_signals_ = has_signals_ || key_ == Key::Signals;
+            return key_ == Key::Signals;
+        case 4:
+            signal_ = SignalInfo{};
+            has_name_ = false;
+            has_type_ = false;
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    void on_close() override {
+        ModuleInfo *mod = schema.modules.empty() ? nullptr : &schema.modules.back();
+        if (depth() == 3 && !has_signals_) {
+            throw std::runtime_error("Module '" + mod->name + "' missing 'signals' array");
+        }
+        if (depth() != 5) {
+            return;
+        }
+        if (!has_name_) {
+            throw std::runtime_error("Signal missing 'name' in module '" + mod->name + "'");
+        }
+        if (!has_type_) {
+            throw std::runtime_error("Signal '" + signal_.name + "' missing 'type' in module '" +
+                                     mod->name + "'");
+        }
+        mod->signals.push_back(std::move(signal_));
+    }
+
+    /// Reject a value of the wrong shape where the schema requires a container.
+    void check_container(bool is_container, bool object) {
+        const bool want_object = depth() != 3;
+        const bool required = (depth() == 1 && key_ == Key::Modules) || depth() == 2 ||
+                              (depth() == 3 && key_ == Key::Signals) || depth() == 4;
+        if (!required || (is_container && object == want_object)) {
+            return;
+        }
+        switch (depth()) {
+        case 1:
+            throw std::runtime_error("Schema missing 'modules' object");
+        case 2:
+        case 3:
+            throw std::runtime_error("Module '" + schema.modules.back().name +
+                                     "' missing 'signals' array");
+        default:
+            throw std::runtime_error("Signal missing 'name' in module '" +
+                                     schema.modules.back().name + "'");
+        }
+    }
+
+    Key key_ = Key::Other;
+    bool has_signals_ = false;
+    SignalInfo signal_;
+    bool has_name_ = false;
+    bool has_type_ = false;
+};
+
+/// {"type": "ack", "action": "subscribe", "count": N, "signals": ["<path>", ...],
+///  "payload": "typed"}
+class SubscribeAckParser final : public StreamingParser {
+  public:
+    SubscribeAck ack{};
+    MessageKind kind;
+    bool has_count = false;
+    bool has_signals = false;
+
+  private:
+    enum class Key { Other, Type, Action, Count, Signals, Payload };
+
+    void on_key(std::string &key) override {
+        if (depth() == 1) {
+            key_ = key == "type"      ? Key::Type
+                   : key == "action"  ? Key::Action
+                   : key == "count"   ? Key::Count
+                   : key == "signals" ? Key::Signals
+                   : key == "payload" ? Key::Payload
+                                      : Key::Other;
+        }
+    }
+
+    void on_scalar(Scalar &value) override {
+        if (depth() == 2) {
+            if (value.text == nullptr) {
+                throw std::runtime_error("Subscribe ack signal is not a string");
+            }
+            ack.signals.push_back(std::move(*value.text));
+            return;
+        }
+        if (depth() != 1) {
+            return;
+        }
+        switch (key_) {
+        case Key::Type:
+            kind.type = value.text != nullptr ? std::move(*value.text) : std::string();
+            break;
+        case Key::Action:
+            kind.action = value.text != nullptr ? std::move(*value.text) : std::string();
+            break;
+        case Key::Count:
+            has_count = value.unsigned_value.has_value();
+            ack.count = static_cast<uint32_t>(value.unsigned_value.value_or(0));
+            break;
+        case Key::Signals:
+            has_signals = false;
+            break;
+        case Key::Payload:
+            ack.typed_payload = value.text != nullptr && *value.text == "typed";
+            break;
+        case Key::Other:
+            break;
+        }
+    }
+
+    bool on_open(bool object) override {
+        if (depth() == 2) {
+            throw std::runtime_error("Subscribe ack signal is not a string");
+        }
+        if (depth() == 1 && key_ == Key::Count) {
+            has_count = false;
+        }
+        if (depth() == 1 && key_ == Key::Payload) {
+            ack.typed_payload = false;
+        }
+        if (depth() == 1 && key_ == Key::Signals) {
+            has_signals = !object;
+            ack.signals.clear();
+            return !object;
+        }
+        return depth() == 0;
+    }
+
+    Key key_ = Key::Other;
+};
+
+} // namespace
+
 Schema parse_schema(const nlohmann::json &msg) {
     if (!msg.contains("type") || msg["type"] != "schema") {
         throw std::runtime_error("Expected message type 'schema'");
@@ -68,7 +384,45 @@ SubscribeAck parse_subscribe_ack(const nlohmann::json &msg) {
         ack.signals.push_back(sig.get<std::string>());
     }
 
+    ack.typed_payload = msg.contains("payload") && msg["payload"] == "typed";
+
     return ack;
 }
 
+MessageKind peek_message_kind(std::string_view text) {
+    MessageKindParser parser;
+    parser.run(text);
+    return std::move(parser.kind);
+}
+
+Schema parse_schema_text(std::string_view text) {
+    SchemaParser parser;
+    parser.run(text);
+    if (parser.type != "schema") {
+        throw std::runtime_error("Expected message type 'schema'");
+    }
+    if (!parser.has_modules) {
+        throw std::runtime_error("Schema missing 'modules' object");
+    }
+    return std::move(parser.schema);
+}
+
+SubscribeAck parse_subscribe_ack_text(std::string_view text) {
+    SubscribeAckParser parser;
+    parser.run(text);
+    if (parser.kind.type != "ack") {
+        throw std::runtime_error("Expected message type 'ack'");
+    }
+    if (parser.kind.action != "subscribe") {
+        throw std::runtime_error("Expected action 'subscribe'");
+    }
+    if (!parser.has_count) {
+        throw std::runtime_error("Subscribe ack missing 'count'");
+    }
+    if (!parser.has_signals) {
+        throw std::runtime_error("Subscribe ack missing 'signals' array");
+    }
+    return std::move(parser.ack);
+}
+
 } // namespace daedalus::protocol
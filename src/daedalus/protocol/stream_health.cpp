@@ -0,0 +1,143 @@
+#include "daedalus/protocol/stream_health.hpp"
+
+namespace daedalus::protocol {
+
+static_assert(StreamHealth::kReorderWindow == 64, "one bit per frame in a uint64_t window");
+
+namespace {
+
+int64_t to_ticks(StreamHealth::Clock::time_point t) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+} // namespace
+
+void StreamHealth::observe(uint64_t frame, double sim_time, Clock::time_point now) {
+    frames_.fetch_add(1, std::memory_order_relaxed);
+    last_seen_ns_.store(to_ticks(now), std::memory_order_relaxed);
+    if (has_window_) {
+        ++window_received_;
+    }
+
+    if (has_baseline_ && frame <= highest_frame_) {
+        const uint64_t behind = highest_frame_ - frame;
+        // A reset restarts the counter at zero; anything else far behind is
+        // also more likely a new run than a frame that wandered that late.
+        if (behind == 0 || (frame != 0 && behind < kReorderWindow)) {
+            const uint64_t bit = uint64_t{1} << behind;
+            if ((received_ & bit) != 0) {
+                duplicates_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            received_ |= bit;
+            reordered_.fetch_add(1, std::memory_order_relaxed);
+            // A late frame fills a hole only if its gap was counted; frames from
+            // before the baseline never were.
+            if ((holes_ & bit) != 0) {
+                holes_ &= ~bit;
+                missing_frames_.fetch_sub(1, std::memory_order_relaxed);
+            }
+            return;
+        }
+        restarts_.fetch_add(1, std::memory_order_relaxed);
+        has_window_ = false;
+    } else if (has_baseline_ && frame > highest_frame_ + 1) {
+        gaps_.fetch_add(1, std::memory_order_relaxed);
+        missing_frames_.fetch_add(frame - highest_frame_ - 1, std::memory_order_relaxed);
+    }
+    if (has_baseline_ && frame > highest_frame_) {
+        advance(frame);
+    } else {
+        received_ = 1;
+        holes_ = 0;
+    }
+
+    has_baseline_ = true;
+    highest_frame_ = frame;
+    last_frame_.store(frame, std::memory_order_relaxed);
+    last_sim_time_.store(sim_time, std::memory_order_relaxed);
+    update_rates(frame, sim_time, now);
+}
+
+void StreamHealth::advance(uint64_t frame) {
+    const uint64_t step = frame - highest_frame_;
+    if (step >= kReorderWindow) {
+        // The whole window behind the new frame was skipped.
+        received_ = 1;
+        holes_ = ~uint64_t{1};
+        return;
+    }
+    // Frames highest_frame_ + 1 .. frame - 1 were skipped: bits 1 .. step - 1.
+    const uint64_t skipped = ((uint64_t{1} << step) - 1) & ~uint64_t{1};
+    received_ = (received_ << step) | 1;
+    holes_ = (holes_ << step) | skipped;
+}
+
+void StreamHealth::update_rates(uint64_t frame, double sim_time, Clock::time_point now) {
+    if (!has_window_) {
+        has_window_ = true;
+        window_start_ = now;
+        window_frame_ = frame;
+        window_sim_time_ = sim_time;
+        window_received_ = 0;
+        return;
+    }
+    if (now - window_start_ < kRateWindow) {
+        return;
+    }
+
+    const double wall_dt = std::chrono::duration<double>(now - window_start_).count();
+    const double sim_dt = sim_time - window_sim_time_;
+    const double receive_rate = static_cast<double>(window_received_) / wall_dt;
+    const double sim_rate = sim_dt > 0.0 ? static_cast<double>(frame - window_frame_) / sim_dt : 0.0;
+    const double rtf = sim_dt / wall_dt;
+
+    auto smooth = [this](std::atomic<double> &value, double sample) {
+        const double blended =
+            rates_valid_ ? value.load(std::memory_order_relaxed) * (1.0 - kRateSmoothing) +
+                               sample * kRateSmoothing
+                         : sample;
+        value.store(blended, std::memory_order_relaxed);
+    };
+    smooth(receive_rate_hz_, receive_rate);
+    smooth(sim_rate_hz_, sim_rate);
+    smooth(real_time_factor_, rtf);
+    rates_valid_ = true;
+
+    window_start_ = now;
+    window_frame_ = frame;
+    window_sim_time_ = sim_time;
+    window_received_ = 0;
+}
+
+void StreamHealth::reset_baseline() {
+    has_baseline_ = false;
+    has_window_ = false;
+    rates_valid_ = false;
+    receive_rate_hz_.store(0.0, std::memory_order_relaxed);
+    sim_rate_hz_.store(0.0, std::memory_order_relaxed);
+    real_time_factor_.store(0.0, std::memory_order_relaxed);
+}
+
+StreamHealthStats StreamHealth::stats(Clock::time_point now) const {
+    StreamHealthStats s;
+    s.frames = frames_.load(std::memory_order_relaxed);
+    s.gaps = gaps_.load(std::memory_order_relaxed);
+    s.missing_frames = missing_frames_.load(std::memory_order_relaxed);
+    s.duplicates = duplicates_.load(std::memory_order_relaxed);
+    s.reordered = reordered_.load(std::memory_order_relaxed);
+    s.restarts = restarts_.load(std::memory_order_relaxed);
+    s.last_frame = last_frame_.load(std::memory_order_relaxed);
+    s.last_sim_time = last_sim_time_.load(std::memory_order_relaxed);
+    s.receive_rate_hz = receive_rate_hz_.load(std::memory_order_relaxed);
+    s.sim_rate_hz = sim_rate_hz_.load(std::memory_order_relaxed);
+    s.real_time_factor = real_time_factor_.load(std::memory_order_relaxed);
+
+    const int64_t last_seen = last_seen_ns_.load(std::memory_order_relaxed);
+    if (s.frames > 0 && to_ticks(now) > last_seen) {
+        s.seconds_since_last_frame = static_cast<double>(to_ticks(now) - last_seen) * 1e-9;
+    }
+    return s;
+}
+
+} // namespace daedalus::protocol
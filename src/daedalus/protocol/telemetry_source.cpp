@@ -0,0 +1,33 @@
+#include "daedalus/protocol/telemetry_source.hpp"
+
+#include <utility>
+#include <variant>
+
+namespace daedalus::protocol {
+
+TelemetrySource::TelemetrySource() {
+    // Batches evicted on overflow never reached the consumer; reuse their storage.
+    telemetry_queue_.set_discard_handler(
+        [this](data::FrameBatch &&batch) { batch_pool_.reclaim(std::move(batch)); });
+}
+
+void TelemetrySource::deliver_event(ControlEvent &&event) {
+    batcher_.flush();
+    // The schema's types and the ack's order define the payload layout, once the
+    // ack confirms typed payloads.
+    if (const auto *schema = std::get_if<Schema>(&event)) {
+        declared_types_ = declared_types(*schema);
+    } else if (const auto *ack = std::get_if<SubscribeAck>(&event)) {
+        batcher_.set_decode_plan(negotiated_plan(declared_types_, *ack));
+    }
+    event_queue_.try_push(std::move(event));
+}
+
+void TelemetrySource::begin_stream() {
+    batcher_.health().reset_baseline();
+    batcher_.set_decode_plan({});
+    batcher_.reset_stream();
+    declared_types_.clear();
+}
+
+} // namespace daedalus::protocol
@@ -0,0 +1,125 @@
+#include "daedalus/protocol/xor_frame.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace daedalus::protocol {
+
+namespace {
+
+/// Reads MSB-first bit fields of up to 64 bits from a byte range.
+class BitReader {
+  public:
+    BitReader(const uint8_t *data, size_t size) : data_(data), bits_left_(size * 8) {}
+
+    bool read(unsigned count, uint64_t &out) {
+        if (count > bits_left_) {
+            return false;
+        }
+        bits_left_ -= count;
+        out = 0;
+        while (count > 0) {
+            const unsigned available = 8 - bit_;
+            const unsigned take = std::min(count, available);
+            const unsigned shift = available - take;
+            out = (out << take) | ((data_[byte_] >> shift) & ((1u << take) - 1));
+            count -= take;
+            bit_ += take;
+            if (bit_ == 8) {
+                bit_ = 0;
+                ++byte_;
+            }
+        }
+        return true;
+    }
+
+  private:
+    const uint8_t *data_;
+    size_t bits_left_;
+    size_t byte_ = 0;
+    unsigned bit_ = 0;
+};
+
+} // namespace
+
+bool XorFrameDecoder::decode(const uint8_t *data, size_t len, TelemetryHeader &hdr,
+                             std::span<const double> &values) {
+    if (len < sizeof(TelemetryHeader) + 1) {
+        return false;
+    }
+    std::memcpy(&hdr, data, sizeof(TelemetryHeader));
+    if (hdr.magic != kCompressedTelemetryMagic) {
+        return false;
+    }
+    const size_t count = hdr.count;
+    const size_t payload = len - sizeof(TelemetryHeader) - 1;
+    if (count > payload * 8) {
+        return false; // the bitmap alone would not fit
+    }
+
+    const uint8_t flags = data[sizeof(TelemetryHeader)];
+    if ((flags & kKeyframeFlag) != 0) {
+        values_.assign(count, 0.0);
+        lead_.assign(count, 0);
+        meaning_.assign(count, 0);
+        synced_ = true;
+    } else if (!synced_ || values_.size() != count) {
+        synced_ = false;
+        return false; // a delta against a row we do not have
+    }
+
+    if (!decode_payload(data + sizeof(TelemetryHeader) + 1, payload, count)) {
+        synced_ = false;
+        return false;
+    }
+    values = std::span<const double>(values_.data(), count);
+    return true;
+}
+
+bool XorFrameDecoder::decode_payload(const uint8_t *data, size_t len, size_t count) {
+    const size_t bitmap_bytes = (count + 7) / 8;
+    BitReader stream(data + bitmap_bytes, len - bitmap_bytes);
+
+    for (size_t byte = 0; byte < bitmap_bytes; ++byte) {
+        // Visit only the changed signals of this bitmap byte.
+        for (unsigned bits = data[byte]; bits != 0; bits &= bits - 1) {
+            const size_t s = byte * 8 + static_cast<size_t>(std::countr_zero(bits));
+            if (s >= count) {
+                return false;
+            }
+            uint64_t control = 0;
+            if (!stream.read(1, control)) {
+                return false;
+            }
+            if (control != 0) {
+                uint64_t lead = 0;
+                uint64_t length = 0;
+                if (!stream.read(6, lead) || !stream.read(6, length) || lead + length + 1 > 64) {
+                    return false;
+                }
+                lead_[s] = static_cast<uint8_t>(lead);
+                meaning_[s] = static_cast<uint8_t>(length + 1);
+            } else if (meaning_[s] == 0) {
+                return false; // no window to reuse
+            }
+            uint64_t bits_xor = 0;
+            if (!stream.read(meaning_[s], bits_xor)) {
+                return false;
+            }
+            const unsigned trail = 64u - lead_[s] - meaning_[s];
+            values_[s] = std::bit_cast<double>(std::bit_cast<uint64_t>(values_[s]) ^
+                                               (bits_xor << trail));
+        }
+    }
+    return true;
+}
+
+void XorFrameDecoder::reset() {
+    values_.clear();
+    lead_.clear();
+    meaning_.clear();
+    synced_ = false;
+}
+
+} // namespace daedalus::protocol
@@ -0,0 +1,96 @@
+#include "daedalus/record/session_index.hpp"
+
+#include "daedalus/protocol/schema.hpp"
+#include "daedalus/protocol/telemetry.hpp"
+#include "daedalus/protocol/xor_frame.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+
+namespace daedalus::record {
+
+std::optional<FrameInfo> frame_info(std::span<const uint8_t> payload) {
+    protocol::TelemetryHeader hdr{};
+    if (payload.size() < sizeof(hdr)) {
+        return std::nullopt;
+    }
+    std::memcpy(&hdr, payload.data(), sizeof(hdr));
+    FrameInfo info{hdr.frame, hdr.time, false};
+    if (hdr.magic == protocol::kTelemetryMagic) {
+        info.seekable = true;
+    } else if (hdr.magic == protocol::kCompressedTelemetryMagic) {
+        info.seekable = payload.size() > sizeof(hdr) &&
+                        (payload[sizeof(hdr)] & protocol::XorFrameDecoder::kKeyframeFlag) != 0;
+    } else {
+        return std::nullopt;
+    }
+    return info;
+}
+
+void SessionIndexer::add(uint64_t offset, RecordKind kind, std::span<const uint8_t> payload) {
+    if (kind == RecordKind::Text) {
+        protocol::MessageKind message;
+        try {
+            message = protocol::peek_message_kind(
+                {reinterpret_cast<const char *>(payload.data()), payload.size()});
+        } catch (const std::runtime_error &) {
+            return;
+        }
+        if (message.type == "schema") {
+            schema_offset_ = offset;
+            ack_offset_ = kNoRecord; // the old subscription's layout is gone
+            layout_changed_ = true;
+        } else if (message.type == "ack" && message.action == "subscribe") {
+            ack_offset_ = offset;
+            layout_changed_ = true;
+        }
+        return;
+    }
+    if (kind != RecordKind::Frame) {
+        return;
+    }
+    const auto info = frame_info(payload);
+    if (!info) {
+        return;
+    }
+    if (frame_records_ > 0 && info->frame < last_frame_) {
+        ++segment_; // the counter restarted: a new run
+        layout_changed_ = true;
+    }
+    ++frame_records_;
+    last_time_ = info->time;
+    last_frame_ = info->frame;
+    if (!info->seekable) {
+        return;
+    }
+    if (layout_changed_ || entries_.empty() || offset - entries_.back().offset >= kSpacingBytes) {
+        entries_.push_back(
+            {info->time, info->frame, offset, schema_offset_, ack_offset_, segment_, 0});
+        layout_changed_ = false;
+    }
+}
+
+std::vector<uint8_t> SessionIndexer::finish(uint64_t records_end) const {
+    const size_t index_bytes = entries_.size() * sizeof(IndexEntry);
+    std::vector<uint8_t> out(record_bytes(index_bytes) + sizeof(SessionTrailer), 0);
+
+    const RecordHeader header{static_cast<uint32_t>(RecordKind::Index),
+                              static_cast<uint32_t>(index_bytes), 0};
+    std::memcpy(out.data(), &header, sizeof(header));
+    if (index_bytes > 0) {
+        std::memcpy(out.data() + sizeof(header), entries_.data(), index_bytes);
+    }
+
+    SessionTrailer trailer{};
+    std::memcpy(trailer.magic, kTrailerMagic, sizeof(trailer.magic));
+    trailer.index_offset = records_end;
+    trailer.entry_count = entries_.size();
+    trailer.frame_records = frame_records_;
+    trailer.last_time = last_time_;
+    trailer.last_frame = last_frame_;
+    std::memcpy(out.data() + record_bytes(index_bytes), &trailer, sizeof(trailer));
+    return out;
+}
+
+} // namespace daedalus::record
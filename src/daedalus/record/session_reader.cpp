@@ -0,0 +1,215 @@
+#include "daedalus/record/session_reader.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace daedalus::record {
+
+SessionReader::~SessionReader() { close(); }
+
+bool SessionReader::open(const std::string &path) {
+    close();
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        std::fprintf(stderr, "[Daedalus] Cannot open session %s: %s\n", path.c_str(),
+                     std::strerror(errno));
+        return false;
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(SessionFileHeader)) {
+        std::fprintf(stderr, "[Daedalus] %s is not a session file\n", path.c_str());
+        ::close(fd);
+        return false;
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    void *mapped = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // the mapping keeps the file
+    if (mapped == MAP_FAILED) {
+        std::fprintf(stderr, "[Daedalus] Cannot map session %s: %s\n", path.c_str(),
+                     std::strerror(errno));
+        size_ = 0;
+        return false;
+    }
+    data_ = static_cast<const uint8_t *>(mapped);
+
+    SessionFileHeader header{};
+    std::memcpy(&header, data_, sizeof(header));
+    if (std::memcmp(header.magic, kSessionMagic, sizeof(header.magic)) != 0 ||
+        header.version != kSessionVersion || header.header_bytes < sizeof(header) ||
+        header.header_bytes > size_ || header.header_bytes % kRecordAlignment != 0) {
+        std::fprintf(stderr, "[Daedalus] %s is not a session file\n", path.c_str());
+        close();
+        return false;
+    }
+    path_ = path;
+    records_begin_ = header.header_bytes;
+    if (!load_index()) {
+        rebuild_index();
+    }
+    return true;
+}
+
+void SessionReader::close() {
+    if (data_ != nullptr) {
+        ::munmap(const_cast<uint8_t *>(data_), size_);
+    }
+    path_.clear();
+    data_ = nullptr;
+    size_ = 0;
+    records_begin_ = records_end_ = 0;
+    index_ = {};
+    rebuilt_ = {};
+    frame_records_ = 0;
+    last_time_ = 0.0;
+    last_frame_ = 0;
+    recovered_ = false;
+}
+
+bool SessionReader::load_index() {
+    if (size_ < records_begin_ + sizeof(SessionTrailer)) {
+        return false;
+    }
+    SessionTrailer trailer{};
+    std::memcpy(&trailer, data_ + size_ - sizeof(trailer), sizeof(trailer));
+    if (std::memcmp(trailer.magic, kTrailerMagic, sizeof(trailer.magic)) != 0 ||
+        trailer.entry_count > size_ / sizeof(IndexEntry)) {
+        return false;
+    }
+    // The Index record must sit exactly between the stream records and the trailer.
+    const uint64_t index_bytes = trailer.entry_count * sizeof(IndexEntry);
+    if (trailer.index_offset < records_begin_ ||
+        trailer.index_offset % kRecordAlignment != 0 ||
+        trailer.index_offset + record_bytes(index_bytes) + sizeof(trailer) != size_) {
+        return false;
+    }
+    RecordHeader header{};
+    std::memcpy(&header, data_ + trailer.index_offset, sizeof(header));
+    if (header.kind != static_cast<uint32_t>(RecordKind::Index) || header.size != index_bytes) {
+        return false;
+    }
+    // Records are 8-byte aligned in a page-aligned mapping, so the entries can be
+    // used where they lie.
+    index_ = {reinterpret_cast<const IndexEntry *>(data_ + trailer.index_offset + sizeof(header)),
+              static_cast<size_t>(trailer.entry_count)};
+    records_end_ = trailer.index_offset;
+    frame_records_ = trailer.frame_records;
+    last_time_ = trailer.last_time;
+    last_frame_ = trailer.last_frame;
+    recovered_ = false;
+    return true;
+}
+
+void SessionReader::rebuild_index() {
+    rebuilt_ = {};
+    records_end_ = size_; // bounds read() until the last complete record is known
+    uint64_t offset = records_begin_;
+    while (const auto record = read(offset)) {
+        if (record->kind == RecordKind::Index) {
+            break; // a finished index behind a damaged trailer
+        }
+        rebuilt_.add(offset, record->kind, record->payload);
+        offset = record->next();
+    }
+    index_ = rebuilt_.entries();
+    records_end_ = offset;
+    frame_records_ = rebuilt_.frame_records();
+    last_time_ = rebuilt_.last_time();
+    last_frame_ = rebuilt_.last_frame();
+    recovered_ = true;
+}
+
+bool SessionReader::repair() {
+    if (!recovered_) {
+        return is_open();
+    }
+    const std::string path = path_;
+    const uint64_t records_end = records_end_;
+    const std::vector<uint8_t> tail = rebuilt_.finish(records_end);
+    close(); // the file shrinks under the mapping
+
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CLOEXEC);
+    bool ok = fd >= 0 && ::ftruncate(fd, static_cast<off_t>(records_end)) == 0;
+    size_t done = 0;
+    while (ok && done < tail.size()) {
+        const ssize_t n = ::pwrite(fd, tail.data() + done, tail.size() - done,
+                                   static_cast<off_t>(records_end + done));
+        if (n < 0 && errno != EINTR) {
+            ok = false;
+        } else if (n > 0) {
+            done += static_cast<size_t>(n);
+        }
+    }
+    ok = ok && ::fdatasync(fd) == 0;
+    if (!ok) {
+        std::fprintf(stderr, "[Daedalus] Cannot repair session %s: %s\n", path.c_str(),
+                     std::strerror(errno));
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    return open(path) && ok;
+}
+
+std::optional<SessionReader::Record> SessionReader::read(uint64_t offset) const {
+    if (offset < records_begin_ || offset % kRecordAlignment != 0 ||
+        offset + sizeof(RecordHeader) > records_end_) {
+        return std::nullopt;
+    }
+    RecordHeader header{};
+    std::memcpy(&header, data_ + offset, sizeof(header));
+    if (header.kind < static_cast<uint32_t>(RecordKind::Text) ||
+        header.kind > static_cast<uint32_t>(RecordKind::Index) ||
+        record_bytes(header.size) > records_end_ - offset) {
+        return std::nullopt;
+    }
+    return Record{static_cast<RecordKind>(header.kind), offset, header.received_ns,
+                  {data_ + offset + sizeof(header), header.size}};
+}
+
+uint32_t SessionReader::segments() const {
+    return index_.empty() ? 0 : index_.back().segment + 1;
+}
+
+uint32_t SessionReader::segment_at(uint64_t offset) const {
+    const auto it =
+        std::upper_bound(index_.begin(), index_.end(), offset,
+                         [](uint64_t o, const IndexEntry &e) { return o < e.offset; });
+    return it == index_.begin() ? 0 : (it - 1)->segment;
+}
+
+std::span<const IndexEntry> SessionReader::segment_entries(uint32_t segment) const {
+    const auto first = std::partition_point(
+        index_.begin(), index_.end(), [&](const IndexEntry &e) { return e.segment < segment; });
+    const auto last = std::partition_point(
+        first, index_.end(), [&](const IndexEntry &e) { return e.segment == segment; });
+    return {first, last};
+}
+
+const IndexEntry *SessionReader::seek_time(double time, uint32_t segment) const {
+    const auto entries = segment_entries(segment);
+    if (entries.empty()) {
+        return nullptr;
+    }
+    const auto it = std::upper_bound(entries.begin(), entries.end(), time,
+                                     [](double t, const IndexEntry &e) { return t < e.time; });
+    return it == entries.begin() ? &entries.front() : &*(it - 1);
+}
+
+const IndexEntry *SessionReader::seek_frame(uint64_t frame, uint32_t segment) const {
+    const auto entries = segment_entries(segment);
+    if (entries.empty()) {
+        return nullptr;
+    }
+    const auto it = std::upper_bound(entries.begin(), entries.end(), frame,
+                                     [](uint64_t f, const IndexEntry &e) { return f < e.frame; });
+    return it == entries.begin() ? &entries.front() : &*(it - 1);
+}
+
+} // namespace daedalus::record
@@ -0,0 +1,183 @@
+#include "daedalus/record/session_recorder.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <span>
+#include <unistd.h>
+
+namespace daedalus::record {
+
+SessionRecorder::SessionRecorder(Options options)
+    : options_(options), ring_(options.ring_bytes) {}
+
+SessionRecorder::~SessionRecorder() { stop(); }
+
+bool SessionRecorder::start(const std::string &path) {
+    if (fd_ >= 0 || thread_.joinable() || !path_.empty()) {
+        return false; // one recording per recorder
+    }
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        std::fprintf(stderr, "[Daedalus] Cannot record to %s: %s\n", path.c_str(),
+                     std::strerror(errno));
+        return false;
+    }
+    path_ = path;
+
+    SessionFileHeader header{};
+    std::memcpy(header.magic, kSessionMagic, sizeof(header.magic));
+    header.version = kSessionVersion;
+    header.header_bytes = sizeof(SessionFileHeader);
+    header.created_unix_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count());
+    const auto *bytes = reinterpret_cast<const uint8_t *>(&header);
+    pending_.reserve(options_.write_chunk);
+    pending_.assign(bytes, bytes + sizeof(header));
+    if (!write_out()) {
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+    file_offset_ = sizeof(header);
+
+    started_at_ = std::chrono::steady_clock::now();
+    thread_ = std::jthread([this](std::stop_token stop) { run(stop); });
+    recording_.store(true, std::memory_order_release);
+    return true;
+}
+
+void SessionRecorder::stop() {
+    recording_.store(false, std::memory_order_release);
+    if (thread_.joinable()) {
+        thread_.request_stop();
+        thread_.join();
+    }
+    if (fd_ >= 0) {
+        // Close the file with its index; without it, the reader rebuilds one.
+        if (!failed_.load(std::memory_order_relaxed)) {
+            pending_ = indexer_.finish(file_offset_);
+            if (!write_out()) {
+                failed_.store(true, std::memory_order_relaxed);
+            }
+        }
+        if (::fdatasync(fd_) == 0) {
+            syncs_.fetch_add(1, std::memory_order_relaxed);
+        }
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool SessionRecorder::record_text(std::string_view text) {
+    return record(RecordKind::Text, reinterpret_cast<const uint8_t *>(text.data()), text.size());
+}
+
+bool SessionRecorder::record_frame(const uint8_t *data, size_t len) {
+    return record(RecordKind::Frame, data, len);
+}
+
+bool SessionRecorder::record(RecordKind kind, const uint8_t *data, size_t len) {
+    if (!recording_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    // The ring record is the file record: header, payload and zeroed padding.
+    const size_t footprint = record_bytes(len);
+    uint8_t *out = failed_.load(std::memory_order_relaxed) ? nullptr : ring_.try_reserve(footprint);
+    if (out == nullptr) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    const RecordHeader header{
+        static_cast<uint32_t>(kind), static_cast<uint32_t>(len),
+        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  std::chrono::steady_clock::now() - started_at_)
+                                  .count())};
+    std::memcpy(out, &header, sizeof(header));
+    if (len > 0) {
+        std::memcpy(out + sizeof(header), data, len);
+    }
+    std::memset(out + sizeof(header) + len, 0, footprint - sizeof(header) - len);
+    ring_.commit_write(footprint);
+    records_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void SessionRecorder::run(const std::stop_token &stop) {
+    auto last_sync = std::chrono::steady_clock::now();
+    std::span<const uint8_t> record;
+    for (;;) {
+        // Gather up to one chunk, then hand it to the kernel in one write().
+        bool drained = false;
+        while (pending_.size() < options_.write_chunk) {
+            if (!ring_.try_read(record)) {
+                drained = true;
+                break;
+            }
+            RecordHeader header{};
+            std::memcpy(&header, record.data(), sizeof(header));
+            indexer_.add(file_offset_, static_cast<RecordKind>(header.kind),
+                         record.subspan(sizeof(header), header.size));
+            file_offset_ += record.size();
+            pending_.insert(pending_.end(), record.begin(), record.end());
+            ring_.commit_read();
+        }
+        if (failed_.load(std::memory_order_relaxed)) {
+            pending_.clear(); // keep draining so the ring does not stay full
+        } else if (!pending_.empty() && !write_out()) {
+            failed_.store(true, std::memory_order_relaxed);
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now - last_sync >= options_.sync_interval) {
+            if (::fdatasync(fd_) == 0) {
+                syncs_.fetch_add(1, std::memory_order_relaxed);
+            }
+            last_sync = now;
+        }
+        if (drained) {
+            if (stop.stop_requested()) {
+                // recording_ went false before the stop request, so this drained
+                // everything but a record caught mid-copy by stop().
+                return;
+            }
+            std::this_thread::sleep_for(kIdleWait);
+        }
+    }
+}
+
+bool SessionRecorder::write_out() {
+    size_t done = 0;
+    while (done < pending_.size()) {
+        const ssize_t n = ::write(fd_, pending_.data() + done, pending_.size() - done);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::fprintf(stderr, "[Daedalus] Recording to %s failed: %s\n", path_.c_str(),
+                         std::strerror(errno));
+            pending_.clear();
+            return false;
+        }
+        done += static_cast<size_t>(n);
+    }
+    bytes_written_.fetch_add(done, std::memory_order_relaxed);
+    pending_.clear();
+    return true;
+}
+
+RecorderStats SessionRecorder::stats() const {
+    RecorderStats stats;
+    stats.records = records_.load(std::memory_order_relaxed);
+    stats.bytes_written = bytes_written_.load(std::memory_order_relaxed);
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    stats.syncs = syncs_.load(std::memory_order_relaxed);
+    stats.failed = failed_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace daedalus::record
@@ -0,0 +1,176 @@
+#include "daedalus/record/session_replay.hpp"
+
+#include "daedalus/protocol/events.hpp"
+
+#include <algorithm>
+#include <string_view>
+#include <utility>
+#include <variant>
+
+namespace daedalus::record {
+
+SessionReplay::SessionReplay(std::string path, double speed)
+    : path_(std::move(path)), speed_(speed) {}
+
+SessionReplay::~SessionReplay() { disconnect(); }
+
+void SessionReplay::connect() {
+    if (thread_.joinable()) {
+        return;
+    }
+    // No replay thread yet, so this thread is the producer until it starts.
+    if (!reader_.open(path_)) {
+        state_.store(protocol::ConnectionState::Error, std::memory_order_relaxed);
+        deliver_event(protocol::StateChange{protocol::ConnectionState::Error,
+                                            "cannot read " + path_});
+        return;
+    }
+    end_time_ = reader_.last_time();
+    position_.store(0.0, std::memory_order_relaxed);
+    frames_played_.store(0, std::memory_order_relaxed);
+    finished_.store(false, std::memory_order_relaxed);
+    seek_pending_.store(false, std::memory_order_relaxed);
+    paused_.store(false, std::memory_order_relaxed);
+    anchored_ = false;
+    state_.store(protocol::ConnectionState::Connected, std::memory_order_relaxed);
+    thread_ = std::jthread([this](std::stop_token stop) { run(stop); });
+}
+
+void SessionReplay::disconnect() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    thread_.request_stop();
+    thread_.join();
+    flush();
+    reader_.close();
+    state_.store(protocol::ConnectionState::Disconnected, std::memory_order_relaxed);
+    deliver_event(protocol::StateChange{protocol::ConnectionState::Disconnected, {}});
+}
+
+void SessionReplay::seek(double time) {
+    seek_time_.store(time, std::memory_order_relaxed);
+    seek_pending_.store(true, std::memory_order_release);
+}
+
+void SessionReplay::run(const std::stop_token &stop) {
+    begin_stream();
+    deliver_event(protocol::StateChange{protocol::ConnectionState::Connected, {}});
+    uint64_t offset = reader_.records_begin();
+    while (!stop.stop_requested()) {
+        if (seek_pending_.exchange(false, std::memory_order_acq_rel)) {
+            // Times restart with each run; stay in the one being played.
+            const IndexEntry *entry = reader_.seek_time(seek_time_.load(std::memory_order_relaxed),
+                                                        reader_.segment_at(offset));
+            if (entry != nullptr) {
+                offset = start_at(*entry);
+            }
+            continue;
+        }
+        if (paused_.load(std::memory_order_acquire)) {
+            anchored_ = false; // resume plays on from here, not to catch up
+            std::this_thread::sleep_for(kIdleWait);
+            continue;
+        }
+        const auto record = reader_.read(offset);
+        if (!record) {
+            if (!finished_.load(std::memory_order_relaxed)) {
+                flush();
+                finished_.store(true, std::memory_order_release);
+            }
+            std::this_thread::sleep_for(kIdleWait); // a seek may still come
+            continue;
+        }
+        if (record->kind == RecordKind::Text) {
+            deliver_text(offset);
+        } else if (record->kind == RecordKind::Frame) {
+            if (!wait_until_due(*record, stop) || !wait_for_room(stop)) {
+                continue; // interrupted; look again at the same record
+            }
+            if (deliver_frame(record->payload.data(), record->payload.size())) {
+                frames_played_.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (const auto info = frame_info(record->payload)) {
+                position_.store(info->time, std::memory_order_relaxed);
+            }
+        }
+        offset = record->next();
+    }
+}
+
+uint64_t SessionReplay::start_at(const IndexEntry &entry) {
+    flush();
+    begin_stream();
+    if (entry.schema_offset != kNoRecord) {
+        deliver_text(entry.schema_offset);
+    }
+    if (entry.ack_offset != kNoRecord) {
+        deliver_text(entry.ack_offset);
+    }
+    anchored_ = false;
+    position_.store(entry.time, std::memory_order_relaxed);
+    finished_.store(false, std::memory_order_release);
+    return entry.offset;
+}
+
+void SessionReplay::deliver_text(uint64_t offset) {
+    const auto record = reader_.read(offset);
+    if (!record) {
+        return;
+    }
+    auto event = protocol::parse_control_event(std::string_view(
+        reinterpret_cast<const char *>(record->payload.data()), record->payload.size()));
+    if (!event) {
+        return;
+    }
+    if (std::holds_alternative<protocol::SubscribeAck>(*event)) {
+        // Like the server: no frames until the consumer has set up and resumes.
+        // Paused before the ack is queued, so its resume() cannot come first.
+        paused_.store(true, std::memory_order_release);
+    }
+    deliver_event(std::move(*event));
+}
+
+bool SessionReplay::wait_until_due(const SessionReader::Record &record,
+                                   const std::stop_token &stop) {
+    const double speed = speed_.load(std::memory_order_relaxed);
+    if (speed <= kMaxSpeed) {
+        anchored_ = false;
+        return true;
+    }
+    if (!anchored_ || speed != anchor_speed_ || record.received_ns < anchor_received_) {
+        anchored_ = true;
+        anchor_speed_ = speed;
+        anchor_wall_ = std::chrono::steady_clock::now();
+        anchor_received_ = record.received_ns;
+        return true;
+    }
+    const auto due =
+        anchor_wall_ + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                           std::chrono::duration<double, std::nano>(
+                               static_cast<double>(record.received_ns - anchor_received_) /
+                               speed));
+    for (auto now = std::chrono::steady_clock::now(); now < due;
+         now = std::chrono::steady_clock::now()) {
+        if (stop.stop_requested() || paused_.load(std::memory_order_acquire) ||
+            seek_pending_.load(std::memory_order_acquire) ||
+            speed_.load(std::memory_order_relaxed) != speed) {
+            return false;
+        }
+        std::this_thread::sleep_for(
+            std::min<std::chrono::steady_clock::duration>(due - now, kIdleWait));
+    }
+    return true;
+}
+
+bool SessionReplay::wait_for_room(const std::stop_token &stop) {
+    while (telemetry_queue().size_approx() >= telemetry_queue().capacity()) {
+        if (stop.stop_requested()) {
+            return false;
+        }
+        std::this_thread::sleep_for(kIdleWait);
+    }
+    return true;
+}
+
+} // namespace daedalus::record
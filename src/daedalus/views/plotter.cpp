@@ -15,10 +15,13 @@ namespace daedalus::views {
 
 namespace {
 
-struct GetterContext {
-    const data::SignalBuffer *buffer = nullptr;
-    size_t start_index = 0;
-};
+/// Points per pixel column when drawing a decimated series (one min, one max).
+constexpr float kPointsPerPixel = 2.0f;
+/// Point budget when scanning archived history for Y auto-fit. Decimation keeps
+/// every extreme, so this bounds the cost without changing the fitted range.
+constexpr size_t kAutoFitPoints = 4096;
+/// Widest live window; older data is served from the decimated archive.
+constexpr float kMaxHistorySeconds = 7200.0f;
 
 struct VisibleStats {
     double min_value = 0.0;
@@ -29,12 +32,12 @@ struct VisibleStats {
 };
 
 ImPlotPoint signal_getter(int idx, void *user_data) {
-    auto *ctx = static_cast<GetterContext *>(user_data);
-    const size_t logical_index = ctx->start_index + static_cast<size_t>(idx);
-    return ImPlotPoint(ctx->buffer->time_at(logical_index), ctx->buffer->value_at(logical_index));
+    const auto *series = static_cast<const data::DecimatedSeries *>(user_data);
+    const auto i = static_cast<size_t>(idx);
+    return ImPlotPoint(series->time_at(i), series->value_at(i));
 }
 
-double interpolate_at_time(const data::SignalBuffer &buffer, double time) {
+double interpolate_at_time(const data::SignalView &buffer, double time) {
     if (buffer.empty()) {
         return 0.0;
     }
@@ -62,7 +65,7 @@ double interpolate_at_time(const data::SignalBuffer &buffer, double time) {
     return v0 + alpha * (v1 - v0);
 }
 
-VisibleStats compute_visible_stats(const data::SignalBuffer &buffer, double x_min, double x_max) {
+VisibleStats compute_visible_stats(const data::SignalView &buffer, double x_min, double x_max) {
     VisibleStats stats{};
     if (buffer.empty()) {
         return stats;
@@ -74,19 +77,10 @@ VisibleStats compute_visible_stats(const data::SignalBuffer &buffer, double x_mi
         count = buffer.size();
     }
 
-    double min_value = std::numeric_limits<double>::infinity();
-    double max_value = -std::numeric_limits<double>::infinity();
-    double sum = 0.0;
-    for (size_t i = 0; i < count; ++i) {
-        const double value = buffer.value_at(start + i);
-        min_value = std::min(min_value, value);
-        max_value = std::max(max_value, value);
-        sum += value;
-    }
-
-    stats.min_value = min_value;
-    stats.max_value = max_value;
-    stats.mean_value = sum / static_cast<double>(count);
+    const data::RangeStats range = data::range_stats(buffer, start, count);
+    stats.min_value = range.min;
+    stats.max_value = range.max;
+    stats.mean_value = range.mean();
     stats.current_value = buffer.last_value();
     stats.valid = true;
     return stats;
@@ -102,8 +96,7 @@ ImPlotAxisFlags make_axis_flags(bool auxiliary_axis) {
 
 std::optional<std::pair<double, double>>
 compute_axis_visible_range(const PlotPanel &panel, ImAxis axis,
-                           const std::map<size_t, data::SignalBuffer> &signal_buffers, double x_min,
-                           double x_max) {
+                           const data::StoreSnapshot &history, double x_min, double x_max) {
     bool found = false;
     double min_value = std::numeric_limits<double>::infinity();
     double max_value = -std::numeric_limits<double>::infinity();
@@ -112,19 +105,31 @@ compute_axis_visible_range(const PlotPanel &panel, ImAxis axis,
         if (sig.y_axis != axis) {
             continue;
         }
-        const auto it = signal_buffers.find(sig.buffer_index);
-        if (it == signal_buffers.end() || it->second.empty()) {
+        const auto *series = history.find(sig.buffer_index);
+        if (series == nullptr || series->empty()) {
             continue;
         }
 
-        const auto &buffer = it->second;
-        auto [start, count] = buffer.visible_range(x_min, x_max);
-        if (count == 0) {
-            start = 0;
-            count = buffer.size();
+        // Windows inside the full-rate samples use the pyramid's range aggregate;
+        // older ones only exist as decimated archive buckets.
+        const bool archived = series->lod().levels() > 0 && series->end() > series->size() &&
+                              x_min < series->time_at(0);
+        if (!archived) {
+            auto [start, count] = series->visible_range(x_min, x_max);
+            if (count == 0) {
+                start = 0;
+                count = series->size();
+            }
+            const data::RangeStats range = data::range_stats(*series, start, count);
+            min_value = std::min(min_value, range.min);
+            max_value = std::max(max_value, range.max);
+            found = true;
+            continue;
         }
-        for (size_t i = 0; i < count; ++i) {
-            const double v = buffer.value_at(start + i);
+
+        const data::DecimatedSeries decimated(*series, x_min, x_max, kAutoFitPoints);
+        for (size_t i = 0; i < decimated.size(); ++i) {
+            const double v = decimated.value_at(i);
             min_value = std::min(min_value, v);
             max_value = std::max(max_value, v);
             found = true;
@@ -138,9 +143,8 @@ compute_axis_visible_range(const PlotPanel &panel, ImAxis axis,
 }
 
 void apply_auto_fit_limits(const PlotPanel &panel, ImAxis axis,
-                           const std::map<size_t, data::SignalBuffer> &signal_buffers, double x_min,
-                           double x_max) {
-    const auto range = compute_axis_visible_range(panel, axis, signal_buffers, x_min, x_max);
+                           const data::StoreSnapshot &history, double x_min, double x_max) {
+    const auto range = compute_axis_visible_range(panel, axis, history, x_min, x_max);
     if (!range.has_value()) {
         return;
     }
@@ -233,7 +237,7 @@ void PlotManager::set_current_time(double time) { current_time_ = time; }
 
 double PlotManager::current_time() const { return current_time_; }
 
-void PlotManager::render(const std::map<size_t, data::SignalBuffer> &signal_buffers) {
+void PlotManager::render(const data::StoreSnapshot &history) {
     if (panels_.empty()) {
         return;
     }
@@ -252,7 +256,7 @@ void PlotManager::render(const std::map<size_t, data::SignalBuffer> &signal_buff
             ImGui::TableSetColumnIndex(static_cast<int>(i % static_cast<size_t>(column_count)));
 
             bool request_close = false;
-            render_panel(i, panels_[i], signal_buffers, request_close);
+            render_panel(i, panels_[i], history, request_close);
             if (request_close) {
                 panels_to_remove.push_back(i);
             }
@@ -274,8 +278,8 @@ void PlotManager::render_toolbar() {
     ImGui::SameLine();
 
     ImGui::SetNextItemWidth(180.0f);
-    if (ImGui::SliderFloat("History (s)", &global_history_seconds_, 1.0f, 60.0f, "%.1f",
-                           ImGuiSliderFlags_Logarithmic)) {
+    if (ImGui::SliderFloat("History (s)", &global_history_seconds_, 1.0f, kMaxHistorySeconds,
+                           "%.1f", ImGuiSliderFlags_Logarithmic)) {
         for (auto &panel : panels_) {
             panel.history_seconds = global_history_seconds_;
         }
@@ -367,6 +371,15 @@ bool PlotManager::add_signal_to_active_or_new_panel(size_t buffer_index, const s
 
 std::optional<size_t> PlotManager::active_panel_index() const { return active_panel_index_; }
 
+bool PlotManager::is_plotted(size_t buffer_index) const {
+    return std::any_of(panels_.begin(), panels_.end(), [buffer_index](const PlotPanel &panel) {
+        return std::any_of(panel.signals.begin(), panel.signals.end(),
+                           [buffer_index](const PlottedSignal &signal) {
+                               return signal.buffer_index == buffer_index;
+                           });
+    });
+}
+
 std::string PlotManager::derive_axis_label(const PlotPanel &panel, ImAxis axis,
                                            const char *fallback) const {
     if (!signal_unit_lookup_) {
@@ -398,8 +411,7 @@ std::string PlotManager::derive_axis_label(const PlotPanel &panel, ImAxis axis,
 }
 
 void PlotManager::render_panel(size_t index, PlotPanel &panel,
-                               const std::map<size_t, data::SignalBuffer> &signal_buffers,
-                               bool &request_close) {
+                               const data::StoreSnapshot &history, bool &request_close) {
     ImGui::PushID(panel.id.c_str());
     ImGui::Text("%s (%zu signals)", panel.title.c_str(), panel.signals.size());
     if (ImGui::IsItemClicked()) {
@@ -415,7 +427,7 @@ void PlotManager::render_panel(size_t index, PlotPanel &panel,
     ImGui::Checkbox("Live", &panel.live_mode);
     ImGui::SameLine();
     ImGui::SetNextItemWidth(130.0f);
-    ImGui::SliderFloat("Window (s)", &panel.history_seconds, 1.0f, 60.0f, "%.1f",
+    ImGui::SliderFloat("Window (s)", &panel.history_seconds, 1.0f, kMaxHistorySeconds, "%.1f",
                        ImGuiSliderFlags_Logarithmic);
     ImGui::SameLine();
     ImGui::SetNextItemWidth(110.0f);
@@ -451,13 +463,13 @@ void PlotManager::render_panel(size_t index, PlotPanel &panel,
             ImPlot::SetupAxisLimits(ImAxis_X1, x_min, x_max, ImPlotCond_Always);
         }
         if (panel.auto_fit_y1) {
-            apply_auto_fit_limits(panel, ImAxis_Y1, signal_buffers, x_min, x_max);
+            apply_auto_fit_limits(panel, ImAxis_Y1, history, x_min, x_max);
         }
         if (panel.show_y2 && panel.auto_fit_y2) {
-            apply_auto_fit_limits(panel, ImAxis_Y2, signal_buffers, x_min, x_max);
+            apply_auto_fit_limits(panel, ImAxis_Y2, history, x_min, x_max);
         }
         if (panel.show_y3 && panel.auto_fit_y3) {
-            apply_auto_fit_limits(panel, ImAxis_Y3, signal_buffers, x_min, x_max);
+            apply_auto_fit_limits(panel, ImAxis_Y3, history, x_min, x_max);
         }
 
         ImPlot::SetupFinish();
@@ -471,22 +483,18 @@ void PlotManager::render_panel(size_t index, PlotPanel &panel,
         plot_size = ImPlot::GetPlotSize();
 
         for (const auto &sig : panel.signals) {
-            const auto it = signal_buffers.find(sig.buffer_index);
-            if (it == signal_buffers.end() || it->second.empty()) {
+            const auto *series = history.find(sig.buffer_index);
+            if (series == nullptr || series->empty()) {
                 continue;
             }
 
-            const auto &buffer = it->second;
-            auto [visible_start, visible_count] = buffer.visible_range(x_min, x_max);
-            if (visible_count == 0) {
-                visible_start = 0;
-                visible_count = buffer.size();
-            }
-
-            GetterContext ctx{&buffer, visible_start};
+            // Draw cost follows the plot width, not the number of samples in view, and
+            // windows reaching past the full-rate history fall back to the archive.
+            const auto max_points = static_cast<size_t>(plot_size.x * kPointsPerPixel);
+            data::DecimatedSeries decimated(*series, x_min, x_max, max_points);
             ImPlot::SetAxes(ImAxis_X1, sig.y_axis);
-            ImPlot::PlotLineG(sig.label.c_str(), signal_getter, &ctx,
-                              static_cast<int>(visible_count));
+            ImPlot::PlotLineG(sig.label.c_str(), signal_getter, &decimated,
+                              static_cast<int>(decimated.size()));
             signal_colors[sig.buffer_index] = ImPlot::GetLastItemColor();
         }
 
@@ -504,11 +512,11 @@ void PlotManager::render_panel(size_t index, PlotPanel &panel,
                          panel.cursor_time);
 
             for (const auto &sig : panel.signals) {
-                const auto it = signal_buffers.find(sig.buffer_index);
-                if (it == signal_buffers.end() || it->second.empty()) {
+                const auto *series = history.find(sig.buffer_index);
+                if (series == nullptr || series->empty()) {
                     continue;
                 }
-                const double interpolated = interpolate_at_time(it->second, panel.cursor_time);
+                const double interpolated = interpolate_at_time(*series, panel.cursor_time);
                 const auto color_it = signal_colors.find(sig.buffer_index);
                 const ImVec4 annotation_color = color_it != signal_colors.end()
                                                     ? color_it->second
@@ -558,7 +566,7 @@ void PlotManager::render_panel(size_t index, PlotPanel &panel,
     }
 
     if (panel.show_stats && plot_size.x > 0.0f && plot_size.y > 0.0f) {
-        render_statistics_overlay(panel, plot_pos, plot_size, signal_buffers, x_min, x_max);
+        render_statistics_overlay(panel, plot_pos, plot_size, history, x_min, x_max);
     }
 
     const float splitter_height = 8.0f;
@@ -633,7 +641,7 @@ void PlotManager::render_panel_context_menu(PlotPanel &panel, bool &request_clos
 
 void PlotManager::render_statistics_overlay(
     const PlotPanel &panel, const ImVec2 &plot_pos, const ImVec2 &plot_size,
-    const std::map<size_t, data::SignalBuffer> &signal_buffers, double x_min, double x_max) {
+    const data::StoreSnapshot &history, double x_min, double x_max) {
     ImGui::SetNextWindowPos(ImVec2(plot_pos.x + plot_size.x - 12.0f, plot_pos.y + 12.0f),
                             ImGuiCond_Always, ImVec2(1.0f, 0.0f));
     ImGui::SetNextWindowBgAlpha(0.35f);
@@ -649,12 +657,12 @@ void PlotManager::render_statistics_overlay(
     }
 
     for (const auto &sig : panel.signals) {
-        const auto it = signal_buffers.find(sig.buffer_index);
-        if (it == signal_buffers.end() || it->second.empty()) {
+        const auto *series = history.find(sig.buffer_index);
+        if (series == nullptr || series->empty()) {
             continue;
         }
 
-        const VisibleStats stats = compute_visible_stats(it->second, x_min, x_max);
+        const VisibleStats stats = compute_visible_stats(*series, x_min, x_max);
         if (!stats.valid) {
             continue;
         }
@@ -0,0 +1,79 @@
+// Synthetic Hermes server: a stand-in simulation for load testing the client.
+//
+// Usage: synthetic_hermes [--port 8765] [--modules 4] [--signals 25] [--rate 1000]
+//                         [--burst FRAMES] [--gap-every FRAMES] [--gap-frames N]
+//                         [--frames N]
+// --rate 0 streams as fast as the client takes frames. Runs until interrupted.
+
+#include "daedalus/loadgen/synthetic_hermes.hpp"
+
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <thread>
+
+namespace {
+
+volatile std::sig_atomic_t g_interrupted = 0;
+
+extern "C" void on_interrupt(int /*signal*/) { g_interrupted = 1; }
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    daedalus::loadgen::LoadProfile profile;
+    int port = 8765;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "Ignoring argument: %s\n", argv[i]);
+            break;
+        }
+        const char *value = argv[++i];
+        if (arg == "--port") {
+            port = std::atoi(value);
+        } else if (arg == "--modules") {
+            profile.modules = std::strtoull(value, nullptr, 10);
+        } else if (arg == "--signals") {
+            profile.signals_per_module = std::strtoull(value, nullptr, 10);
+        } else if (arg == "--rate") {
+            profile.rate_hz = std::strtod(value, nullptr);
+            profile.sim_rate_hz = profile.rate_hz > 0.0 ? profile.rate_hz : 1000.0;
+        } else if (arg == "--burst") {
+            profile.burst_frames = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (arg == "--gap-every") {
+            profile.gap_every = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (arg == "--gap-frames") {
+            profile.gap_frames = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (arg == "--frames") {
+            profile.max_frames = std::strtoull(value, nullptr, 10);
+        } else {
+            std::fprintf(stderr, "Ignoring argument: %s\n", argv[i - 1]);
+        }
+    }
+
+    daedalus::loadgen::SyntheticHermes server(profile, port);
+    if (!server.start()) {
+        return 1;
+    }
+    std::printf("Synthetic Hermes on %s: %zu modules x %zu signals at %.0f Hz\n",
+                server.url().c_str(), profile.modules, profile.signals_per_module,
+                profile.rate_hz);
+    std::signal(SIGINT, on_interrupt);
+    std::signal(SIGTERM, on_interrupt);
+
+    uint64_t last_frames = 0;
+    while (g_interrupted == 0) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        const uint64_t frames = server.frames_sent();
+        std::printf("%zu clients, %llu frames/s, %.1f MB sent\n", server.clients(),
+                    static_cast<unsigned long long>(frames - last_frames),
+                    static_cast<double>(server.bytes_sent()) / (1024.0 * 1024.0));
+        std::fflush(stdout);
+        last_frames = frames;
+    }
+    server.stop();
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include "daedalus/data/buffer_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace daedalus::data;
+
+namespace {
+
+using BytePool = BufferPool<std::vector<uint8_t>>;
+
+std::vector<uint8_t> make_buffer() {
+    std::vector<uint8_t> buf;
+    buf.reserve(64);
+    return buf;
+}
+
+} // namespace
+
+TEST(BufferPool, PrewarmedBuffersAreNotCountedAsAllocations) {
+    BytePool pool(8, 4, make_buffer);
+    const auto stats = pool.stats();
+    EXPECT_EQ(stats.preallocated, 4u);
+    EXPECT_EQ(stats.allocations, 0u);
+
+    for (int i = 0; i < 4; ++i) {
+        auto buf = pool.acquire();
+        EXPECT_GE(buf.capacity(), 64u);
+    }
+    EXPECT_EQ(pool.stats().reuses, 4u);
+    EXPECT_EQ(pool.stats().allocations, 0u);
+}
+
+TEST(BufferPool, AcquireAllocatesWhenEmpty) {
+    BytePool pool(8, 0, make_buffer);
+    auto buf = pool.acquire();
+    EXPECT_GE(buf.capacity(), 64u);
+    EXPECT_EQ(pool.stats().allocations, 1u);
+    EXPECT_EQ(pool.stats().reuses, 0u);
+}
+
+TEST(BufferPool, ReleasedBufferIsReused) {
+    BytePool pool(8, 0, make_buffer);
+    auto buf = pool.acquire();
+    buf.assign(32, 0xAB);
+    const uint8_t *storage = buf.data();
+
+    pool.release(std::move(buf));
+    EXPECT_EQ(pool.stats().releases, 1u);
+
+    auto again = pool.acquire();
+    EXPECT_EQ(again.data(), storage);
+    EXPECT_EQ(pool.stats().allocations, 1u);
+    EXPECT_EQ(pool.stats().reuses, 1u);
+}
+
+TEST(BufferPool, ReleaseDiscardsWhenFull) {
+    BytePool pool(2, 2, make_buffer);
+    pool.release(make_buffer());
+    EXPECT_EQ(pool.stats().discards, 1u);
+    EXPECT_EQ(pool.stats().releases, 0u);
+}
+
+TEST(BufferPool, ReclaimKeepsProducerSpare) {
+    BytePool pool(4, 0, make_buffer);
+    auto buf = pool.acquire();
+    const uint8_t *storage = buf.data();
+    pool.reclaim(std::move(buf));
+
+    auto again = pool.acquire();
+    EXPECT_EQ(again.data(), storage);
+    EXPECT_EQ(pool.stats().allocations, 1u);
+}
+
+TEST(BufferPool, NoteAllocationCountsGrowth) {
+    BytePool pool(4, 1, make_buffer);
+    auto buf = pool.acquire();
+    if (buf.capacity() < 1024) {
+        pool.note_allocation();
+    }
+    buf.resize(1024);
+    EXPECT_EQ(pool.stats().allocations, 1u);
+}
+
+TEST(BufferPool, SteadyStateRoundTripDoesNotAllocate) {
+    constexpr int kFrames = 20000;
+    SPSCQueue<std::vector<uint8_t>> queue(64);
+    BytePool pool(96, 96, make_buffer);
+
+    std::thread producer([&] {
+        for (int i = 0; i < kFrames; ++i) {
+            auto frame = pool.acquire();
+            frame.assign(16, static_cast<uint8_t>(i));
+            while (!queue.try_push(std::move(frame))) {
+                // spin
+            }
+        }
+    });
+
+    int received = 0;
+    std::vector<uint8_t> frame;
+    while (received < kFrames) {
+        if (queue.try_pop(frame)) {
+            EXPECT_EQ(frame[0], static_cast<uint8_t>(received));
+            ++received;
+            pool.release(std::move(frame));
+        }
+    }
+    producer.join();
+
+    const auto stats = pool.stats();
+    EXPECT_EQ(stats.allocations, 0u);
+    EXPECT_EQ(stats.reuses, static_cast<uint64_t>(kFrames));
+}
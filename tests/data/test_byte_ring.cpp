@@ -0,0 +1,148 @@
+#include "daedalus/data/byte_ring.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
+
+using namespace daedalus::data;
+
+namespace {
+
+std::vector<uint8_t> make_record(size_t size, uint8_t seed) {
+    std::vector<uint8_t> record(size);
+    for (size_t i = 0; i < size; ++i) {
+        record[i] = static_cast<uint8_t>(seed + i);
+    }
+    return record;
+}
+
+} // namespace
+
+TEST(ByteRing, PushReadCommit) {
+    ByteRing ring(256);
+    const auto record = make_record(13, 7);
+    EXPECT_TRUE(ring.try_push(record));
+
+    std::span<const uint8_t> view;
+    ASSERT_TRUE(ring.try_read(view));
+    EXPECT_EQ(std::vector<uint8_t>(view.begin(), view.end()), record);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(view.data()) % ByteRing::kAlignment, 0u);
+
+    // Still there until committed.
+    ASSERT_TRUE(ring.try_read(view));
+    EXPECT_EQ(view.size(), 13u);
+    ring.commit_read();
+    EXPECT_FALSE(ring.try_read(view));
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(ByteRing, CapacityRoundsUpToPowerOfTwo) {
+    EXPECT_EQ(ByteRing(100).capacity(), 128u);
+    EXPECT_EQ(ByteRing(1).capacity(), 64u);
+    EXPECT_EQ(ByteRing(4096).max_record_size(), 2048u - ByteRing::kHeaderBytes);
+}
+
+TEST(ByteRing, RejectsWhenFullOrTooBig) {
+    ByteRing ring(128);
+    EXPECT_FALSE(ring.try_push(make_record(ring.max_record_size() + 1, 0)));
+
+    const auto record = make_record(24, 0); // 32 bytes with its header
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring.try_push(record));
+    }
+    EXPECT_EQ(ring.used_bytes(), 128u);
+    EXPECT_FALSE(ring.try_push(record));
+    EXPECT_FALSE(ring.try_push({})); // an empty record still needs its header
+
+    std::span<const uint8_t> view;
+    ASSERT_TRUE(ring.try_read(view));
+    ring.commit_read();
+    EXPECT_TRUE(ring.try_push(record));
+}
+
+TEST(ByteRing, EmptyRecordsAreDelivered) {
+    ByteRing ring(64);
+    EXPECT_TRUE(ring.try_push({}));
+    std::span<const uint8_t> view;
+    ASSERT_TRUE(ring.try_read(view));
+    EXPECT_TRUE(view.empty());
+    ring.commit_read();
+    EXPECT_FALSE(ring.try_read(view));
+}
+
+TEST(ByteRing, RecordsNeverStraddleTheEnd) {
+    ByteRing ring(128);
+    const auto small = make_record(40, 1); // 48 bytes with its header
+    const auto large = make_record(48, 9); // 56 bytes
+
+    const uint8_t *base = ring.try_reserve(0) - ByteRing::kHeaderBytes; // not committed
+    std::span<const uint8_t> view;
+    for (int round = 0; round < 10; ++round) {
+        ASSERT_TRUE(ring.try_push(small));
+        ASSERT_TRUE(ring.try_push(large));
+        for (const auto *expected : {&small, &large}) {
+            ASSERT_TRUE(ring.try_read(view));
+            EXPECT_EQ(std::vector<uint8_t>(view.begin(), view.end()), *expected);
+            EXPECT_LE(static_cast<size_t>(view.data() - base) + view.size(), ring.capacity());
+            ring.commit_read();
+        }
+        EXPECT_TRUE(ring.empty());
+    }
+}
+
+TEST(ByteRing, ReserveWritesInPlaceAndCanTrim) {
+    ByteRing ring(256);
+    uint8_t *out = ring.try_reserve(64);
+    ASSERT_NE(out, nullptr);
+    for (int i = 0; i < 5; ++i) {
+        out[i] = static_cast<uint8_t>(100 + i);
+    }
+    ring.commit_write(5);
+    EXPECT_EQ(ring.used_bytes(), ByteRing::kHeaderBytes + 8);
+
+    std::span<const uint8_t> view;
+    ASSERT_TRUE(ring.try_read(view));
+    ASSERT_EQ(view.size(), 5u);
+    EXPECT_EQ(view.data(), out);
+    EXPECT_EQ(view[4], 104);
+    ring.commit_read();
+}
+
+TEST(ByteRing, MultithreadedStress) {
+    constexpr int kRecords = 100000;
+    ByteRing ring(4096);
+
+    std::thread producer([&] {
+        for (int i = 0; i < kRecords; ++i) {
+            // Sizes cycle through 0..199 bytes so wraps land at every offset.
+            const size_t size = static_cast<size_t>(i % 200);
+            uint8_t *out = nullptr;
+            while ((out = ring.try_reserve(size)) == nullptr) {
+                std::this_thread::yield();
+            }
+            for (size_t b = 0; b < size; ++b) {
+                out[b] = static_cast<uint8_t>(i + b);
+            }
+            ring.commit_write(size);
+        }
+    });
+
+    std::span<const uint8_t> view;
+    for (int expected = 0; expected < kRecords;) {
+        if (!ring.try_read(view)) {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_EQ(view.size(), static_cast<size_t>(expected % 200));
+        for (size_t b = 0; b < view.size(); ++b) {
+            ASSERT_EQ(view[b], static_cast<uint8_t>(expected + b));
+        }
+        ring.commit_read();
+        ++expected;
+    }
+    producer.join();
+    EXPECT_TRUE(ring.empty());
+}
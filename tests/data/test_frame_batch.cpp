@@ -0,0 +1,60 @@
+#include "daedalus/data/frame_batch.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace daedalus::data;
+
+TEST(FrameBatch, ResetSizesColumns) {
+    FrameBatch batch;
+    EXPECT_TRUE(batch.reset(3, 16));
+    EXPECT_EQ(batch.signal_count, 3u);
+    EXPECT_EQ(batch.row_capacity, 16u);
+    EXPECT_TRUE(batch.empty());
+    EXPECT_FALSE(batch.full());
+}
+
+TEST(FrameBatch, ResetReusesStorage) {
+    FrameBatch batch;
+    batch.reset(4, 32);
+    EXPECT_FALSE(batch.reset(4, 32));
+    EXPECT_FALSE(batch.reset(2, 16));
+    EXPECT_TRUE(batch.reset(8, 32));
+}
+
+TEST(FrameBatch, AppendIsColumnar) {
+    FrameBatch batch;
+    batch.reset(2, 4);
+    const std::vector<double> row0 = {1.0, 10.0};
+    const std::vector<double> row1 = {2.0, 20.0};
+    ASSERT_TRUE(batch.append(100, 0.0, row0));
+    ASSERT_TRUE(batch.append(101, 0.1, row1));
+
+    ASSERT_EQ(batch.rows, 2u);
+    EXPECT_EQ(batch.frame_column()[1], 101u);
+    EXPECT_DOUBLE_EQ(batch.time_column()[1], 0.1);
+    ASSERT_EQ(batch.column(0).size(), 2u);
+    EXPECT_DOUBLE_EQ(batch.column(0)[0], 1.0);
+    EXPECT_DOUBLE_EQ(batch.column(0)[1], 2.0);
+    EXPECT_DOUBLE_EQ(batch.column(1)[0], 10.0);
+    EXPECT_DOUBLE_EQ(batch.column(1)[1], 20.0);
+    EXPECT_DOUBLE_EQ(batch.last_time(), 0.1);
+}
+
+TEST(FrameBatch, AppendRejectsWhenFull) {
+    FrameBatch batch;
+    batch.reset(1, 2);
+    const std::vector<double> row = {1.0};
+    EXPECT_TRUE(batch.append(0, 0.0, row));
+    EXPECT_TRUE(batch.append(1, 0.1, row));
+    EXPECT_TRUE(batch.full());
+    EXPECT_FALSE(batch.append(2, 0.2, row));
+    EXPECT_EQ(batch.rows, 2u);
+}
+
+TEST(FrameBatch, AppendRejectsWrongWidth) {
+    FrameBatch batch;
+    batch.reset(3, 2);
+    const std::vector<double> row = {1.0, 2.0};
+    EXPECT_FALSE(batch.append(0, 0.0, row));
+    EXPECT_TRUE(batch.empty());
+}
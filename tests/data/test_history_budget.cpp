@@ -0,0 +1,93 @@
+#include "daedalus/data/history_budget.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <numeric>
+#include <vector>
+
+using namespace daedalus::data;
+
+namespace {
+
+constexpr size_t kMiB = size_t{1} << 20;
+
+void append_rows(SignalStore &store, size_t rows) {
+    FrameBatch batch;
+    batch.reset(store.signal_count(), rows);
+    const std::vector<double> row(store.signal_count(), 1.0);
+    for (size_t r = 0; r < rows; ++r) {
+        batch.append(r, static_cast<double>(r), row);
+    }
+    size_t done = 0;
+    while (done < batch.rows) {
+        done += store.append_rows(batch, done);
+    }
+}
+
+} // namespace
+
+TEST(HistoryBudget, PlanFitsBudgetAcrossSubscriptionWidths) {
+    const HistoryBudget budget(256 * kMiB);
+    for (const size_t signals : {90u, 2000u, 5000u}) {
+        const StoreGeometry geometry = budget.plan(signals);
+        auto store = std::make_shared<SignalStore>(signals, geometry);
+        EXPECT_LE(store->memory_bytes(), budget.budget_bytes()) << signals << " signals";
+        EXPECT_LE(store->fixed_bytes(), budget.budget_bytes() / 2 + signals * 64);
+        EXPECT_GE(geometry.column_capacity, SignalStore::kMinColumnCapacity);
+    }
+}
+
+TEST(HistoryBudget, WideSubscriptionsTradeArchiveAndGuardForSamples) {
+    const HistoryBudget budget(256 * kMiB);
+    const StoreGeometry narrow = budget.plan(90);
+    const StoreGeometry wide = budget.plan(5000);
+    EXPECT_EQ(narrow.archive_buckets, SignalStore::kDefaultArchiveBuckets);
+    EXPECT_EQ(wide.archive_buckets, HistoryBudget::kMinArchiveBuckets);
+    EXPECT_LE(wide.guard, narrow.guard);
+    EXPECT_LT(wide.capacity, narrow.capacity);
+    EXPECT_LE(narrow.capacity, HistoryBudget::kMaxCapacity);
+}
+
+TEST(HistoryBudget, AllocateFavoursPlottedAndActiveSignals) {
+    const HistoryBudget budget(32 * kMiB);
+    auto store = std::make_shared<SignalStore>(400, budget.plan(400));
+    std::vector<SignalDemand> demand(400, SignalDemand{false, 0.5});
+    demand[0] = {true, 1.0};
+    demand[1] = {false, 1.0};
+    demand[2] = {false, 0.0};
+
+    const std::vector<size_t> targets = budget.allocate(*store, demand);
+    EXPECT_GT(targets[0], targets[1]);
+    EXPECT_GT(targets[1], targets[3]);
+    EXPECT_GT(targets[3], targets[2]);
+    EXPECT_GE(targets[2], SignalStore::kMinColumnCapacity);
+
+    const size_t samples = std::accumulate(targets.begin(), targets.end(), size_t{0});
+    EXPECT_LE(store->fixed_bytes() + samples * sizeof(double), budget.budget_bytes());
+}
+
+TEST(HistoryBudget, AllocateCapsAtStoreCapacity) {
+    const HistoryBudget budget(256 * kMiB);
+    auto store = std::make_shared<SignalStore>(4, 1024, 64);
+    for (const size_t target : budget.allocate(*store, {})) {
+        EXPECT_EQ(target, 1024u);
+    }
+}
+
+TEST(HistoryBudget, RebalanceResizesOnNextAppendWithHysteresis) {
+    const HistoryBudget budget(32 * kMiB);
+    auto store = std::make_shared<SignalStore>(400, budget.plan(400));
+    std::vector<SignalDemand> demand(400, SignalDemand{false, 1.0});
+    demand[7].plotted = true;
+
+    EXPECT_GT(budget.rebalance(*store, demand), 0u);
+    const size_t before = store->column_capacity(7);
+    append_rows(*store, 1);
+    EXPECT_GT(store->column_capacity(7), before);
+    EXPECT_GT(store->column_bytes(7), store->column_bytes(8));
+    EXPECT_LE(store->memory_bytes(), budget.budget_bytes());
+
+    // Same demand again: every column is already within the hysteresis band.
+    EXPECT_EQ(budget.rebalance(*store, demand), 0u);
+}
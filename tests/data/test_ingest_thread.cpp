@@ -0,0 +1,101 @@
+#include "daedalus/data/ingest_thread.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace daedalus::data;
+
+namespace {
+
+FrameBatch make_batch(size_t signals, uint64_t first, size_t rows) {
+    FrameBatch batch;
+    batch.reset(signals, rows);
+    std::vector<double> row(signals, 1.0);
+    for (size_t r = 0; r < rows; ++r) {
+        batch.append(first + r, static_cast<double>(first + r), row);
+    }
+    return batch;
+}
+
+template <typename Pred> bool wait_for(Pred pred) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+struct IngestFixture : ::testing::Test {
+    TelemetryQueue queue{16};
+    BatchPool pool{32, 0, [] { return FrameBatch{}; }};
+    IngestThread ingest{queue, pool};
+};
+
+} // namespace
+
+TEST_F(IngestFixture, DrainsQueueIntoHistory) {
+    auto store = std::make_shared<SignalStore>(2, 64);
+    ingest.set_store(store);
+    ingest.start();
+
+    ASSERT_TRUE(queue.try_push(make_batch(2, 0, 5)));
+    ASSERT_TRUE(queue.try_push(make_batch(2, 5, 5)));
+    ASSERT_TRUE(wait_for([&] { return ingest.rows_ingested() == 10; }));
+    ingest.stop();
+
+    EXPECT_EQ(store->samples(), 10u);
+    const auto snap = store->snapshot();
+    EXPECT_DOUBLE_EQ(snap.last_time(), 9.0);
+    EXPECT_EQ(pool.stats().releases, 2u);
+    EXPECT_EQ(ingest.samples_ingested(), 20u);
+    EXPECT_EQ(ingest.ingest_latency().count(), 2u);
+}
+
+TEST_F(IngestFixture, DiscardsWithoutMatchingHistory) {
+    ingest.start();
+    ASSERT_TRUE(queue.try_push(make_batch(2, 0, 4)));
+    ASSERT_TRUE(wait_for([&] { return ingest.rows_discarded() == 4; }));
+
+    auto store = std::make_shared<SignalStore>(3, 64);
+    ingest.set_store(store);
+    ASSERT_TRUE(queue.try_push(make_batch(2, 4, 4))); // stale width
+    ASSERT_TRUE(queue.try_push(make_batch(3, 0, 4)));
+    ASSERT_TRUE(wait_for([&] { return ingest.rows_ingested() == 4; }));
+    ingest.stop();
+
+    EXPECT_EQ(ingest.rows_discarded(), 8u);
+    EXPECT_EQ(store->samples(), 4u);
+}
+
+TEST_F(IngestFixture, KeepsIngestingWhileReaderHoldsSnapshot) {
+    auto store = std::make_shared<SignalStore>(1, 32, 8);
+    ingest.set_store(store);
+    ingest.start();
+
+    auto snap = store->snapshot();
+    ASSERT_TRUE(queue.try_push(make_batch(1, 0, 4)));
+    ASSERT_TRUE(wait_for([&] { return ingest.rows_ingested() == 4; }));
+
+    // Beyond the guard band the writer waits for the snapshot to go.
+    ASSERT_TRUE(queue.try_push(make_batch(1, 4, 8)));
+    ASSERT_TRUE(wait_for([&] { return ingest.pinned_waits() > 0; }));
+    EXPECT_EQ(store->samples(), 8u);
+
+    snap = StoreSnapshot{};
+    ASSERT_TRUE(wait_for([&] { return ingest.rows_ingested() == 12; }));
+    ingest.stop();
+}
+
+TEST_F(IngestFixture, RunsIdleHookWhileQueueIsEmpty) {
+    std::atomic<int> idle{0};
+    ingest.set_idle_hook([&] { idle.fetch_add(1, std::memory_order_relaxed); });
+    ingest.start();
+    EXPECT_TRUE(wait_for([&] { return idle.load(std::memory_order_relaxed) >= 2; }));
+    ingest.stop();
+}
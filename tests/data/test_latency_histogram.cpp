@@ -0,0 +1,46 @@
+#include "daedalus/data/latency_histogram.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+using namespace daedalus::data;
+using std::chrono::microseconds;
+using std::chrono::nanoseconds;
+
+TEST(LatencyHistogram, EmptyReportsZero) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.quantile(0.5), nanoseconds(0));
+    EXPECT_EQ(histogram.max(), nanoseconds(0));
+}
+
+TEST(LatencyHistogram, QuantilesAreWithinOneBucket) {
+    LatencyHistogram histogram;
+    // 1..1000 µs, once each: p50 ≈ 500 µs, p99 ≈ 990 µs.
+    for (int us = 1; us <= 1000; ++us) {
+        histogram.record(microseconds(us));
+    }
+    EXPECT_EQ(histogram.count(), 1000u);
+    EXPECT_EQ(histogram.max(), microseconds(1000));
+
+    const auto p50 = histogram.quantile(0.5);
+    EXPECT_GE(p50, microseconds(500));
+    EXPECT_LE(p50, microseconds(500) * 9 / 8);
+    const auto p99 = histogram.quantile(0.99);
+    EXPECT_GE(p99, microseconds(990));
+    EXPECT_LE(p99, microseconds(1000)); // capped at the largest seen
+    EXPECT_EQ(histogram.quantile(1.0), microseconds(1000));
+    EXPECT_LE(histogram.quantile(0.0), nanoseconds(1125));
+}
+
+TEST(LatencyHistogram, KeepsSmallAndHugeValuesApart) {
+    LatencyHistogram histogram;
+    for (int i = 0; i < 99; ++i) {
+        histogram.record(nanoseconds(3));
+    }
+    histogram.record(std::chrono::hours(24));
+    histogram.record(nanoseconds(-5)); // clock skew: counts as zero
+    EXPECT_EQ(histogram.quantile(0.5), nanoseconds(3));
+    EXPECT_EQ(histogram.quantile(1.0), std::chrono::hours(24));
+}
@@ -0,0 +1,106 @@
+#include "daedalus/data/scan_kernels.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace daedalus::data;
+
+namespace {
+
+constexpr ScanIsa kIsas[] = {ScanIsa::Scalar, ScanIsa::Sse2, ScanIsa::Avx2};
+
+std::vector<double> random_values(size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-100.0, 100.0);
+    std::vector<double> values(n);
+    for (double &v : values) {
+        v = dist(rng);
+    }
+    return values;
+}
+
+} // namespace
+
+TEST(ScanKernels, DispatchFallsBackToSupportedIsa) {
+    EXPECT_TRUE(scan_isa_supported(ScanIsa::Scalar));
+    EXPECT_EQ(scan_kernels().isa, detected_scan_isa());
+    for (const ScanIsa isa : kIsas) {
+        EXPECT_LE(scan_kernels(isa).isa, isa);
+        EXPECT_TRUE(scan_isa_supported(scan_kernels(isa).isa)) << scan_isa_name(isa);
+    }
+}
+
+TEST(ScanKernels, StatsMatchScalarForEveryLength) {
+    for (const ScanIsa isa : kIsas) {
+        const ScanKernels &kernels = scan_kernels(isa);
+        for (size_t n = 0; n < 40; ++n) {
+            const auto values = random_values(n, static_cast<unsigned>(n));
+            const RangeStats stats = kernels.stats(values.data(), n);
+            ASSERT_EQ(stats.count, n);
+            if (n == 0) {
+                continue;
+            }
+            EXPECT_DOUBLE_EQ(stats.min, *std::min_element(values.begin(), values.end()));
+            EXPECT_DOUBLE_EQ(stats.max, *std::max_element(values.begin(), values.end()));
+            double sum = 0.0;
+            for (const double v : values) {
+                sum += v;
+            }
+            EXPECT_NEAR(stats.sum, sum, 1e-9) << scan_isa_name(kernels.isa) << " n=" << n;
+        }
+    }
+}
+
+TEST(ScanKernels, MinMaxSkipNaN) {
+    std::vector<double> values(19, 1.0);
+    values[0] = std::numeric_limits<double>::quiet_NaN();
+    values[5] = -3.0;
+    values[9] = std::numeric_limits<double>::quiet_NaN();
+    values[17] = 7.0;
+    for (const ScanIsa isa : kIsas) {
+        const RangeStats stats = scan_kernels(isa).stats(values.data(), values.size());
+        EXPECT_DOUBLE_EQ(stats.min, -3.0) << scan_isa_name(isa);
+        EXPECT_DOUBLE_EQ(stats.max, 7.0) << scan_isa_name(isa);
+        EXPECT_TRUE(std::isnan(stats.sum));
+    }
+}
+
+TEST(ScanKernels, FindCrossingReportsFirstSideChange) {
+    for (const ScanIsa isa : kIsas) {
+        const ScanKernels &kernels = scan_kernels(isa);
+        for (size_t at = 1; at < 23; ++at) {
+            std::vector<double> values(23, -1.0);
+            std::fill(values.begin() + static_cast<std::ptrdiff_t>(at), values.end(), 0.0);
+            EXPECT_EQ(kernels.find_crossing(values.data(), values.size(), 0.0), at)
+                << scan_isa_name(kernels.isa);
+        }
+        const std::vector<double> flat(23, 2.0);
+        EXPECT_EQ(kernels.find_crossing(flat.data(), flat.size(), 0.0), flat.size());
+        EXPECT_EQ(kernels.find_crossing(flat.data(), 0, 0.0), 0u);
+    }
+}
+
+TEST(ScanKernels, LowerBoundMatchesStd) {
+    std::vector<double> sorted = random_values(1000, 7);
+    std::sort(sorted.begin(), sorted.end());
+    sorted[500] = sorted[501] = sorted[502]; // duplicates
+    const double targets[] = {-200.0, sorted[0], sorted[502], sorted[999], 0.0, 200.0};
+    for (const ScanIsa isa : kIsas) {
+        const ScanKernels &kernels = scan_kernels(isa);
+        for (const size_t n : {size_t{0}, size_t{3}, size_t{33}, size_t{1000}}) {
+            for (const double target : targets) {
+                const auto last = sorted.begin() + static_cast<std::ptrdiff_t>(n);
+                const auto expected =
+                    static_cast<size_t>(std::lower_bound(sorted.begin(), last, target) -
+                                        sorted.begin());
+                EXPECT_EQ(kernels.lower_bound(sorted.data(), n, target), expected)
+                    << scan_isa_name(kernels.isa) << " n=" << n;
+            }
+        }
+    }
+}
@@ -0,0 +1,237 @@
+#include "daedalus/data/signal_lod.hpp"
+#include "daedalus/data/signal_store.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+using namespace daedalus::data;
+
+namespace {
+
+double sample_value(uint64_t frame) {
+    if (frame % 997 == 500) {
+        return 100.0; // Isolated spike that decimation must not lose.
+    }
+    return std::sin(static_cast<double>(frame) * 0.01);
+}
+
+std::shared_ptr<SignalStore>
+make_store(size_t capacity, uint64_t frames,
+           size_t archive_buckets = SignalStore::kDefaultArchiveBuckets) {
+    auto store = std::make_shared<SignalStore>(1, capacity, 64, archive_buckets);
+    FrameBatch batch;
+    uint64_t frame = 0;
+    while (frame < frames) {
+        batch.reset(1, 32);
+        for (size_t r = 0; r < 32 && frame < frames; ++r, ++frame) {
+            const double value[] = {sample_value(frame)};
+            batch.append(frame, static_cast<double>(frame) * 0.001, value);
+        }
+        size_t row = 0;
+        while (row < batch.rows) {
+            row += store->append_rows(batch, row);
+        }
+    }
+    return store;
+}
+
+} // namespace
+
+TEST(LodLayout, KeepsLevelsWhileTwoBucketsFit) {
+    EXPECT_EQ(LodLayout(8, 8, 0).levels(), 0u);
+    EXPECT_EQ(LodLayout(16, 8, 0).levels(), 1u);
+    const LodLayout layout(18000, 4096, 1024);
+    EXPECT_EQ(layout.levels(), 11u); // bucket widths 8 .. 8192
+    EXPECT_EQ(layout.offset(1), LodLayout::kEntryDoubles * layout.slots(0));
+}
+
+TEST(LodLayout, RetainsArchiveBucketsOnEveryLevel) {
+    // Independent of the full-rate window, which may differ per column.
+    const LodLayout layout(18000, 4096, 1024);
+    EXPECT_EQ(layout.readable(0), 1024u);
+    EXPECT_EQ(layout.readable(10), 1024u);
+    for (size_t level = 0; level < layout.levels(); ++level) {
+        // Room for the buckets the writer can complete inside its guard band.
+        EXPECT_GT(layout.slots(level), layout.readable(level) + (4096u >> LodLayout::shift(level)));
+    }
+}
+
+TEST(LodPyramid, MatchesBruteForceExtremesInOrder) {
+    auto store = make_store(1024, 5000);
+    const auto snap = store->snapshot();
+    const SignalView *view = snap.find(0);
+    ASSERT_NE(view, nullptr);
+    const LodColumn lod = view->lod();
+    ASSERT_GT(lod.levels(), 2u);
+
+    const uint64_t first = view->end() - view->size();
+    for (size_t level = 0; level < lod.levels(); ++level) {
+        const unsigned shift = LodLayout::shift(level);
+        for (uint64_t b = (first >> shift) + 1; b < view->end() >> shift; ++b) {
+            const size_t begin = static_cast<size_t>((b << shift) - first);
+            const size_t width = size_t{1} << shift;
+            size_t lo = begin;
+            size_t hi = begin;
+            for (size_t i = begin; i < begin + width; ++i) {
+                if (view->value_at(i) < view->value_at(lo)) {
+                    lo = i;
+                }
+                if (view->value_at(i) > view->value_at(hi)) {
+                    hi = i;
+                }
+            }
+            EXPECT_DOUBLE_EQ(lod.extreme(level, b, 0), view->value_at(std::min(lo, hi)));
+            EXPECT_DOUBLE_EQ(lod.extreme(level, b, 1), view->value_at(std::max(lo, hi)));
+            EXPECT_DOUBLE_EQ(lod.first_time(level, b), view->time_at(begin));
+            EXPECT_DOUBLE_EQ(lod.last_time(level, b), view->time_at(begin + width - 1));
+        }
+    }
+}
+
+TEST(DecimatedSeries, UsesRawSamplesWhenFewEnough) {
+    auto store = make_store(1024, 100);
+    const auto snap = store->snapshot();
+    const SignalView *view = snap.find(0);
+    ASSERT_NE(view, nullptr);
+
+    const auto [start, count] = view->visible_range(0.010, 0.059);
+    const DecimatedSeries series(*view, 0.010, 0.059, 64);
+    ASSERT_EQ(series.size(), count);
+    EXPECT_EQ(series.stride(), 1u);
+    EXPECT_FALSE(series.archived());
+    for (size_t i = 0; i < series.size(); ++i) {
+        EXPECT_DOUBLE_EQ(series.time_at(i), view->time_at(start + i));
+        EXPECT_DOUBLE_EQ(series.value_at(i), view->value_at(start + i));
+    }
+}
+
+TEST(DecimatedSeries, BoundsPointsAndKeepsPeaks) {
+    auto store = make_store(16384, 20000);
+    const auto snap = store->snapshot();
+    const SignalView *view = snap.find(0);
+    ASSERT_NE(view, nullptr);
+
+    constexpr size_t kMaxPoints = 600;
+    const double x_min = view->time_at(123);
+    const double x_max = view->time_at(view->size() - 78);
+    const auto [start, count] = view->visible_range(x_min, x_max);
+    const DecimatedSeries series(*view, x_min, x_max, kMaxPoints);
+    EXPECT_GT(series.stride(), 1u);
+    EXPECT_FALSE(series.archived());
+    // Whole buckets stay within budget; only the partial edge buckets are raw.
+    EXPECT_LE(series.size(), kMaxPoints + 2 * series.stride());
+
+    double raw_min = view->value_at(start);
+    double raw_max = raw_min;
+    for (size_t i = start; i < start + count; ++i) {
+        raw_min = std::min(raw_min, view->value_at(i));
+        raw_max = std::max(raw_max, view->value_at(i));
+    }
+    double min_value = series.value_at(0);
+    double max_value = min_value;
+    for (size_t i = 0; i < series.size(); ++i) {
+        min_value = std::min(min_value, series.value_at(i));
+        max_value = std::max(max_value, series.value_at(i));
+        if (i > 0) {
+            EXPECT_LE(series.time_at(i - 1), series.time_at(i));
+        }
+    }
+    EXPECT_DOUBLE_EQ(max_value, raw_max);
+    EXPECT_DOUBLE_EQ(min_value, raw_min);
+    EXPECT_DOUBLE_EQ(series.time_at(0), view->time_at(start));
+    EXPECT_DOUBLE_EQ(series.time_at(series.size() - 1), view->time_at(start + count - 1));
+}
+
+TEST(DecimatedSeries, ReadsArchiveBeyondFullRateWindow) {
+    // 256 full-rate samples; 64 buckets per level reach back 64 x 128 samples.
+    auto store = make_store(256, 6000, 64);
+    const size_t bytes = store->memory_bytes();
+    const auto snap = store->snapshot();
+    const SignalView *view = snap.find(0);
+    ASSERT_NE(view, nullptr);
+    ASSERT_GT(view->time_at(0), 5.0);
+
+    const DecimatedSeries series(*view, 0.0, view->last_time(), 200);
+    EXPECT_TRUE(series.archived());
+    EXPECT_EQ(series.stride(), 128u);
+    ASSERT_FALSE(series.empty());
+    EXPECT_DOUBLE_EQ(series.time_at(0), 0.0);
+    EXPECT_DOUBLE_EQ(series.time_at(series.size() - 1), view->last_time());
+
+    size_t spikes = 0;
+    for (size_t i = 0; i < series.size(); ++i) {
+        spikes += series.value_at(i) == 100.0 ? 1 : 0;
+        if (i > 0) {
+            EXPECT_LE(series.time_at(i - 1), series.time_at(i));
+        }
+    }
+    EXPECT_EQ(spikes, 6u); // frames 500, 1497, ... 5485
+    EXPECT_EQ(store->memory_bytes(), bytes);
+}
+
+TEST(DecimatedSeries, ArchiveUsesFinestLevelReachingBack) {
+    auto store = make_store(256, 6000, 64);
+    const auto snap = store->snapshot();
+    const SignalView *view = snap.find(0);
+    ASSERT_NE(view, nullptr);
+
+    // Levels of 8, 16 and 32 samples no longer reach frame 3000; 64 does.
+    const DecimatedSeries series(*view, 3.0, 4.0, 1000);
+    EXPECT_TRUE(series.archived());
+    EXPECT_EQ(series.stride(), 64u);
+    ASSERT_FALSE(series.empty());
+    EXPECT_LE(series.time_at(0), 3.0);
+    EXPECT_GE(series.time_at(series.size() - 1), 4.0);
+    EXPECT_LT(series.time_at(series.size() - 1), 4.2);
+}
+
+TEST(RangeStats, MatchesBruteForceOverAnyRange) {
+    auto store = make_store(4096, 20000, 64);
+    const auto snap = store->snapshot();
+    const SignalView *view = snap.find(0);
+    ASSERT_NE(view, nullptr);
+    ASSERT_EQ(view->size(), 4096u);
+
+    const std::pair<size_t, size_t> ranges[] = {
+        {0, 4096}, {0, 1}, {5, 3}, {123, 3000}, {1024, 2048}, {4000, 96}, {17, 4079}};
+    for (const auto &[start, count] : ranges) {
+        double lo = view->value_at(start);
+        double hi = lo;
+        double sum = 0.0;
+        for (size_t i = start; i < start + count; ++i) {
+            lo = std::min(lo, view->value_at(i));
+            hi = std::max(hi, view->value_at(i));
+            sum += view->value_at(i);
+        }
+        const RangeStats stats = range_stats(*view, start, count);
+        EXPECT_EQ(stats.count, count) << start << "+" << count;
+        EXPECT_DOUBLE_EQ(stats.min, lo) << start << "+" << count;
+        EXPECT_DOUBLE_EQ(stats.max, hi) << start << "+" << count;
+        EXPECT_NEAR(stats.mean(), sum / static_cast<double>(count), 1e-9);
+    }
+}
+
+TEST(RangeStats, ScansRangesNarrowerThanABucket) {
+    auto store = std::make_shared<SignalStore>(1, 16, 4);
+    FrameBatch batch;
+    batch.reset(1, 10);
+    for (int i = 0; i < 10; ++i) {
+        const double value[] = {static_cast<double>(i % 2 == 0 ? -i : i)};
+        batch.append(static_cast<uint64_t>(i), i, value);
+    }
+    size_t row = 0;
+    while (row < batch.rows) {
+        row += store->append_rows(batch, row);
+    }
+    const auto snap = store->snapshot();
+    const RangeStats stats = range_stats(*snap.find(0), 2, 5); // -2, 3, -4, 5, -6
+    EXPECT_EQ(stats.count, 5u);
+    EXPECT_DOUBLE_EQ(stats.min, -6.0);
+    EXPECT_DOUBLE_EQ(stats.max, 5.0);
+    EXPECT_DOUBLE_EQ(stats.mean(), -0.8);
+    EXPECT_TRUE(range_stats(*snap.find(0), 0, 0).empty());
+    EXPECT_TRUE(range_stats(SignalView(), 0, 0).empty());
+}
@@ -0,0 +1,285 @@
+#include "daedalus/data/signal_store.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace daedalus::data;
+
+namespace {
+
+/// Batch of `rows` frames starting at `first`: time = frame, signal s = frame * (s + 1).
+FrameBatch make_batch(size_t signals, uint64_t first, size_t rows) {
+    FrameBatch batch;
+    batch.reset(signals, rows);
+    std::vector<double> row(signals);
+    for (size_t r = 0; r < rows; ++r) {
+        const uint64_t frame = first + r;
+        for (size_t s = 0; s < signals; ++s) {
+            row[s] = static_cast<double>(frame) * static_cast<double>(s + 1);
+        }
+        batch.append(frame, static_cast<double>(frame), row);
+    }
+    return batch;
+}
+
+size_t append_all(SignalStore &store, const FrameBatch &batch) {
+    size_t row = 0;
+    while (row < batch.rows) {
+        const size_t written = store.append_rows(batch, row);
+        if (written == 0) {
+            break;
+        }
+        row += written;
+    }
+    return row;
+}
+
+} // namespace
+
+TEST(SignalStore, AppendAndSnapshot) {
+    auto store = std::make_shared<SignalStore>(2, 16, 4);
+    EXPECT_EQ(store->append_rows(make_batch(2, 0, 3)), 3u);
+
+    const auto snap = store->snapshot();
+    EXPECT_EQ(snap.signal_count(), 2u);
+    EXPECT_EQ(snap.samples(), 3u);
+    ASSERT_FALSE(snap.empty());
+    EXPECT_DOUBLE_EQ(snap.last_time(), 2.0);
+    ASSERT_NE(snap.find(1), nullptr);
+    EXPECT_DOUBLE_EQ(snap.find(1)->last_value(), 4.0);
+    EXPECT_EQ(snap.find(2), nullptr);
+}
+
+TEST(SignalStore, UnpinnedWritesAreChunkedByGuard) {
+    auto store = std::make_shared<SignalStore>(1, 64, 4);
+    const auto batch = make_batch(1, 0, 10);
+    EXPECT_EQ(store->append_rows(batch), 4u);
+    EXPECT_EQ(append_all(*store, batch), 10u);
+}
+
+TEST(SignalStore, ColumnsArePaddedToCacheLinesAndShareTimes) {
+    auto store = std::make_shared<SignalStore>(3, 10, 4);
+    ASSERT_EQ(append_all(*store, make_batch(3, 0, 6)), 6u);
+
+    const auto snap = store->snapshot();
+    for (size_t s = 0; s < 3; ++s) {
+        const SignalView *series = snap.find(s);
+        ASSERT_NE(series, nullptr);
+        EXPECT_DOUBLE_EQ(series->time_at(5), 5.0);
+        EXPECT_DOUBLE_EQ(series->value_at(5), 5.0 * static_cast<double>(s + 1));
+    }
+    // Time ring plus three value columns, each padded to whole cache lines.
+    EXPECT_EQ(store->memory_bytes(), 4u * 16u * sizeof(double));
+}
+
+TEST(SignalStore, WrapsAroundKeepingNewestRows) {
+    auto store = std::make_shared<SignalStore>(2, 8, 4);
+    ASSERT_EQ(append_all(*store, make_batch(2, 0, 29)), 29u);
+
+    const auto snap = store->snapshot();
+    const SignalView *series = snap.find(1);
+    ASSERT_NE(series, nullptr);
+    ASSERT_EQ(series->size(), 8u);
+    for (size_t i = 0; i < series->size(); ++i) {
+        const double frame = static_cast<double>(21 + i);
+        EXPECT_DOUBLE_EQ(series->time_at(i), frame);
+        EXPECT_DOUBLE_EQ(series->value_at(i), frame * 2.0);
+    }
+}
+
+TEST(SignalStore, RejectsMismatchedWidth) {
+    auto store = std::make_shared<SignalStore>(2, 16, 4);
+    EXPECT_EQ(store->append_rows(make_batch(3, 0, 3)), 0u);
+    EXPECT_EQ(store->samples(), 0u);
+}
+
+TEST(SignalStore, SnapshotPinsWriterToGuardBand) {
+    auto store = std::make_shared<SignalStore>(1, 8, 4);
+    ASSERT_EQ(append_all(*store, make_batch(1, 0, 8)), 8u);
+
+    auto snap = store->snapshot();
+    const auto batch = make_batch(1, 8, 10);
+    EXPECT_EQ(store->append_rows(batch), 4u); // guard band only
+    EXPECT_EQ(store->append_rows(batch, 4), 0u);
+
+    // The snapshot still sees exactly frames 0..7.
+    const SignalView *series = snap.find(0);
+    ASSERT_NE(series, nullptr);
+    for (size_t i = 0; i < series->size(); ++i) {
+        EXPECT_DOUBLE_EQ(series->time_at(i), static_cast<double>(i));
+    }
+
+    snap = StoreSnapshot{};
+    EXPECT_EQ(store->append_rows(batch, 4), 4u);
+    EXPECT_EQ(store->append_rows(batch, 8), 2u);
+    EXPECT_EQ(store->samples(), 18u);
+}
+
+TEST(SignalStore, MovedSnapshotKeepsPin) {
+    auto store = std::make_shared<SignalStore>(1, 8, 2);
+    ASSERT_EQ(append_all(*store, make_batch(1, 0, 8)), 8u);
+
+    StoreSnapshot outer;
+    {
+        auto inner = store->snapshot();
+        outer = std::move(inner);
+    }
+    const auto batch = make_batch(1, 8, 4);
+    EXPECT_EQ(store->append_rows(batch), 2u);
+    EXPECT_EQ(store->append_rows(batch, 2), 0u);
+}
+
+TEST(SignalStore, ConcurrentWriterNeverTearsSnapshot) {
+    constexpr uint64_t kFrames = 200000;
+    constexpr size_t kSignals = 3;
+    auto store = std::make_shared<SignalStore>(kSignals, 256, 64);
+    std::atomic<bool> done{false};
+
+    std::thread writer([&] {
+        uint64_t frame = 0;
+        while (frame < kFrames) {
+            const auto batch = make_batch(kSignals, frame, 16);
+            size_t row = 0;
+            while (row < batch.rows) {
+                row += store->append_rows(batch, row);
+            }
+            frame += batch.rows;
+        }
+        done = true;
+    });
+
+    bool consistent = true;
+    while (!done.load()) {
+        const auto snap = store->snapshot();
+        for (size_t s = 0; s < kSignals && consistent; ++s) {
+            const SignalView *series = snap.find(s);
+            const uint64_t first = snap.samples() - series->size();
+            for (size_t i = 0; i < series->size(); ++i) {
+                const double frame = static_cast<double>(first + i);
+                if (series->time_at(i) != frame ||
+                    series->value_at(i) != frame * static_cast<double>(s + 1)) {
+                    consistent = false;
+                    break;
+                }
+            }
+        }
+    }
+    writer.join();
+    EXPECT_TRUE(consistent);
+    EXPECT_EQ(store->samples(), kFrames);
+}
+
+TEST(SignalStore, ResizedColumnKeepsNewestSamples) {
+    auto store = std::make_shared<SignalStore>(2, 256, 64);
+    ASSERT_EQ(append_all(*store, make_batch(2, 0, 200)), 200u);
+
+    store->set_column_capacity(0, 1); // clamped to kMinColumnCapacity
+    ASSERT_EQ(append_all(*store, make_batch(2, 200, 1)), 1u);
+    EXPECT_EQ(store->column_capacity(0), SignalStore::kMinColumnCapacity);
+    EXPECT_EQ(store->column_capacity(1), 256u);
+    EXPECT_LT(store->column_bytes(0), store->column_bytes(1));
+
+    const auto snap = store->snapshot();
+    const SignalView *small = snap.find(0);
+    ASSERT_NE(small, nullptr);
+    ASSERT_EQ(small->size(), SignalStore::kMinColumnCapacity);
+    for (size_t i = 0; i < small->size(); ++i) {
+        EXPECT_DOUBLE_EQ(small->value_at(i), small->time_at(i));
+    }
+    EXPECT_DOUBLE_EQ(small->last_time(), 200.0);
+    EXPECT_EQ(snap.find(1)->size(), 201u);
+}
+
+TEST(SignalStore, GrownColumnFillsFromCarriedSamples) {
+    auto store = std::make_shared<SignalStore>(1, 512, 64);
+    store->set_column_capacity(0, 64);
+    ASSERT_EQ(append_all(*store, make_batch(1, 0, 300)), 300u);
+
+    store->set_column_capacity(0, 512);
+    ASSERT_EQ(append_all(*store, make_batch(1, 300, 100)), 100u);
+    {
+        const auto snap = store->snapshot();
+        // Only the samples the small ring still held survive the resize.
+        EXPECT_LE(snap.find(0)->size(), 64u + 64u + 100u);
+        EXPECT_GE(snap.find(0)->size(), 64u + 100u);
+        EXPECT_DOUBLE_EQ(snap.find(0)->last_value(), 399.0);
+    }
+    ASSERT_EQ(append_all(*store, make_batch(1, 400, 600)), 600u);
+    EXPECT_EQ(store->snapshot().find(0)->size(), 512u);
+}
+
+TEST(SignalStore, ReplacedRingOutlivesPinnedSnapshot) {
+    auto store = std::make_shared<SignalStore>(1, 256, 64);
+    ASSERT_EQ(append_all(*store, make_batch(1, 0, 256)), 256u);
+
+    auto snap = store->snapshot();
+    store->set_column_capacity(0, 64);
+    ASSERT_EQ(store->append_rows(make_batch(1, 256, 8)), 8u);
+    EXPECT_EQ(store->column_capacity(0), 64u);
+
+    // The writer swapped rings while pinned; the snapshot still reads the old one.
+    const SignalView *series = snap.find(0);
+    ASSERT_EQ(series->size(), 256u);
+    for (size_t i = 0; i < series->size(); ++i) {
+        EXPECT_DOUBLE_EQ(series->value_at(i), static_cast<double>(i));
+    }
+    snap = StoreSnapshot{};
+    EXPECT_EQ(store->snapshot().find(0)->size(), 64u);
+}
+
+TEST(SignalStore, MemoryBytesFollowColumnCapacities) {
+    auto store = std::make_shared<SignalStore>(2, 1024, 64);
+    const size_t before = store->memory_bytes();
+    EXPECT_EQ(before, store->fixed_bytes() + 2u * 1024u * sizeof(double));
+
+    store->set_column_capacity(1, 128);
+    ASSERT_EQ(append_all(*store, make_batch(2, 0, 1)), 1u);
+    EXPECT_EQ(before - store->memory_bytes(), (1024u - 128u) * sizeof(double));
+}
+
+TEST(SignalStore, CountsValueChanges) {
+    auto store = std::make_shared<SignalStore>(2, 64, 16);
+    FrameBatch batch;
+    batch.reset(2, 8);
+    for (uint64_t frame = 0; frame < 8; ++frame) {
+        const double row[] = {static_cast<double>(frame / 4 + 1), static_cast<double>(frame)};
+        batch.append(frame, static_cast<double>(frame), row);
+    }
+    ASSERT_EQ(append_all(*store, batch), 8u);
+    EXPECT_EQ(store->column_changes(0), 2u); // 0 -> 1, then 1 -> 2
+    EXPECT_EQ(store->column_changes(1), 7u); // starts equal to the initial 0
+}
+
+TEST(SignalStore, ConcurrentResizeNeverTearsSnapshot) {
+    constexpr uint64_t kFrames = 100000;
+    auto store = std::make_shared<SignalStore>(1, 256, 64);
+    std::atomic<bool> done{false};
+
+    std::thread writer([&] {
+        uint64_t frame = 0;
+        while (frame < kFrames) {
+            const auto batch = make_batch(1, frame, 16);
+            size_t row = 0;
+            while (row < batch.rows) {
+                row += store->append_rows(batch, row);
+            }
+            frame += batch.rows;
+        }
+        done = true;
+    });
+
+    bool consistent = true;
+    for (size_t round = 0; !done.load(); ++round) {
+        store->set_column_capacity(0, round % 2 == 0 ? 64 : 256);
+        const auto snap = store->snapshot();
+        const SignalView *series = snap.find(0);
+        const uint64_t first = snap.samples() - series->size();
+        for (size_t i = 0; i < series->size() && consistent; ++i) {
+            consistent = series->value_at(i) == static_cast<double>(first + i);
+        }
+    }
+    writer.join();
+    EXPECT_TRUE(consistent);
+}
@@ -131,3 +131,146 @@ TEST(SignalTree, Clear) {
     EXPECT_TRUE(tree.all_signals().empty());
     EXPECT_EQ(tree.find("vehicle.position.x"), nullptr);
 }
+
+TEST(SignalTree, FilterMatchesPathsCaseInsensitively) {
+    SignalTree tree;
+    tree.build_from_schema(make_test_schema());
+    EXPECT_EQ(tree.node_count(), 10u); // root, 2 modules, 2 groups, 5 signals
+
+    EXPECT_TRUE(tree.set_filter("POS"));
+    EXPECT_TRUE(tree.visible(*tree.find("vehicle")));
+    EXPECT_TRUE(tree.visible(*tree.find("vehicle.position")));
+    EXPECT_TRUE(tree.visible(*tree.find("vehicle.position.x")));
+    EXPECT_FALSE(tree.visible(*tree.find("vehicle.velocity")));
+    EXPECT_FALSE(tree.visible(*tree.find("inputs.throttle")));
+
+    // A module name matches every signal below it through the path.
+    tree.set_filter("Inputs");
+    EXPECT_TRUE(tree.visible(*tree.find("inputs.throttle")));
+    EXPECT_FALSE(tree.visible(*tree.find("vehicle")));
+
+    tree.set_filter("");
+    EXPECT_TRUE(tree.visible(*tree.find("vehicle.velocity.y")));
+}
+
+TEST(SignalTree, FilterNarrowsAndWidens) {
+    SignalTree tree;
+    tree.build_from_schema(make_test_schema());
+
+    tree.set_filter("x");
+    EXPECT_TRUE(tree.visible(*tree.find("vehicle.position.x")));
+    EXPECT_TRUE(tree.visible(*tree.find("vehicle.velocity.x")));
+
+    tree.set_filter("ity.x"); // narrower: contains the old text
+    EXPECT_FALSE(tree.visible(*tree.find("vehicle.position.x")));
+    EXPECT_TRUE(tree.visible(*tree.find("vehicle.velocity.x")));
+    EXPECT_FALSE(tree.visible(*tree.find("vehicle.velocity.y")));
+
+    tree.set_filter("ity."); // wider again
+    EXPECT_TRUE(tree.visible(*tree.find("vehicle.velocity.y")));
+    EXPECT_FALSE(tree.visible(*tree.find("vehicle.position.x")));
+
+    EXPECT_FALSE(tree.set_filter("ity.")); // unchanged
+    EXPECT_FALSE(tree.set_filter("ITY.")); // same match set
+    EXPECT_EQ(tree.filter(), "ITY.");
+}
+
+TEST(SignalTree, FilterSurvivesRebuild) {
+    SignalTree tree;
+    tree.build_from_schema(make_test_schema());
+    tree.set_filter("throttle");
+
+    Schema schema = make_test_schema();
+    schema.modules[0].signals.push_back({"throttle_cmd", "f64", std::nullopt});
+    tree.build_from_schema(schema);
+
+    EXPECT_EQ(tree.filter(), "throttle");
+    EXPECT_TRUE(tree.visible(*tree.find("vehicle.throttle_cmd")));
+    EXPECT_TRUE(tree.visible(*tree.find("inputs.throttle")));
+    EXPECT_FALSE(tree.visible(*tree.find("vehicle.position")));
+}
+
+TEST(SignalTree, RowsFollowExpansionAndFilter) {
+    SignalTree tree;
+    tree.build_from_schema(make_test_schema());
+
+    const auto paths = [&] {
+        std::vector<std::string> out;
+        for (const auto &row : tree.rows()) {
+            out.push_back(std::string(row.node->full_path) + "@" + std::to_string(row.depth));
+        }
+        return out;
+    };
+    EXPECT_EQ(paths(), (std::vector<std::string>{"vehicle@0", "inputs@0"}));
+
+    tree.set_expanded(*tree.find("vehicle"), true);
+    tree.set_expanded(*tree.find("vehicle.velocity"), true);
+    EXPECT_EQ(paths(), (std::vector<std::string>{"vehicle@0", "vehicle.position@1",
+                                                 "vehicle.velocity@1", "vehicle.velocity.x@2",
+                                                 "vehicle.velocity.y@2", "inputs@0"}));
+
+    tree.set_filter(".y");
+    EXPECT_EQ(paths(), (std::vector<std::string>{"vehicle@0", "vehicle.position@1",
+                                                 "vehicle.velocity@1", "vehicle.velocity.y@2"}));
+
+    tree.set_filter("");
+    tree.set_all_expanded(true);
+    EXPECT_EQ(tree.rows().size(), 9u);
+    EXPECT_FALSE(tree.expanded(*tree.find("inputs.throttle")));
+    tree.set_all_expanded(false);
+    EXPECT_EQ(tree.rows().size(), 2u);
+}
+
+TEST(SignalTree, ExpansionSurvivesRebuild) {
+    SignalTree tree;
+    tree.build_from_schema(make_test_schema());
+    tree.set_expanded(*tree.find("vehicle"), true);
+    tree.set_expanded(*tree.find("vehicle.position"), true);
+
+    Schema schema = make_test_schema();
+    schema.modules[0].signals.push_back({"position.z", "f64", "m"});
+    tree.build_from_schema(schema);
+
+    EXPECT_TRUE(tree.expanded(*tree.find("vehicle")));
+    EXPECT_TRUE(tree.expanded(*tree.find("vehicle.position")));
+    EXPECT_FALSE(tree.expanded(*tree.find("vehicle.velocity")));
+    EXPECT_EQ(tree.rows().size(), 7u); // vehicle, position, x, y, z, velocity, inputs
+}
+
+TEST(SignalTree, LargeSchemaKeepsOrderAndLookups) {
+    Schema schema;
+    for (int m = 0; m < 10; ++m) {
+        ModuleInfo mod;
+        mod.name = "mod" + std::to_string(m);
+        for (int g = 0; g < 20; ++g) {
+            for (int k = 0; k < 10; ++k) {
+                mod.signals.push_back(
+                    {"group" + std::to_string(g) + ".sig" + std::to_string(k), "f64", "m"});
+            }
+        }
+        schema.modules.push_back(std::move(mod));
+    }
+    // A signal that is also a group, and a dotted module name.
+    schema.modules[0].signals.push_back({"group3", "f64", std::nullopt});
+    schema.modules.push_back({"a.b", {{"c", "f64", std::nullopt}}});
+
+    SignalTree tree;
+    tree.build_from_schema(schema);
+    EXPECT_EQ(tree.all_signals().size(), 2002u);
+    EXPECT_EQ(tree.node_count(), 1u + 10 * (1 + 20 * 11) + 3);
+
+    const auto &mod7 = *tree.find("mod7");
+    ASSERT_EQ(mod7.children.size(), 20u);
+    EXPECT_EQ(mod7.children[4]->name, "group4");
+    EXPECT_EQ(mod7.children[4]->children[9]->full_path, "mod7.group4.sig9");
+
+    const auto *group3 = tree.find("mod0.group3");
+    ASSERT_NE(group3, nullptr);
+    EXPECT_TRUE(group3->is_leaf);
+    EXPECT_EQ(group3->children.size(), 10u);
+
+    EXPECT_EQ(tree.find("a")->children[0]->full_path, "a.b");
+    EXPECT_TRUE(tree.find("a.b.c")->is_leaf);
+    EXPECT_EQ(tree.find("mod7.group4.sig10"), nullptr);
+    EXPECT_EQ(tree.find("mod7.group"), nullptr);
+}
@@ -0,0 +1,133 @@
+#include "daedalus/data/signal_store.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+using namespace daedalus::data;
+
+namespace {
+
+/// Snapshot of a one-signal store of `capacity` rows (guard 3) fed the samples
+/// (times[i], values[i]).
+StoreSnapshot snapshot_of(const std::vector<double> &times, const std::vector<double> &values,
+                          size_t capacity = 8) {
+    auto store = std::make_shared<SignalStore>(1, capacity, 3);
+    FrameBatch batch;
+    batch.reset(1, times.size());
+    for (size_t i = 0; i < times.size(); ++i) {
+        batch.append(i, times[i], {&values[i], 1});
+    }
+    size_t row = 0;
+    while (row < batch.rows) {
+        row += store->append_rows(batch, row);
+    }
+    return store->snapshot();
+}
+
+} // namespace
+
+TEST(SignalView, DefaultIsEmpty) {
+    const SignalView view;
+    EXPECT_TRUE(view.empty());
+    EXPECT_EQ(view.end(), 0u);
+    EXPECT_EQ(view.lod().levels(), 0u);
+    const auto [start, count] = view.visible_range(0.0, 1.0);
+    EXPECT_EQ(start, 0u);
+    EXPECT_EQ(count, 0u);
+}
+
+TEST(SignalView, KeepsTheNewestSamplesOldestFirst) {
+    const auto snap = snapshot_of({0.0, 1.0, 2.0, 3.0, 4.0, 5.0}, {1, 2, 3, 4, 5, 6}, 4);
+    const SignalView &view = *snap.find(0);
+    ASSERT_EQ(view.size(), 4u);
+    EXPECT_EQ(view.end(), 6u);
+    EXPECT_DOUBLE_EQ(view.time_at(0), 2.0);
+    EXPECT_DOUBLE_EQ(view.value_at(0), 3.0);
+    EXPECT_DOUBLE_EQ(view.last_time(), 5.0);
+    EXPECT_DOUBLE_EQ(view.last_value(), 6.0);
+}
+
+TEST(SignalView, CopyTo) {
+    const auto snap = snapshot_of({0.0, 1.0, 2.0, 3.0, 4.0}, {10, 20, 30, 40, 50}, 4);
+
+    std::vector<double> times, values;
+    snap.find(0)->copy_to(times, values);
+
+    ASSERT_EQ(times.size(), 4u);
+    ASSERT_EQ(values.size(), 4u);
+    // Oldest first
+    EXPECT_DOUBLE_EQ(times[0], 1.0);
+    EXPECT_DOUBLE_EQ(values[0], 20.0);
+    EXPECT_DOUBLE_EQ(times[3], 4.0);
+    EXPECT_DOUBLE_EQ(values[3], 50.0);
+}
+
+TEST(SignalView, LowerBoundTime) {
+    const auto snap = snapshot_of({1.0, 2.0, 3.0, 4.0}, {10, 20, 30, 40});
+    const SignalView &view = *snap.find(0);
+
+    EXPECT_EQ(view.lower_bound_time(0.5), 0u);
+    EXPECT_EQ(view.lower_bound_time(1.0), 0u);
+    EXPECT_EQ(view.lower_bound_time(2.5), 2u);
+    EXPECT_EQ(view.lower_bound_time(4.0), 3u);
+    EXPECT_EQ(view.lower_bound_time(4.5), 4u);
+}
+
+TEST(SignalView, UpperBoundTime) {
+    const auto snap = snapshot_of({1.0, 2.0, 3.0, 4.0}, {10, 20, 30, 40});
+    const SignalView &view = *snap.find(0);
+
+    EXPECT_EQ(view.upper_bound_time(0.5), 0u);
+    EXPECT_EQ(view.upper_bound_time(1.0), 1u);
+    EXPECT_EQ(view.upper_bound_time(2.5), 2u);
+    EXPECT_EQ(view.upper_bound_time(4.0), 4u);
+    EXPECT_EQ(view.upper_bound_time(4.5), 4u);
+}
+
+TEST(SignalView, VisibleRangeAddsBoundarySamples) {
+    const auto snap = snapshot_of({1.0, 2.0, 3.0, 4.0, 5.0}, {10, 20, 30, 40, 50});
+
+    const auto [start, count] = snap.find(0)->visible_range(2.2, 4.1);
+    EXPECT_EQ(start, 1u);
+    EXPECT_EQ(count, 4u); // includes one sample before/after range
+}
+
+TEST(SignalView, VisibleRangeWithNoOverlap) {
+    const auto snap = snapshot_of({1.0, 2.0, 3.0}, {10, 20, 30});
+
+    const auto [start, count] = snap.find(0)->visible_range(10.0, 12.0);
+    EXPECT_EQ(start, 2u);
+    EXPECT_EQ(count, 1u);
+}
+
+TEST(SignalView, VisibleRangeInvalidWindow) {
+    const auto snap = snapshot_of({1.0, 2.0}, {10, 20});
+
+    const auto [start, count] = snap.find(0)->visible_range(5.0, 2.0);
+    EXPECT_EQ(start, 0u);
+    EXPECT_EQ(count, 0u);
+}
+
+TEST(SignalView, SpansSplitAtTheWrap) {
+    // Capacity 5 + guard 3: 8-slot rings. Times 5..9 sit in slots 5, 6, 7, 0, 1.
+    std::vector<double> times;
+    std::vector<double> values;
+    for (int i = 0; i < 10; ++i) {
+        times.push_back(i);
+        values.push_back(i * 10.0);
+    }
+    const auto snap = snapshot_of(times, values, 5);
+    const SignalView &view = *snap.find(0);
+    ASSERT_EQ(view.size(), 5u);
+    const RingSpans spans = view.value_spans(1, 4);
+    ASSERT_EQ(spans.first.size(), 2u);
+    ASSERT_EQ(spans.second.size(), 2u);
+    EXPECT_DOUBLE_EQ(spans.first[0], 60.0);
+    EXPECT_DOUBLE_EQ(spans.second[0], 80.0);
+    EXPECT_DOUBLE_EQ(spans.second[1], 90.0);
+    EXPECT_EQ(view.time_spans(0, 3).second.size(), 0u);
+    EXPECT_EQ(view.lower_bound_time(8.0), 3u);
+    EXPECT_EQ(view.upper_bound_time(8.0), 4u);
+}
@@ -1,7 +1,10 @@
+#include "daedalus/data/buffer_pool.hpp"
 #include "daedalus/data/telemetry_queue.hpp"
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <string>
 #include <thread>
 
 using namespace daedalus::data;
@@ -69,26 +72,20 @@ TEST(SPSCQueue, SizeApprox) {
     EXPECT_EQ(q.size_approx(), 1u);
 }
 
-TEST(TelemetryQueue, BinaryFrameTransfer) {
+TEST(TelemetryQueue, FrameBatchTransfer) {
     TelemetryQueue q(16);
-    std::vector<uint8_t> frame = {0x48, 0x45, 0x52, 0x54, 1, 2, 3, 4};
+    FrameBatch batch;
+    batch.reset(2, 4);
+    const std::vector<double> row = {1.0, 2.0};
+    ASSERT_TRUE(batch.append(7, 0.5, row));
 
-    EXPECT_TRUE(q.try_push(std::vector<uint8_t>(frame)));
+    EXPECT_TRUE(q.try_push(std::move(batch)));
 
-    std::vector<uint8_t> out;
+    FrameBatch out;
     EXPECT_TRUE(q.try_pop(out));
-    EXPECT_EQ(out, frame);
-}
-
-TEST(EventQueue, JsonStringTransfer) {
-    EventQueue q(16);
-    std::string event = R"({"type":"schema","modules":{}})";
-
-    EXPECT_TRUE(q.try_push(std::string(event)));
-
-    std::string out;
-    EXPECT_TRUE(q.try_pop(out));
-    EXPECT_EQ(out, event);
+    ASSERT_EQ(out.rows, 1u);
+    EXPECT_EQ(out.frame_column()[0], 7u);
+    EXPECT_DOUBLE_EQ(out.column(1)[0], 2.0);
 }
 
 TEST(SPSCQueue, MultithreadedStress) {
@@ -123,3 +120,267 @@ TEST(SPSCQueue, MultithreadedStress) {
         EXPECT_EQ(received[i], i) << "Mismatch at index " << i;
     }
 }
+
+TEST(SPSCQueue, EvictOldestFreesSlot) {
+    SPSCQueue<int> q(4, true); // capacity 3, evictable
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(q.try_push(std::move(i)));
+    }
+    EXPECT_FALSE(q.try_push(3));
+
+    int evicted = -1;
+    ASSERT_TRUE(q.try_evict_oldest(evicted));
+    EXPECT_EQ(evicted, 0);
+    EXPECT_TRUE(q.try_push(3));
+
+    int val = 0;
+    for (int expected = 1; expected <= 3; ++expected) {
+        ASSERT_TRUE(q.try_pop(val));
+        EXPECT_EQ(val, expected);
+    }
+    EXPECT_FALSE(q.try_evict_oldest(evicted));
+}
+
+TEST(SPSCQueue, OnlyEvictableQueuesEvict) {
+    SPSCQueue<int> q(4);
+    EXPECT_FALSE(q.evictable());
+    EXPECT_TRUE(q.try_push(1));
+    int evicted = -1;
+    EXPECT_FALSE(q.try_evict_oldest(evicted));
+    EXPECT_EQ(q.size_approx(), 1u);
+}
+
+TEST(SPSCQueue, NonPowerOfTwoCapacityIsKept) {
+    SPSCQueue<int> q(6); // six slots requested, eight allocated
+    EXPECT_EQ(q.capacity(), 5u);
+    for (int round = 0; round < 4; ++round) {
+        for (int i = 0; i < 5; ++i) {
+            EXPECT_TRUE(q.try_push(round * 10 + i));
+        }
+        EXPECT_FALSE(q.try_push(99));
+        int val = 0;
+        for (int i = 0; i < 5; ++i) {
+            EXPECT_TRUE(q.try_pop(val));
+            EXPECT_EQ(val, round * 10 + i);
+        }
+    }
+}
+
+TEST(SPSCQueue, BulkPushStopsAtCapacity) {
+    SPSCQueue<int> q(8); // capacity 7
+    int items[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    EXPECT_EQ(q.try_push_bulk(items, 10), 7u);
+    EXPECT_EQ(q.try_push_bulk(items + 7, 3), 0u);
+
+    int out[4] = {};
+    EXPECT_EQ(q.try_pop_bulk(out, 4), 4u);
+    EXPECT_EQ(out[0], 0);
+    EXPECT_EQ(out[3], 3);
+    EXPECT_EQ(q.try_push_bulk(items + 7, 3), 3u); // wraps
+    int rest[8] = {};
+    ASSERT_EQ(q.try_pop_bulk(rest, 8), 6u);
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_EQ(rest[i], i + 4);
+    }
+    EXPECT_EQ(q.try_pop_bulk(rest, 8), 0u);
+}
+
+TEST(SPSCQueue, BulkMultithreadedStress) {
+    constexpr int kItems = 200000;
+    SPSCQueue<int> q(64);
+
+    std::thread producer([&] {
+        int batch[16];
+        int next = 0;
+        while (next < kItems) {
+            const int n = std::min(16, kItems - next);
+            for (int i = 0; i < n; ++i) {
+                batch[i] = next + i;
+            }
+            size_t pushed = 0;
+            while (pushed < static_cast<size_t>(n)) {
+                pushed += q.try_push_bulk(batch + pushed, static_cast<size_t>(n) - pushed);
+            }
+            next += n;
+        }
+    });
+
+    int expected = 0;
+    int out[24];
+    while (expected < kItems) {
+        const size_t n = q.try_pop_bulk(out, 24);
+        for (size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(out[i], expected++);
+        }
+    }
+    producer.join();
+}
+
+TEST(OverflowQueue, DropNewestRejectsAndCounts) {
+    OverflowQueue<int> q(4, OverflowPolicy::DropNewest);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(q.try_push(std::move(i)));
+    }
+    EXPECT_FALSE(q.try_push(99));
+
+    const auto stats = q.stats();
+    EXPECT_EQ(stats.pushed, 3u);
+    EXPECT_EQ(stats.dropped, 1u);
+    EXPECT_EQ(stats.depth, 3u);
+    EXPECT_EQ(stats.high_water, 3u);
+
+    int val = -1;
+    ASSERT_TRUE(q.try_pop(val));
+    EXPECT_EQ(val, 0);
+}
+
+TEST(OverflowQueue, DropOldestEvictsHead) {
+    OverflowQueue<int> q(4, OverflowPolicy::DropOldest);
+    std::vector<int> discarded;
+    q.set_discard_handler([&](int &&v) { discarded.push_back(v); });
+
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(q.try_push(std::move(i)));
+    }
+    EXPECT_EQ(discarded, (std::vector<int>{0, 1}));
+    EXPECT_EQ(q.stats().dropped, 2u);
+
+    int val = -1;
+    for (int expected = 2; expected < 5; ++expected) {
+        ASSERT_TRUE(q.try_pop(val));
+        EXPECT_EQ(val, expected);
+    }
+    EXPECT_FALSE(q.try_pop(val));
+}
+
+TEST(OverflowQueue, EvictingPolicyOnNonEvictableRingDropsNewest) {
+    OverflowQueue<int> q(4, OverflowPolicy::DropNewest);
+    q.set_policy(OverflowPolicy::DropOldest);
+    for (int i = 0; i < 4; ++i) {
+        q.try_push(std::move(i));
+    }
+    EXPECT_EQ(q.stats().dropped, 1u);
+    int val = -1;
+    ASSERT_TRUE(q.try_pop(val));
+    EXPECT_EQ(val, 0);
+}
+
+TEST(OverflowQueue, CoalesceKeepsOnlyLatest) {
+    OverflowQueue<int> q(4, OverflowPolicy::CoalesceLatest);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(q.try_push(std::move(i)));
+    }
+    EXPECT_EQ(q.stats().dropped, 3u);
+    EXPECT_EQ(q.size_approx(), 1u);
+
+    int val = -1;
+    ASSERT_TRUE(q.try_pop(val));
+    EXPECT_EQ(val, 3);
+}
+
+TEST(OverflowQueue, SpillNeverDropsAndPreservesOrder) {
+    OverflowQueue<std::string> q(4, OverflowPolicy::Spill);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(q.try_push(std::to_string(i)));
+    }
+    auto stats = q.stats();
+    EXPECT_EQ(stats.dropped, 0u);
+    EXPECT_EQ(stats.spilled, 7u);
+    EXPECT_EQ(stats.depth, 10u);
+    EXPECT_EQ(stats.high_water, 10u);
+
+    // Pushes interleaved with pops must still come out in order.
+    std::string out;
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(q.try_pop(out));
+        EXPECT_EQ(out, std::to_string(i));
+    }
+    for (int i = 10; i < 12; ++i) {
+        EXPECT_TRUE(q.try_push(std::to_string(i)));
+    }
+    for (int i = 5; i < 12; ++i) {
+        ASSERT_TRUE(q.try_pop(out));
+        EXPECT_EQ(out, std::to_string(i));
+    }
+    EXPECT_FALSE(q.try_pop(out));
+    EXPECT_EQ(q.stats().popped, 12u);
+    EXPECT_EQ(q.stats().depth, 0u);
+}
+
+TEST(OverflowQueue, FrameBatchDropsCountRows) {
+    TelemetryQueue q(2, OverflowPolicy::DropOldest); // capacity 1
+    const std::vector<double> row = {1.0};
+    for (int i = 0; i < 2; ++i) {
+        FrameBatch batch;
+        batch.reset(1, 4);
+        for (uint64_t f = 0; f < 3; ++f) {
+            ASSERT_TRUE(batch.append(f, 0.0, row));
+        }
+        EXPECT_TRUE(q.try_push(std::move(batch)));
+    }
+    EXPECT_EQ(q.stats().pushed, 6u);
+    EXPECT_EQ(q.stats().dropped, 3u);
+}
+
+TEST(OverflowQueue, DropOldestStressDeliversIncreasingSequence) {
+    constexpr int kCount = 200000;
+    OverflowQueue<int> q(8, OverflowPolicy::DropOldest);
+    uint64_t evicted = 0;
+    q.set_discard_handler([&](int &&) { ++evicted; });
+
+    std::thread producer([&] {
+        for (int i = 0; i < kCount; ++i) {
+            q.try_push(std::move(i));
+        }
+        while (!q.try_push(-1)) {
+            // sentinel must land
+        }
+    });
+
+    int last = -1;
+    int val = 0;
+    bool ordered = true;
+    for (;;) {
+        if (!q.try_pop(val)) {
+            continue;
+        }
+        if (val == -1) {
+            break;
+        }
+        ordered = ordered && val > last;
+        last = val;
+    }
+    producer.join();
+
+    EXPECT_TRUE(ordered);
+    // Everything accepted was either delivered or evicted.
+    const auto stats = q.stats();
+    EXPECT_EQ(stats.pushed, stats.popped + evicted);
+    EXPECT_EQ(stats.depth, 0u);
+}
+
+TEST(OverflowQueue, SpillStressLosesNothing) {
+    constexpr int kCount = 50000;
+    OverflowQueue<int> q(8, OverflowPolicy::Spill);
+
+    std::thread producer([&] {
+        for (int i = 0; i < kCount; ++i) {
+            q.try_push(std::move(i));
+        }
+    });
+
+    std::vector<int> received;
+    received.reserve(kCount);
+    int val = 0;
+    while (static_cast<int>(received.size()) < kCount) {
+        if (q.try_pop(val)) {
+            received.push_back(val);
+        }
+    }
+    producer.join();
+
+    EXPECT_EQ(q.stats().dropped, 0u);
+    for (int i = 0; i < kCount; ++i) {
+        ASSERT_EQ(received[i], i) << "Mismatch at index " << i;
+    }
+}
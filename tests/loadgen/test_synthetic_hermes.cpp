@@ -0,0 +1,87 @@
+#include "daedalus/headless.hpp"
+#include "daedalus/loadgen/synthetic_hermes.hpp"
+#include "daedalus/protocol/client.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+using namespace daedalus;
+using namespace daedalus::loadgen;
+
+namespace {
+
+constexpr size_t kHistoryBudget = size_t{64} << 20;
+
+/// Poll `session` until `done` holds or ten seconds pass.
+template <typename Done> bool poll_until(HeadlessSession &session, Done done) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        session.poll();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(SyntheticHermes, StreamsAGeneratedLoadToTheClient) {
+    LoadProfile profile;
+    profile.modules = 10;
+    profile.signals_per_module = 100;
+    profile.rate_hz = 10000.0;
+    profile.sim_rate_hz = 10000.0;
+    SyntheticHermes server(profile);
+    ASSERT_TRUE(server.start());
+
+    protocol::HermesClient client(server.url());
+    HeadlessSession session(client, data::HistoryBudget(kHistoryBudget));
+    const auto start = std::chrono::steady_clock::now();
+    session.start();
+    ASSERT_TRUE(poll_until(session, [&] { return session.report().frames >= 5000; }));
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const auto report = session.report();
+    ASSERT_TRUE(session.store());
+    EXPECT_EQ(session.store()->signal_count(), 1000u);
+    EXPECT_EQ(report.samples, report.frames * 1000u);
+    // Every frame arrives in order; a slow machine may still drop at the queue
+    EXPECT_EQ(report.gaps, 0u);
+    EXPECT_EQ(report.frames_rejected, 0u);
+    EXPECT_EQ(server.clients(), 1u);
+    // Paced: 5000 frames at 10 kHz take at least half a second
+    EXPECT_GE(seconds, 0.45);
+    session.stop();
+    server.stop();
+}
+
+TEST(SyntheticHermes, InjectsGapsAndBurstsOnRequest) {
+    LoadProfile profile;
+    profile.modules = 2;
+    profile.signals_per_module = 5;
+    profile.rate_hz = 1000.0;
+    profile.burst_frames = 50;
+    profile.gap_every = 100;
+    profile.gap_frames = 2;
+    SyntheticHermes server(profile);
+    ASSERT_TRUE(server.start());
+
+    protocol::HermesClient client(server.url());
+    HeadlessSession session(client, data::HistoryBudget(kHistoryBudget));
+    session.start();
+    ASSERT_TRUE(poll_until(session, [&] { return session.report().frames >= 350; }));
+    // Profile gaps after every 100 frames; a scripted one on top
+    server.skip(1000);
+    server.burst(2000);
+    ASSERT_TRUE(poll_until(session, [&] { return session.report().frames >= 2500; }));
+    const auto report = session.report();
+    EXPECT_GE(report.gaps, 4u);
+    EXPECT_GE(report.missing_frames, 1000u);
+    EXPECT_EQ(report.frames_dropped, 0u);
+    session.stop();
+    server.stop();
+}
@@ -0,0 +1,93 @@
+#include "daedalus/loadgen/synthetic_load.hpp"
+#include "daedalus/protocol/schema.hpp"
+#include "daedalus/protocol/telemetry.hpp"
+
+#include <gtest/gtest.h>
+
+#include <span>
+#include <vector>
+
+using namespace daedalus::loadgen;
+using namespace daedalus::protocol;
+
+namespace {
+
+/// Decode a generated frame, failing the test if it is not a valid "HERT" frame.
+TelemetryHeader decode(const std::vector<uint8_t> &bytes, std::vector<double> &values) {
+    TelemetryHeader hdr{};
+    std::span<const double> view;
+    EXPECT_TRUE(decode_frame(bytes.data(), bytes.size(), hdr, view, values));
+    return hdr;
+}
+
+} // namespace
+
+TEST(SyntheticLoad, DeclaresModulesTimesSignals) {
+    LoadProfile profile;
+    profile.modules = 3;
+    profile.signals_per_module = 40;
+    SyntheticLoad load(profile);
+
+    const auto schema = parse_schema_text(load.schema_json());
+    ASSERT_EQ(schema.modules.size(), 3u);
+    for (const auto &module : schema.modules) {
+        EXPECT_EQ(module.signals.size(), 40u);
+    }
+    EXPECT_EQ(load.signal_count(), 120u);
+    EXPECT_EQ(load.signal_paths()[41], "m1.s1");
+}
+
+TEST(SyntheticLoad, FramesCarryTheSubscribedSignals) {
+    LoadProfile profile;
+    profile.modules = 2;
+    profile.signals_per_module = 3;
+    profile.sim_rate_hz = 100.0;
+    SyntheticLoad load(profile);
+
+    const auto ack = parse_subscribe_ack_text(load.subscribe({"m1.*", "m0.s2"}));
+    ASSERT_EQ(ack.count, 4u);
+    EXPECT_EQ(ack.signals, (std::vector<std::string>{"m0.s2", "m1.s0", "m1.s1", "m1.s2"}));
+
+    std::vector<uint8_t> bytes;
+    std::vector<double> values;
+    for (uint64_t f = 0; f < 5; ++f) {
+        load.next_frame(bytes);
+        const auto hdr = decode(bytes, values);
+        EXPECT_EQ(hdr.frame, f);
+        EXPECT_DOUBLE_EQ(hdr.time, static_cast<double>(f) / 100.0);
+        ASSERT_EQ(hdr.count, 4u);
+        EXPECT_DOUBLE_EQ(values[0], SyntheticLoad::value(2, f));
+        EXPECT_DOUBLE_EQ(values[3], SyntheticLoad::value(5, f));
+    }
+
+    EXPECT_EQ(parse_subscribe_ack_text(load.subscribe({"*"})).count, 6u);
+    EXPECT_EQ(parse_subscribe_ack_text(load.subscribe({"nope.*"})).count, 0u);
+}
+
+TEST(SyntheticLoad, SkipsFrameNumbersForGaps) {
+    LoadProfile profile;
+    profile.modules = 1;
+    profile.signals_per_module = 1;
+    profile.gap_every = 10;
+    profile.gap_frames = 3;
+    SyntheticLoad load(profile);
+    load.subscribe({"*"});
+
+    std::vector<uint8_t> bytes;
+    std::vector<double> values;
+    std::vector<uint64_t> frames;
+    for (int i = 0; i < 25; ++i) {
+        load.next_frame(bytes);
+        frames.push_back(decode(bytes, values).frame);
+    }
+    // 0..9, gap of 3, 13..22, gap of 3, 26..30
+    EXPECT_EQ(frames[9], 9u);
+    EXPECT_EQ(frames[10], 13u);
+    EXPECT_EQ(frames[20], 26u);
+    EXPECT_EQ(load.frames_skipped(), 6u);
+
+    load.skip(100);
+    load.next_frame(bytes);
+    EXPECT_EQ(decode(bytes, values).frame, 131u);
+    EXPECT_EQ(load.frames_generated(), 26u);
+}
@@ -0,0 +1,166 @@
+#include "daedalus/protocol/decode_plan.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+using namespace daedalus::protocol;
+
+namespace {
+
+/// Frame builder that packs each value at its own width.
+class PayloadWriter {
+  public:
+    template <typename T> PayloadWriter &put(T value) {
+        const size_t at = bytes_.size();
+        bytes_.resize(at + sizeof(T));
+        std::memcpy(bytes_.data() + at, &value, sizeof(T));
+        ++count_;
+        return *this;
+    }
+
+    [[nodiscard]] std::vector<uint8_t> frame(uint64_t frame_num, double time) const {
+        TelemetryHeader hdr{kTelemetryMagic, frame_num, time, count_};
+        std::vector<uint8_t> buf(sizeof(hdr) + bytes_.size());
+        std::memcpy(buf.data(), &hdr, sizeof(hdr));
+        std::memcpy(buf.data() + sizeof(hdr), bytes_.data(), bytes_.size());
+        return buf;
+    }
+
+  private:
+    std::vector<uint8_t> bytes_;
+    uint32_t count_ = 0;
+};
+
+} // namespace
+
+TEST(DecodePlan, ParsesTypeNames) {
+    EXPECT_EQ(parse_value_type("f64"), ValueType::F64);
+    EXPECT_EQ(parse_value_type("f32"), ValueType::F32);
+    EXPECT_EQ(parse_value_type("i32"), ValueType::I32);
+    EXPECT_EQ(parse_value_type("u32"), ValueType::U32);
+    EXPECT_EQ(parse_value_type("i64"), ValueType::I64);
+    EXPECT_EQ(parse_value_type("bool"), ValueType::Bool);
+    EXPECT_EQ(parse_value_type("enum"), ValueType::Enum);
+    EXPECT_FALSE(parse_value_type("complex").has_value());
+}
+
+TEST(DecodePlan, CompilesFromSchemaAndAckOrder) {
+    Schema schema;
+    schema.modules.push_back({"gnc",
+                              {{"mode", "enum", std::nullopt},
+                               {"armed", "bool", std::nullopt},
+                               {"alt", "f64", "m"},
+                               {"thrust", "f32", "N"},
+                               {"flux", "c128", std::nullopt}}});
+    const auto declared = declared_types(schema);
+    EXPECT_EQ(declared.size(), 3u); // f64 and unknown types are left out
+
+    const DecodePlan plan(declared, {"gnc.alt", "gnc.armed", "gnc.thrust", "gnc.flux",
+                                     "gnc.mode", "other.x"});
+    ASSERT_EQ(plan.signal_count(), 6u);
+    EXPECT_EQ(plan.type(0), ValueType::F64);
+    EXPECT_EQ(plan.type(1), ValueType::Bool);
+    EXPECT_EQ(plan.type(2), ValueType::F32);
+    EXPECT_EQ(plan.type(3), ValueType::F64);
+    EXPECT_EQ(plan.type(4), ValueType::Enum);
+    EXPECT_EQ(plan.type(5), ValueType::F64);
+    EXPECT_EQ(plan.payload_bytes(), 8u + 1u + 4u + 8u + 4u + 8u);
+    EXPECT_FALSE(plan.all_f64());
+    EXPECT_TRUE(DecodePlan(declared, {"gnc.alt", "other.x"}).all_f64());
+}
+
+TEST(DecodePlan, DecodesMixedPayloadAndWidens) {
+    const DecodePlan plan({ValueType::F64, ValueType::F32, ValueType::F32, ValueType::I32,
+                           ValueType::U32, ValueType::I64, ValueType::Bool, ValueType::Bool,
+                           ValueType::Enum});
+    PayloadWriter writer;
+    writer.put(1.25)
+        .put(2.5f)
+        .put(-0.5f)
+        .put(int32_t{-7})
+        .put(uint32_t{4000000000u})
+        .put(int64_t{-(int64_t{1} << 40)})
+        .put(uint8_t{1})
+        .put(uint8_t{0})
+        .put(int32_t{3});
+    const auto buf = writer.frame(12, 0.5);
+    ASSERT_EQ(buf.size(), sizeof(TelemetryHeader) + plan.payload_bytes());
+
+    TelemetryHeader hdr{};
+    std::span<const double> values;
+    std::vector<double> storage;
+    ASSERT_TRUE(decode_frame(buf.data(), buf.size(), plan, hdr, values, storage));
+    EXPECT_EQ(hdr.frame, 12u);
+    const std::vector<double> expected = {1.25, 2.5, -0.5, -7.0, 4000000000.0,
+                                          -1099511627776.0, 1.0, 0.0, 3.0};
+    EXPECT_EQ(std::vector<double>(values.begin(), values.end()), expected);
+}
+
+TEST(DecodePlan, FallsBackToF64Layout) {
+    const DecodePlan plan({ValueType::Bool, ValueType::I32});
+    PayloadWriter widened;
+    widened.put(1.0).put(42.0);
+    const auto buf = widened.frame(1, 0.0);
+
+    TelemetryHeader hdr{};
+    std::span<const double> values;
+    std::vector<double> storage;
+    ASSERT_TRUE(decode_frame(buf.data(), buf.size(), plan, hdr, values, storage));
+    ASSERT_EQ(values.size(), 2u);
+    EXPECT_DOUBLE_EQ(values[1], 42.0);
+}
+
+TEST(DecodePlan, RejectsShortPayloads) {
+    const DecodePlan plan({ValueType::I64, ValueType::I64});
+    PayloadWriter writer;
+    writer.put(int64_t{1}).put(int32_t{2}); // claims two values, 12 bytes
+    const auto buf = writer.frame(1, 0.0);
+
+    TelemetryHeader hdr{};
+    std::span<const double> values;
+    std::vector<double> storage;
+    EXPECT_FALSE(decode_frame(buf.data(), buf.size(), plan, hdr, values, storage));
+}
+
+TEST(DecodePlan, DecodesPackedI64OfF64Size) {
+    // Same payload size as two f64s: the plan, not the widened layout, applies.
+    const DecodePlan plan({ValueType::I64, ValueType::F64});
+    EXPECT_FALSE(plan.all_f64());
+    PayloadWriter writer;
+    writer.put(int64_t{42}).put(1.5);
+    const auto buf = writer.frame(3, 0.0);
+
+    TelemetryHeader hdr{};
+    std::span<const double> values;
+    std::vector<double> storage;
+    ASSERT_TRUE(decode_frame(buf.data(), buf.size(), plan, hdr, values, storage));
+    ASSERT_EQ(values.size(), 2u);
+    EXPECT_EQ(values[0], 42.0);
+    EXPECT_EQ(values[1], 1.5);
+}
+
+TEST(DecodePlan, TypedOnlyOnceNegotiated) {
+    // A server that declares i64 but never echoed typed payloads sends f64s.
+    Schema schema;
+    schema.modules.push_back({"gnc", {{"count", "i64", std::nullopt}}});
+    SubscribeAck ack{1, {"gnc.count"}};
+    const auto declared = declared_types(schema);
+    PayloadWriter writer;
+    writer.put(2.5);
+    const auto buf = writer.frame(1, 0.0);
+
+    TelemetryHeader hdr{};
+    std::span<const double> values;
+    std::vector<double> storage;
+    const DecodePlan unnegotiated = negotiated_plan(declared, ack);
+    EXPECT_TRUE(unnegotiated.all_f64());
+    ASSERT_TRUE(decode_frame(buf.data(), buf.size(), unnegotiated, hdr, values, storage));
+    EXPECT_EQ(values[0], 2.5);
+
+    ack.typed_payload = true;
+    const DecodePlan typed = negotiated_plan(declared, ack);
+    ASSERT_EQ(typed.signal_count(), 1u);
+    EXPECT_EQ(typed.type(0), ValueType::I64);
+}
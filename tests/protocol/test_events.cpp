@@ -0,0 +1,81 @@
+#include "daedalus/protocol/events.hpp"
+
+#include <gtest/gtest.h>
+
+#include <variant>
+
+using namespace daedalus::protocol;
+
+TEST(ControlEvent, ParsesSchema) {
+    auto event = parse_control_event(R"({
+        "type": "schema",
+        "modules": {"ctrl": {"signals": [{"name": "gain", "type": "f64"}]}}
+    })");
+    ASSERT_TRUE(event.has_value());
+    const auto *schema = std::get_if<Schema>(&*event);
+    ASSERT_NE(schema, nullptr);
+    ASSERT_EQ(schema->modules.size(), 1u);
+    EXPECT_EQ(schema->modules[0].signals[0].name, "gain");
+}
+
+TEST(ControlEvent, ParsesSubscribeAckAndIgnoresOtherAcks) {
+    auto event = parse_control_event(
+        R"({"type": "ack", "action": "subscribe", "count": 2, "signals": ["a.x", "a.y"]})");
+    ASSERT_TRUE(event.has_value());
+    const auto *ack = std::get_if<SubscribeAck>(&*event);
+    ASSERT_NE(ack, nullptr);
+    EXPECT_EQ(ack->count, 2u);
+    EXPECT_EQ(ack->signals, (std::vector<std::string>{"a.x", "a.y"}));
+
+    EXPECT_FALSE(parse_control_event(R"({"type": "ack", "action": "pause"})").has_value());
+}
+
+TEST(ControlEvent, ParsesSimEventsAndServerErrors) {
+    auto sim = parse_control_event(R"({"type": "event", "event": "staging"})");
+    ASSERT_TRUE(sim.has_value());
+    ASSERT_TRUE(std::holds_alternative<SimEvent>(*sim));
+    EXPECT_EQ(std::get<SimEvent>(*sim).name, "staging");
+
+    auto error = parse_control_event(R"({"type": "error", "message": "unknown signal"})");
+    ASSERT_TRUE(error.has_value());
+    ASSERT_TRUE(std::holds_alternative<ServerError>(*error));
+    EXPECT_EQ(std::get<ServerError>(*error).message, "unknown signal");
+}
+
+TEST(ControlEvent, MalformedMessagesBecomeParseFailures) {
+    for (const char *text : {
+             R"({"type": "schema", "modules": {)",
+             R"({"type": "schema", "modules": {"broken": {}}})",
+             R"({"type": "ack", "action": "subscribe", "signals": []})",
+             "not json",
+         }) {
+        auto event = parse_control_event(text);
+        ASSERT_TRUE(event.has_value()) << text;
+        EXPECT_TRUE(std::holds_alternative<ParseFailure>(*event)) << text;
+    }
+}
+
+TEST(ControlEvent, IgnoresUnknownTypes) {
+    EXPECT_FALSE(parse_control_event(R"({"type": "telemetry_hint"})").has_value());
+    EXPECT_FALSE(parse_control_event("{}").has_value());
+}
+
+TEST(EventQueue, ControlEventTransfer) {
+    EventQueue q(16);
+    Schema schema;
+    schema.modules.push_back({"vehicle", {{"position.x", "f64", "m"}}});
+
+    EXPECT_TRUE(q.try_push(std::move(schema)));
+    EXPECT_TRUE(q.try_push(SimEvent{"staging"}));
+
+    ControlEvent out;
+    ASSERT_TRUE(q.try_pop(out));
+    const auto *received = std::get_if<Schema>(&out);
+    ASSERT_NE(received, nullptr);
+    ASSERT_EQ(received->modules.size(), 1u);
+    EXPECT_EQ(received->modules[0].signals[0].name, "position.x");
+
+    ASSERT_TRUE(q.try_pop(out));
+    ASSERT_TRUE(std::holds_alternative<SimEvent>(out));
+    EXPECT_EQ(std::get<SimEvent>(out).name, "staging");
+}
@@ -0,0 +1,246 @@
+#include "daedalus/protocol/frame_batcher.hpp"
+#include "daedalus/protocol/telemetry.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace daedalus::data;
+using namespace daedalus::protocol;
+
+namespace {
+
+std::vector<uint8_t> make_frame(uint64_t frame_num, double time,
+                                const std::vector<double> &values) {
+    TelemetryHeader hdr{};
+    hdr.magic = kTelemetryMagic;
+    hdr.frame = frame_num;
+    hdr.time = time;
+    hdr.count = static_cast<uint32_t>(values.size());
+
+    std::vector<uint8_t> buf(sizeof(TelemetryHeader) + values.size() * sizeof(double));
+    std::memcpy(buf.data(), &hdr, sizeof(hdr));
+    std::memcpy(buf.data() + sizeof(hdr), values.data(), values.size() * sizeof(double));
+    return buf;
+}
+
+struct BatcherFixture : ::testing::Test {
+    TelemetryQueue queue{16};
+    BatchPool pool{32, 4, [] { return FrameBatch{}; }};
+    FrameBatcher batcher{queue, pool};
+
+    bool ingest(uint64_t frame, double time, const std::vector<double> &values) {
+        const auto buf = make_frame(frame, time, values);
+        return batcher.ingest(buf.data(), buf.size());
+    }
+};
+
+} // namespace
+
+TEST_F(BatcherFixture, PublishesImmediatelyWhenConsumerIsIdle) {
+    ASSERT_TRUE(ingest(1, 0.1, {1.0, 2.0}));
+    EXPECT_EQ(queue.size_approx(), 1u);
+
+    FrameBatch batch;
+    ASSERT_TRUE(queue.try_pop(batch));
+    ASSERT_EQ(batch.rows, 1u);
+    EXPECT_EQ(batch.signal_count, 2u);
+    EXPECT_EQ(batch.frame_column()[0], 1u);
+    EXPECT_DOUBLE_EQ(batch.column(1)[0], 2.0);
+}
+
+TEST_F(BatcherFixture, DecodesTypedPayloadsWithThePlan) {
+    batcher.set_decode_plan(DecodePlan({ValueType::Bool, ValueType::F32}));
+
+    TelemetryHeader hdr{kTelemetryMagic, 5, 0.5, 2};
+    const uint8_t armed = 1;
+    const float thrust = 12.5f;
+    std::vector<uint8_t> buf(sizeof(hdr) + 1 + sizeof(float));
+    std::memcpy(buf.data(), &hdr, sizeof(hdr));
+    std::memcpy(buf.data() + sizeof(hdr), &armed, 1);
+    std::memcpy(buf.data() + sizeof(hdr) + 1, &thrust, sizeof(float));
+    ASSERT_TRUE(batcher.ingest(buf.data(), buf.size()));
+
+    FrameBatch batch;
+    ASSERT_TRUE(queue.try_pop(batch));
+    ASSERT_EQ(batch.signal_count, 2u);
+    EXPECT_DOUBLE_EQ(batch.column(0)[0], 1.0);
+    EXPECT_DOUBLE_EQ(batch.column(1)[0], 12.5);
+}
+
+TEST_F(BatcherFixture, AccumulatesWhileConsumerIsBehind) {
+    ASSERT_TRUE(ingest(1, 0.1, {1.0}));
+    ASSERT_TRUE(ingest(2, 0.2, {2.0}));
+    ASSERT_TRUE(ingest(3, 0.3, {3.0}));
+    EXPECT_EQ(queue.size_approx(), 1u);
+
+    batcher.flush();
+    EXPECT_EQ(queue.size_approx(), 2u);
+
+    FrameBatch first;
+    FrameBatch second;
+    ASSERT_TRUE(queue.try_pop(first));
+    ASSERT_TRUE(queue.try_pop(second));
+    EXPECT_EQ(first.rows, 1u);
+    ASSERT_EQ(second.rows, 2u);
+    EXPECT_EQ(second.frame_column()[0], 2u);
+    EXPECT_DOUBLE_EQ(second.column(0)[1], 3.0);
+    EXPECT_DOUBLE_EQ(second.last_time(), 0.3);
+}
+
+TEST_F(BatcherFixture, PublishesFinalFramesOnceConsumerCatchesUp) {
+    // The stream's last frames arrive while the consumer still has a batch queued.
+    ASSERT_TRUE(ingest(1, 0.1, {1.0}));
+    ASSERT_TRUE(ingest(2, 0.2, {2.0}));
+    ASSERT_TRUE(ingest(3, 0.3, {3.0}));
+    ASSERT_EQ(queue.size_approx(), 1u);
+
+    // No further frame comes; a tick must not publish while the consumer is busy...
+    batcher.publish_stale();
+    EXPECT_EQ(queue.size_approx(), 1u);
+
+    // ...but does once it has drained the queue.
+    FrameBatch batch;
+    ASSERT_TRUE(queue.try_pop(batch));
+    pool.release(std::move(batch));
+    batcher.publish_stale();
+    ASSERT_TRUE(queue.try_pop(batch));
+    ASSERT_EQ(batch.rows, 2u);
+    EXPECT_EQ(batch.frame_column()[1], 3u);
+}
+
+TEST_F(BatcherFixture, PublishesAgedBatchWhileConsumerIsBusy) {
+    ASSERT_TRUE(ingest(1, 0.1, {1.0}));
+    ASSERT_TRUE(ingest(2, 0.2, {2.0}));
+    ASSERT_EQ(queue.size_approx(), 1u);
+
+    std::this_thread::sleep_for(FrameBatcher::kMaxBatchAge);
+    batcher.publish_stale();
+    EXPECT_EQ(queue.size_approx(), 2u);
+}
+
+TEST_F(BatcherFixture, PublishStaleFromAnotherThreadLosesNothing) {
+    std::atomic<bool> done{false};
+    std::thread ticker([&] {
+        while (!done.load(std::memory_order_relaxed)) {
+            batcher.publish_stale();
+        }
+    });
+    uint64_t popped = 0;
+    FrameBatch batch;
+    for (uint64_t i = 0; i < 2000; ++i) {
+        ASSERT_TRUE(ingest(i, 0.0, {1.0}));
+        if (i % 3 == 0) {
+            while (queue.try_pop(batch)) {
+                popped += batch.rows;
+                pool.release(std::move(batch));
+            }
+        }
+    }
+    done.store(true, std::memory_order_relaxed);
+    ticker.join();
+    batcher.flush();
+    while (queue.try_pop(batch)) {
+        popped += batch.rows;
+        pool.release(std::move(batch));
+    }
+    EXPECT_EQ(popped + queue.stats().dropped, 2000u);
+}
+
+TEST_F(BatcherFixture, SignalCountChangeStartsNewBatch) {
+    ASSERT_TRUE(ingest(1, 0.1, {1.0}));
+    ASSERT_TRUE(ingest(2, 0.2, {1.0, 2.0}));
+    batcher.flush();
+
+    FrameBatch batch;
+    ASSERT_TRUE(queue.try_pop(batch));
+    EXPECT_EQ(batch.signal_count, 1u);
+    ASSERT_TRUE(queue.try_pop(batch));
+    EXPECT_EQ(batch.signal_count, 2u);
+    EXPECT_EQ(batch.rows, 1u);
+}
+
+TEST_F(BatcherFixture, RejectsInvalidFrames) {
+    auto buf = make_frame(1, 0.0, {1.0});
+    buf[0] = 0xFF;
+    EXPECT_FALSE(batcher.ingest(buf.data(), buf.size()));
+    EXPECT_FALSE(batcher.ingest(buf.data(), 4));
+    EXPECT_EQ(batcher.frames_rejected(), 2u);
+    EXPECT_EQ(batcher.frames_decoded(), 0u);
+    EXPECT_EQ(queue.size_approx(), 0u);
+}
+
+TEST_F(BatcherFixture, RejectedBatchIsCountedByQueue) {
+    const std::vector<double> wide(FrameBatcher::kTargetBatchBytes / sizeof(double), 1.0);
+    ASSERT_EQ(FrameBatcher::rows_for(wide.size()), 1u);
+
+    for (size_t i = 0; i < queue.capacity(); ++i) {
+        ASSERT_TRUE(ingest(i, 0.0, wide));
+    }
+    EXPECT_EQ(queue.stats().dropped, 0u);
+    ASSERT_TRUE(ingest(99, 1.0, wide));
+    EXPECT_EQ(queue.stats().dropped, 1u);
+    EXPECT_EQ(batcher.frames_decoded(), queue.capacity() + 1);
+
+    // The dropped rows must not resurface on the next publish.
+    FrameBatch batch;
+    while (queue.try_pop(batch)) {
+        EXPECT_NE(batch.frame_column()[0], 99u);
+    }
+    batcher.flush();
+    EXPECT_EQ(queue.size_approx(), 0u);
+}
+
+TEST_F(BatcherFixture, DropOldestKeepsNewestBatchAndRecyclesEvicted) {
+    // Eviction needs a queue built with an evicting policy.
+    TelemetryQueue evicting{16, OverflowPolicy::DropOldest};
+    FrameBatcher evicting_batcher{evicting, pool};
+    size_t evicted = 0;
+    evicting.set_discard_handler([&](FrameBatch &&batch) {
+        ++evicted;
+        pool.reclaim(std::move(batch));
+    });
+    const std::vector<double> wide(FrameBatcher::kTargetBatchBytes / sizeof(double), 1.0);
+
+    for (size_t i = 0; i <= evicting.capacity(); ++i) {
+        const auto buf = make_frame(i, static_cast<double>(i), wide);
+        ASSERT_TRUE(evicting_batcher.ingest(buf.data(), buf.size()));
+    }
+    EXPECT_EQ(evicted, 1u);
+    EXPECT_EQ(evicting.stats().dropped, 1u);
+
+    FrameBatch batch;
+    ASSERT_TRUE(evicting.try_pop(batch));
+    EXPECT_EQ(batch.frame_column()[0], 1u);
+}
+
+TEST_F(BatcherFixture, RecycledBatchesAvoidAllocation) {
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(ingest(static_cast<uint64_t>(i), 0.0, {1.0, 2.0, 3.0}));
+        FrameBatch batch;
+        ASSERT_TRUE(queue.try_pop(batch));
+        pool.release(std::move(batch));
+    }
+    // Only the prewarmed (empty) batches ever needed storage.
+    EXPECT_LE(pool.stats().allocations, 4u);
+}
+
+TEST_F(BatcherFixture, FeedsStreamHealth) {
+    ASSERT_TRUE(ingest(1, 0.1, {1.0}));
+    ASSERT_TRUE(ingest(4, 0.4, {1.0}));
+    const auto health = batcher.health().stats();
+    EXPECT_EQ(health.frames, 2u);
+    EXPECT_EQ(health.gaps, 1u);
+    EXPECT_EQ(health.missing_frames, 2u);
+    EXPECT_DOUBLE_EQ(health.last_sim_time, 0.4);
+}
+
+TEST(FrameBatcherRows, RowsScaleWithSignalCount) {
+    EXPECT_EQ(FrameBatcher::rows_for(0), FrameBatcher::kMaxRows);
+    EXPECT_EQ(FrameBatcher::rows_for(4), FrameBatcher::kMaxRows);
+    EXPECT_EQ(FrameBatcher::rows_for(500), FrameBatcher::kTargetBatchBytes / (500 * 8));
+    EXPECT_EQ(FrameBatcher::rows_for(1000000), 1u);
+}
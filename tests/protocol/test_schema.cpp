@@ -144,6 +144,22 @@ TEST(SubscribeAckParser, ValidAck) {
     EXPECT_EQ(ack.signals[3], "vehicle.velocity.y");
 }
 
+TEST(SubscribeAckParser, TypedPayloadOnlyWhenEchoed) {
+    auto msg = nlohmann::json::parse(R"({
+        "type": "ack",
+        "action": "subscribe",
+        "count": 1,
+        "signals": ["gnc.mode"]
+    })");
+    EXPECT_FALSE(parse_subscribe_ack(msg).typed_payload);
+
+    msg["payload"] = "typed";
+    EXPECT_TRUE(parse_subscribe_ack(msg).typed_payload);
+
+    msg["payload"] = "f64";
+    EXPECT_FALSE(parse_subscribe_ack(msg).typed_payload);
+}
+
 TEST(SubscribeAckParser, OrderPreserved) {
     auto msg = nlohmann::json::parse(R"({
         "type": "ack",
@@ -166,3 +182,107 @@ TEST(SubscribeAckParser, WrongAction) {
 
     EXPECT_THROW(parse_subscribe_ack(msg), std::runtime_error);
 }
+
+TEST(StreamingSchemaParser, MatchesDomParser) {
+    const std::string text = R"({
+        "modules": {
+            "rocket": {
+                "extra": {"ignored": [1, 2, {"name": "x"}]},
+                "signals": [
+                    {"name": "position.x", "type": "f64", "unit": "m", "tags": ["a"]},
+                    {"unit": 5, "type": "i32", "name": "stage"}
+                ]
+            },
+            "inputs": {"signals": [{"name": "throttle", "type": "f64"}]}
+        },
+        "type": "schema"
+    })";
+
+    const auto streamed = parse_schema_text(text);
+    const auto parsed = parse_schema(nlohmann::json::parse(text));
+    ASSERT_EQ(streamed.modules.size(), parsed.modules.size());
+    for (const auto &mod : parsed.modules) {
+        const ModuleInfo *match = nullptr;
+        for (const auto &candidate : streamed.modules) {
+            if (candidate.name == mod.name) {
+                match = &candidate;
+            }
+        }
+        ASSERT_NE(match, nullptr) << mod.name;
+        ASSERT_EQ(match->signals.size(), mod.signals.size());
+        for (size_t i = 0; i < mod.signals.size(); ++i) {
+            EXPECT_EQ(match->signals[i].name, mod.signals[i].name);
+            EXPECT_EQ(match->signals[i].type, mod.signals[i].type);
+            EXPECT_EQ(match->signals[i].unit, mod.signals[i].unit);
+        }
+    }
+}
+
+TEST(StreamingSchemaParser, RejectsWhatTheDomParserRejects) {
+    for (const char *text : {
+             R"({"modules": {}})",
+             R"({"type": "ack", "modules": {}})",
+             R"({"type": "schema"})",
+             R"({"type": "schema", "modules": []})",
+             R"({"type": "schema", "modules": {"broken": {}}})",
+             R"({"type": "schema", "modules": {"broken": {"signals": {}}}})",
+             R"({"type": "schema", "modules": {"m": {"signals": [{"type": "f64"}]}}})",
+             R"({"type": "schema", "modules": {"m": {"signals": [{"name": 1, "type": "f64"}]}}})",
+             R"({"type": "schema", "modules": {"m": {"signals": [{"name": "x"}]}}})",
+             R"({"type": "schema", "modules": {"m": {"signals": ["x"]}}})",
+         }) {
+        EXPECT_THROW(parse_schema(nlohmann::json::parse(text)), std::runtime_error) << text;
+        EXPECT_THROW(parse_schema_text(text), std::runtime_error) << text;
+    }
+    EXPECT_THROW(parse_schema_text(R"({"type": "schema", "modules": {)"), std::runtime_error);
+}
+
+TEST(StreamingSubscribeAckParser, MatchesDomParser) {
+    const std::string text = R"({
+        "signals": ["z.signal", "a.signal", "m.signal"],
+        "count": 3,
+        "payload": "typed",
+        "action": "subscribe",
+        "type": "ack"
+    })";
+
+    const auto streamed = parse_subscribe_ack_text(text);
+    const auto parsed = parse_subscribe_ack(nlohmann::json::parse(text));
+    EXPECT_EQ(streamed.count, parsed.count);
+    EXPECT_EQ(streamed.signals, parsed.signals);
+    EXPECT_TRUE(streamed.typed_payload);
+    EXPECT_EQ(streamed.typed_payload, parsed.typed_payload);
+    EXPECT_FALSE(parse_subscribe_ack_text(
+                     R"({"type": "ack", "action": "subscribe", "count": 0, "signals": [],)"
+                     R"( "payload": {"kind": "typed"}})")
+                     .typed_payload);
+}
+
+TEST(StreamingSubscribeAckParser, RejectsMalformedAcks) {
+    for (const char *text : {
+             R"({"type": "ack", "action": "pause"})",
+             R"({"type": "event", "action": "subscribe", "count": 0, "signals": []})",
+             R"({"type": "ack", "action": "subscribe", "signals": []})",
+             R"({"type": "ack", "action": "subscribe", "count": -1, "signals": []})",
+             R"({"type": "ack", "action": "subscribe", "count": 1})",
+             R"({"type": "ack", "action": "subscribe", "count": 1, "signals": {}})",
+             R"({"type": "ack", "action": "subscribe", "count": 1, "signals": [1]})",
+         }) {
+        EXPECT_THROW(parse_subscribe_ack_text(text), std::runtime_error) << text;
+    }
+}
+
+TEST(MessageKind, ReadsTypeAndAction) {
+    const auto schema = peek_message_kind(R"({"type": "schema", "modules": {"m": {}}})");
+    EXPECT_EQ(schema.type, "schema");
+
+    const auto ack = peek_message_kind(R"({"count": 1, "type": "ack", "action": "subscribe"})");
+    EXPECT_EQ(ack.type, "ack");
+    EXPECT_EQ(ack.action, "subscribe");
+
+    // A nested "type" is not the message's.
+    const auto nested = peek_message_kind(R"({"data": {"type": "schema"}, "type": "event"})");
+    EXPECT_EQ(nested.type, "event");
+
+    EXPECT_TRUE(peek_message_kind("{}").type.empty());
+}
@@ -0,0 +1,141 @@
+#include "daedalus/protocol/stream_health.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace daedalus::protocol;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct HealthFixture : ::testing::Test {
+    StreamHealth health;
+    StreamHealth::Clock::time_point t0 = StreamHealth::Clock::now();
+
+    /// Feed frames first..last at `hz` simulated and wall-clock rate.
+    void feed(uint64_t first, uint64_t last, double hz, double rtf = 1.0) {
+        for (uint64_t f = first; f <= last; ++f) {
+            const double sim_time = static_cast<double>(f) / hz;
+            const auto wall = std::chrono::duration<double>(sim_time / rtf);
+            health.observe(f, sim_time,
+                           t0 + std::chrono::duration_cast<StreamHealth::Clock::duration>(wall));
+        }
+    }
+};
+
+} // namespace
+
+TEST_F(HealthFixture, ContiguousStreamIsClean) {
+    feed(1, 100, 60.0);
+    const auto s = health.stats(t0);
+    EXPECT_EQ(s.frames, 100u);
+    EXPECT_EQ(s.gaps, 0u);
+    EXPECT_EQ(s.missing_frames, 0u);
+    EXPECT_EQ(s.duplicates, 0u);
+    EXPECT_EQ(s.reordered, 0u);
+    EXPECT_EQ(s.last_frame, 100u);
+}
+
+TEST_F(HealthFixture, DetectsGapsAndMissingFrames) {
+    feed(1, 10, 60.0);
+    feed(15, 20, 60.0); // 11..14 missing
+    feed(22, 22, 60.0); // 21 missing
+    const auto s = health.stats(t0);
+    EXPECT_EQ(s.gaps, 2u);
+    EXPECT_EQ(s.missing_frames, 5u);
+}
+
+TEST_F(HealthFixture, DetectsDuplicates) {
+    feed(1, 5, 60.0);
+    feed(5, 5, 60.0);
+    const auto s = health.stats(t0);
+    EXPECT_EQ(s.duplicates, 1u);
+    EXPECT_EQ(s.last_frame, 5u);
+}
+
+TEST_F(HealthFixture, LateFrameCountsAsReorderedAndFillsGap) {
+    feed(1, 5, 60.0);
+    feed(7, 7, 60.0);
+    feed(6, 6, 60.0);
+    const auto s = health.stats(t0);
+    EXPECT_EQ(s.gaps, 1u);
+    EXPECT_EQ(s.reordered, 1u);
+    EXPECT_EQ(s.missing_frames, 0u);
+    EXPECT_EQ(s.last_frame, 7u);
+}
+
+TEST_F(HealthFixture, ResentOlderFrameIsDuplicateAndKeepsGap) {
+    feed(1, 5, 60.0);
+    feed(8, 8, 60.0); // 6 and 7 missing
+    feed(4, 4, 60.0); // re-sent, not late
+    feed(6, 6, 60.0); // late
+    feed(6, 6, 60.0); // re-sent late frame
+    const auto s = health.stats(t0);
+    EXPECT_EQ(s.gaps, 1u);
+    EXPECT_EQ(s.duplicates, 2u);
+    EXPECT_EQ(s.reordered, 1u);
+    EXPECT_EQ(s.missing_frames, 1u); // 7 is still lost
+    EXPECT_EQ(s.last_frame, 8u);
+}
+
+TEST_F(HealthFixture, FrameFromBeforeBaselineFillsNoGap) {
+    feed(10, 10, 60.0);
+    feed(12, 12, 60.0); // 11 missing
+    feed(9, 9, 60.0);   // late, but never counted as missing
+    const auto s = health.stats(t0);
+    EXPECT_EQ(s.reordered, 1u);
+    EXPECT_EQ(s.missing_frames, 1u);
+}
+
+TEST_F(HealthFixture, HolesOutsideTheWindowStayMissing) {
+    feed(1, 1, 60.0);
+    feed(3, 3, 60.0); // 2 missing
+    feed(3 + StreamHealth::kReorderWindow, 3 + StreamHealth::kReorderWindow, 60.0);
+    feed(2, 2, 60.0); // too far behind: a restart
+    const auto s = health.stats(t0);
+    EXPECT_EQ(s.restarts, 1u);
+    EXPECT_EQ(s.reordered, 0u);
+    EXPECT_EQ(s.missing_frames, StreamHealth::kReorderWindow);
+}
+
+TEST_F(HealthFixture, CounterResetIsRestartNotReorder) {
+    feed(1, 30, 60.0);
+    feed(0, 5, 60.0);
+    const auto s = health.stats(t0);
+    EXPECT_EQ(s.restarts, 1u);
+    EXPECT_EQ(s.reordered, 0u);
+    EXPECT_EQ(s.gaps, 0u);
+    EXPECT_EQ(s.last_frame, 5u);
+}
+
+TEST_F(HealthFixture, EstimatesRatesAtRealTime) {
+    feed(0, 600, 60.0); // 10 s of 60 Hz
+    const auto s = health.stats(t0);
+    EXPECT_NEAR(s.receive_rate_hz, 60.0, 1.0);
+    EXPECT_NEAR(s.sim_rate_hz, 60.0, 1.0);
+    EXPECT_NEAR(s.real_time_factor, 1.0, 0.02);
+}
+
+TEST_F(HealthFixture, EstimatesFasterThanRealTime) {
+    feed(0, 1200, 100.0, 4.0); // 100 Hz sim running at 4x
+    const auto s = health.stats(t0);
+    EXPECT_NEAR(s.sim_rate_hz, 100.0, 1.0);
+    EXPECT_NEAR(s.receive_rate_hz, 400.0, 5.0);
+    EXPECT_NEAR(s.real_time_factor, 4.0, 0.1);
+}
+
+TEST_F(HealthFixture, ResetBaselineIgnoresNewCounter) {
+    feed(100, 200, 60.0);
+    health.reset_baseline();
+    feed(1, 10, 60.0);
+    const auto s = health.stats(t0);
+    EXPECT_EQ(s.gaps, 0u);
+    EXPECT_EQ(s.restarts, 0u);
+    EXPECT_EQ(s.reordered, 0u);
+    EXPECT_EQ(s.frames, 111u);
+}
+
+TEST_F(HealthFixture, ReportsTimeSinceLastFrame) {
+    EXPECT_DOUBLE_EQ(health.stats(t0).seconds_since_last_frame, 0.0);
+    health.observe(1, 0.0, t0);
+    EXPECT_NEAR(health.stats(t0 + 2s).seconds_since_last_frame, 2.0, 1e-6);
+}
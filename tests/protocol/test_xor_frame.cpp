@@ -0,0 +1,138 @@
+#include "daedalus/protocol/frame_batcher.hpp"
+#include "daedalus/protocol/xor_frame.hpp"
+#include "xor_frame_encoder.hpp"
+
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace daedalus::protocol;
+using daedalus::protocol::testing::XorFrameEncoder;
+
+namespace {
+
+/// Rows like an Icarus vehicle: a few fast-changing states, many constants.
+std::vector<double> make_row(uint64_t frame, size_t signals) {
+    std::vector<double> row(signals);
+    for (size_t s = 0; s < signals; ++s) {
+        row[s] = s < 8 ? std::sin(0.01 * static_cast<double>(frame) + static_cast<double>(s))
+                       : 100.0 + static_cast<double>(s);
+    }
+    return row;
+}
+
+} // namespace
+
+TEST(XorFrame, RoundTripsAStream) {
+    XorFrameEncoder encoder(16);
+    XorFrameDecoder decoder;
+    for (uint64_t frame = 0; frame < 100; ++frame) {
+        const auto row = make_row(frame, 90);
+        const auto buf = encoder.encode(frame, 0.01 * static_cast<double>(frame), row);
+
+        TelemetryHeader hdr{};
+        std::span<const double> values;
+        ASSERT_TRUE(decoder.decode(buf.data(), buf.size(), hdr, values)) << frame;
+        EXPECT_EQ(hdr.frame, frame);
+        EXPECT_EQ(hdr.count, 90u);
+        ASSERT_EQ(std::vector<double>(values.begin(), values.end()), row) << frame;
+    }
+}
+
+TEST(XorFrame, UnchangedSignalsCostOneBit) {
+    XorFrameEncoder encoder;
+    const auto row = make_row(0, 90);
+    const auto key = encoder.encode(0, 0.0, row);
+    const auto delta = encoder.encode(1, 0.01, row);
+    // Header, flags and a 12-byte bitmap; nothing changed, so no stream.
+    EXPECT_EQ(delta.size(), sizeof(TelemetryHeader) + 1 + 12);
+    EXPECT_LT(key.size(), sizeof(TelemetryHeader) + 90 * sizeof(double));
+
+    XorFrameDecoder decoder;
+    TelemetryHeader hdr{};
+    std::span<const double> values;
+    ASSERT_TRUE(decoder.decode(key.data(), key.size(), hdr, values));
+    ASSERT_TRUE(decoder.decode(delta.data(), delta.size(), hdr, values));
+    EXPECT_EQ(std::vector<double>(values.begin(), values.end()), row);
+}
+
+TEST(XorFrame, PreservesSpecialValues) {
+    const std::vector<double> row = {0.0,
+                                     -0.0,
+                                     std::numeric_limits<double>::infinity(),
+                                     std::numeric_limits<double>::denorm_min(),
+                                     std::numeric_limits<double>::max(),
+                                     -1.0};
+    XorFrameEncoder encoder;
+    XorFrameDecoder decoder;
+    TelemetryHeader hdr{};
+    std::span<const double> values;
+    const auto buf = encoder.encode(3, 0.0, row);
+    ASSERT_TRUE(decoder.decode(buf.data(), buf.size(), hdr, values));
+    ASSERT_EQ(values.size(), row.size());
+    for (size_t i = 0; i < row.size(); ++i) {
+        EXPECT_EQ(std::bit_cast<uint64_t>(values[i]), std::bit_cast<uint64_t>(row[i])) << i;
+    }
+}
+
+TEST(XorFrame, DeltaWithoutKeyframeIsRejectedUntilNextKeyframe) {
+    XorFrameEncoder encoder(4);
+    std::vector<std::vector<uint8_t>> frames;
+    for (uint64_t frame = 0; frame < 6; ++frame) {
+        frames.push_back(encoder.encode(frame, 0.0, make_row(frame, 10)));
+    }
+
+    XorFrameDecoder decoder;
+    TelemetryHeader hdr{};
+    std::span<const double> values;
+    EXPECT_FALSE(decoder.decode(frames[1].data(), frames[1].size(), hdr, values));
+    EXPECT_FALSE(decoder.synced());
+    // Frame 4 is the next keyframe; frame 5 decodes against it.
+    ASSERT_TRUE(decoder.decode(frames[4].data(), frames[4].size(), hdr, values));
+    ASSERT_TRUE(decoder.decode(frames[5].data(), frames[5].size(), hdr, values));
+    EXPECT_EQ(std::vector<double>(values.begin(), values.end()), make_row(5, 10));
+}
+
+TEST(XorFrame, TruncatedStreamLosesSync) {
+    XorFrameEncoder encoder;
+    XorFrameDecoder decoder;
+    TelemetryHeader hdr{};
+    std::span<const double> values;
+    auto buf = encoder.encode(0, 0.0, make_row(0, 16));
+    buf.resize(buf.size() - 3);
+    EXPECT_FALSE(decoder.decode(buf.data(), buf.size(), hdr, values));
+    EXPECT_FALSE(decoder.synced());
+}
+
+TEST(XorFrame, BatcherDecodesBothEncodings) {
+    daedalus::data::TelemetryQueue queue{16};
+    daedalus::data::BatchPool pool{32, 4, [] { return daedalus::data::FrameBatch{}; }};
+    FrameBatcher batcher{queue, pool};
+    XorFrameEncoder encoder;
+
+    const auto compressed = encoder.encode(1, 0.1, make_row(1, 4));
+    ASSERT_TRUE(batcher.ingest(compressed.data(), compressed.size()));
+
+    const auto row = make_row(2, 4);
+    TelemetryHeader hdr{kTelemetryMagic, 2, 0.2, 4};
+    std::vector<uint8_t> plain(sizeof(hdr) + row.size() * sizeof(double));
+    std::memcpy(plain.data(), &hdr, sizeof(hdr));
+    std::memcpy(plain.data() + sizeof(hdr), row.data(), row.size() * sizeof(double));
+    ASSERT_TRUE(batcher.ingest(plain.data(), plain.size()));
+    EXPECT_EQ(batcher.frames_compressed(), 1u);
+    EXPECT_EQ(batcher.frames_decoded(), 2u);
+
+    batcher.flush();
+    daedalus::data::FrameBatch batch;
+    std::vector<double> column0;
+    while (queue.try_pop(batch)) {
+        for (const double v : batch.column(0)) {
+            column0.push_back(v);
+        }
+    }
+    EXPECT_EQ(column0, (std::vector<double>{make_row(1, 4)[0], row[0]}));
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+// Reference encoder for the "HERX" compressed telemetry frames, standing in for
+// the Hermes side in tests. See daedalus/protocol/xor_frame.hpp for the layout.
+
+#include "daedalus/protocol/xor_frame.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace daedalus::protocol::testing {
+
+class XorFrameEncoder {
+  public:
+    /// Emit a keyframe every `keyframe_interval` frames (and whenever the row
+    /// width changes).
+    explicit XorFrameEncoder(size_t keyframe_interval = 256)
+        : keyframe_interval_(keyframe_interval) {}
+
+    std::vector<uint8_t> encode(uint64_t frame, double time, std::span<const double> values) {
+        const bool keyframe = previous_.size() != values.size() || since_keyframe_ == 0;
+        since_keyframe_ = (since_keyframe_ + 1) % keyframe_interval_;
+        if (keyframe) {
+            previous_.assign(values.size(), 0);
+            lead_.assign(values.size(), 0);
+            meaning_.assign(values.size(), 0);
+        }
+
+        TelemetryHeader hdr{kCompressedTelemetryMagic, frame, time,
+                            static_cast<uint32_t>(values.size())};
+        std::vector<uint8_t> out(sizeof(hdr) + 1 + (values.size() + 7) / 8, 0);
+        std::memcpy(out.data(), &hdr, sizeof(hdr));
+        out[sizeof(hdr)] = keyframe ? XorFrameDecoder::kKeyframeFlag : 0;
+        uint8_t *bitmap = out.data() + sizeof(hdr) + 1;
+
+        bits_.clear();
+        bit_count_ = 0;
+        for (size_t s = 0; s < values.size(); ++s) {
+            const uint64_t current = std::bit_cast<uint64_t>(values[s]);
+            const uint64_t diff = current ^ previous_[s];
+            previous_[s] = current;
+            if (diff == 0) {
+                continue;
+            }
+            bitmap[s / 8] |= static_cast<uint8_t>(1u << (s % 8));
+
+            const auto lead = static_cast<unsigned>(std::countl_zero(diff));
+            const auto trail = static_cast<unsigned>(std::countr_zero(diff));
+            if (meaning_[s] != 0 && lead >= lead_[s] && trail >= 64u - lead_[s] - meaning_[s]) {
+                put(0, 1);
+            } else {
+                lead_[s] = static_cast<uint8_t>(lead);
+                meaning_[s] = static_cast<uint8_t>(64u - lead - trail);
+                put(1, 1);
+                put(lead, 6);
+                put(meaning_[s] - 1u, 6);
+            }
+            put(diff >> (64u - lead_[s] - meaning_[s]), meaning_[s]);
+        }
+        out.insert(out.end(), bits_.begin(), bits_.end());
+        return out;
+    }
+
+  private:
+    /// Append the low `count` bits of `value`, MSB first.
+    void put(uint64_t value, unsigned count) {
+        for (unsigned i = count; i-- > 0;) {
+            if (bit_count_ % 8 == 0) {
+                bits_.push_back(0);
+            }
+            bits_.back() |= static_cast<uint8_t>(((value >> i) & 1u) << (7 - bit_count_ % 8));
+            ++bit_count_;
+        }
+    }
+
+    size_t keyframe_interval_;
+    size_t since_keyframe_ = 0;
+    std::vector<uint64_t> previous_;
+    std::vector<uint8_t> lead_;
+    std::vector<uint8_t> meaning_;
+    std::vector<uint8_t> bits_;
+    size_t bit_count_ = 0;
+};
+
+} // namespace daedalus::protocol::testing
@@ -0,0 +1,87 @@
+#pragma once
+
+// Shared fixtures for the session recorder, reader and replay tests: a per-test
+// session file, a two-signal layout and frames that match it.
+
+#include "daedalus/protocol/telemetry.hpp"
+#include "daedalus/record/session_recorder.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace daedalus::record::testing {
+
+/// A schema and subscribe ack for two signals: f64 veh.x and i32 veh.mode, with
+/// typed payloads negotiated.
+inline const std::string kSchema =
+    R"({"type":"schema","modules":{"veh":{"signals":[{"name":"x","type":"f64"},)"
+    R"({"name":"mode","type":"i32"}]}}})";
+inline const std::string kAck =
+    R"({"type":"ack","action":"subscribe","count":2,"signals":["veh.x","veh.mode"],)"
+    R"("payload":"typed"})";
+
+/// A "HERT" frame of `signals` zero f64 values, at 100 Hz sim time.
+inline std::vector<uint8_t> plain_frame(uint64_t frame, size_t signals) {
+    const protocol::TelemetryHeader hdr{protocol::kTelemetryMagic, frame,
+                                        0.01 * static_cast<double>(frame),
+                                        static_cast<uint32_t>(signals)};
+    std::vector<uint8_t> out(sizeof(hdr) + signals * sizeof(double), 0);
+    std::memcpy(out.data(), &hdr, sizeof(hdr));
+    return out;
+}
+
+/// A "HERT" frame laid out as kAck says: f64 x = frame / 2, i32 mode = frame % 7,
+/// at 100 Hz sim time.
+inline std::vector<uint8_t> typed_frame(uint64_t frame) {
+    const protocol::TelemetryHeader hdr{protocol::kTelemetryMagic, frame,
+                                        0.01 * static_cast<double>(frame), 2};
+    std::vector<uint8_t> out(sizeof(hdr) + sizeof(double) + sizeof(int32_t));
+    const double x = static_cast<double>(frame) / 2.0;
+    const auto mode = static_cast<int32_t>(frame % 7);
+    std::memcpy(out.data(), &hdr, sizeof(hdr));
+    std::memcpy(out.data() + sizeof(hdr), &x, sizeof(x));
+    std::memcpy(out.data() + sizeof(hdr) + sizeof(x), &mode, sizeof(mode));
+    return out;
+}
+
+/// A session file in the temp directory, named after the running test and
+/// removed after it.
+struct SessionFileTest : ::testing::Test {
+    std::filesystem::path path = [] {
+        const auto *info = ::testing::UnitTest::GetInstance()->current_test_info();
+        return std::filesystem::temp_directory_path() /
+               ("daedalus_" + std::string(info->test_suite_name()) + "_" + info->name() +
+                ".daedalus");
+    }();
+
+    void TearDown() override { std::filesystem::remove(path); }
+
+    /// Record kSchema, kAck and frames make_frame(0 .. frames - 1), `spacing`
+    /// apart in receive time.
+    template <typename MakeFrame>
+    void record_session(uint64_t frames, MakeFrame make_frame,
+                        std::chrono::microseconds spacing = {}) {
+        SessionRecorder recorder;
+        ASSERT_TRUE(recorder.start(path.string()));
+        ASSERT_TRUE(recorder.record_text(kSchema));
+        ASSERT_TRUE(recorder.record_text(kAck));
+        for (uint64_t f = 0; f < frames; ++f) {
+            const auto frame = make_frame(f);
+            ASSERT_TRUE(recorder.record_frame(frame.data(), frame.size()));
+            if (spacing.count() > 0) {
+                std::this_thread::sleep_for(spacing);
+            }
+        }
+        recorder.stop();
+        ASSERT_EQ(recorder.stats().dropped, 0u);
+    }
+};
+
+} // namespace daedalus::record::testing
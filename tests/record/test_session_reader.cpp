@@ -0,0 +1,223 @@
+#include "daedalus/record/session_reader.hpp"
+#include "daedalus/record/session_recorder.hpp"
+#include "../protocol/xor_frame_encoder.hpp"
+#include "session_test_util.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace daedalus::record;
+using daedalus::record::testing::kAck;
+using daedalus::record::testing::kSchema;
+using daedalus::record::testing::plain_frame;
+using daedalus::record::testing::SessionFileTest;
+
+namespace {
+
+struct ReaderFixture : SessionFileTest {
+    /// Record a schema, an ack and `frames` plain frames of 1 KiB.
+    void record_plain(uint64_t frames) {
+        record_session(frames, [](uint64_t f) { return plain_frame(f, 125); });
+    }
+};
+
+/// Walk forward from `offset` to the first frame at or after `time`.
+std::optional<SessionReader::Record> scan_to_time(const SessionReader &reader, uint64_t offset,
+                                                  double time) {
+    while (auto record = reader.read(offset)) {
+        if (record->kind == RecordKind::Frame && frame_info(record->payload)->time >= time) {
+            return record;
+        }
+        offset = record->next();
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+TEST_F(ReaderFixture, SeeksAFinishedRecordingThroughItsIndex) {
+    record_plain(5000);
+
+    SessionReader reader;
+    ASSERT_TRUE(reader.open(path.string()));
+    EXPECT_FALSE(reader.recovered());
+    EXPECT_EQ(reader.frame_records(), 5000u);
+    EXPECT_EQ(reader.last_frame(), 4999u);
+    EXPECT_DOUBLE_EQ(reader.last_time(), 49.99);
+
+    // Sparse: about one entry per kSpacingBytes of 1 KiB frames, each at a frame
+    // whose layout records are the schema and ack.
+    const auto index = reader.index();
+    ASSERT_GE(index.size(), 5000 * 1040 / SessionIndexer::kSpacingBytes);
+    ASSERT_LE(index.size(), 5000 * 1040 / SessionIndexer::kSpacingBytes + 2);
+    const auto schema = reader.read(index.front().schema_offset);
+    const auto ack = reader.read(index.front().ack_offset);
+    ASSERT_TRUE(schema && ack);
+    EXPECT_EQ(std::string(schema->payload.begin(), schema->payload.end()), kSchema);
+    EXPECT_EQ(std::string(ack->payload.begin(), ack->payload.end()), kAck);
+    for (const auto &entry : index) {
+        const auto record = reader.read(entry.offset);
+        ASSERT_TRUE(record);
+        ASSERT_EQ(record->kind, RecordKind::Frame);
+        EXPECT_EQ(frame_info(record->payload)->frame, entry.frame);
+    }
+
+    for (const double t : {0.0, 0.004, 12.34, 18.342, 49.99}) {
+        const IndexEntry *entry = reader.seek_time(t, 0);
+        ASSERT_NE(entry, nullptr);
+        EXPECT_LE(entry->time, t + 1e-9);
+        if (entry != &index.back()) {
+            EXPECT_GT((entry + 1)->time, t);
+        }
+        const auto found = scan_to_time(reader, entry->offset, t - 1e-9);
+        ASSERT_TRUE(found);
+        EXPECT_LE(found->offset - entry->offset, SessionIndexer::kSpacingBytes);
+        EXPECT_NEAR(frame_info(found->payload)->time, t, 0.01);
+    }
+    EXPECT_EQ(reader.seek_time(-5.0, 0), &index.front());
+    EXPECT_EQ(reader.seek_time(1e9, 0), &index.back());
+
+    const IndexEntry *by_frame = reader.seek_frame(2500, 0);
+    ASSERT_NE(by_frame, nullptr);
+    EXPECT_LE(by_frame->frame, 2500u);
+    EXPECT_EQ(by_frame, reader.seek_time(25.0, 0));
+}
+
+TEST_F(ReaderFixture, SeeksWithinEachRunOfARecordingThatSpansARestart) {
+    // A reconnect to a restarted Hermes: frame numbers and times begin again at 0.
+    SessionRecorder recorder;
+    ASSERT_TRUE(recorder.start(path.string()));
+    for (int run = 0; run < 2; ++run) {
+        ASSERT_TRUE(recorder.record_text(kSchema));
+        ASSERT_TRUE(recorder.record_text(kAck));
+        for (uint64_t f = 0; f < 2000; ++f) {
+            const auto frame = plain_frame(f, 125);
+            ASSERT_TRUE(recorder.record_frame(frame.data(), frame.size()));
+        }
+    }
+    recorder.stop();
+
+    SessionReader reader;
+    ASSERT_TRUE(reader.open(path.string()));
+    ASSERT_EQ(reader.segments(), 2u);
+    const auto index = reader.index();
+    const uint64_t second_run = std::find_if(index.begin(), index.end(), [](const IndexEntry &e) {
+                                    return e.segment == 1;
+                                })->offset;
+    EXPECT_EQ(frame_info(reader.read(second_run)->payload)->frame, 0u);
+
+    for (const uint32_t segment : {0u, 1u}) {
+        for (const double t : {0.0, 7.5, 19.99}) {
+            const IndexEntry *entry = reader.seek_time(t, segment);
+            ASSERT_NE(entry, nullptr);
+            EXPECT_EQ(entry->segment, segment);
+            EXPECT_LE(entry->time, t + 1e-9);
+            EXPECT_EQ(entry->offset >= second_run, segment == 1);
+            const auto found = scan_to_time(reader, entry->offset, t - 1e-9);
+            ASSERT_TRUE(found);
+            EXPECT_NEAR(frame_info(found->payload)->time, t, 0.01);
+        }
+        const IndexEntry *by_frame = reader.seek_frame(1000, segment);
+        ASSERT_NE(by_frame, nullptr);
+        EXPECT_EQ(by_frame->segment, segment);
+        EXPECT_LE(by_frame->frame, 1000u);
+        EXPECT_EQ(reader.segment_at(by_frame->offset), segment);
+    }
+    EXPECT_EQ(reader.seek_time(1.0, 2), nullptr);
+
+    // A rebuilt index finds the same runs.
+    std::filesystem::resize_file(path, reader.records_end());
+    reader.close();
+    ASSERT_TRUE(reader.open(path.string()));
+    EXPECT_TRUE(reader.recovered());
+    EXPECT_EQ(reader.segments(), 2u);
+    EXPECT_EQ(reader.seek_frame(0, 1)->offset, second_run);
+}
+
+TEST_F(ReaderFixture, RebuildsAndRepairsTheIndexOfATruncatedFile) {
+    record_plain(3000);
+    std::vector<IndexEntry> finished;
+    uint64_t cut = 0;
+    {
+        SessionReader reader;
+        ASSERT_TRUE(reader.open(path.string()));
+        finished.assign(reader.index().begin(), reader.index().end());
+        cut = reader.seek_frame(2000, 0)->offset + 100; // mid-record, as a crash leaves it
+    }
+    std::filesystem::resize_file(path, cut);
+
+    SessionReader reader;
+    ASSERT_TRUE(reader.open(path.string()));
+    EXPECT_TRUE(reader.recovered());
+    const uint64_t frames = reader.frame_records();
+    EXPECT_LT(frames, 3000u);
+    EXPECT_EQ(reader.last_frame(), frames - 1);
+    EXPECT_LE(reader.records_end(), cut);
+    ASSERT_FALSE(reader.index().empty());
+    for (size_t i = 0; i < reader.index().size(); ++i) {
+        EXPECT_EQ(reader.index()[i].offset, finished[i].offset);
+        EXPECT_EQ(reader.index()[i].frame, finished[i].frame);
+    }
+    const size_t entries = reader.index().size();
+
+    ASSERT_TRUE(reader.repair());
+    EXPECT_FALSE(reader.recovered());
+    EXPECT_EQ(reader.index().size(), entries);
+    EXPECT_EQ(reader.frame_records(), frames);
+    EXPECT_EQ(std::filesystem::file_size(path),
+              reader.records_end() + record_bytes(entries * sizeof(IndexEntry)) +
+                  sizeof(SessionTrailer));
+}
+
+TEST_F(ReaderFixture, IndexesKeyframesAndLayoutChangesOfCompressedStreams) {
+    daedalus::protocol::testing::XorFrameEncoder encoder(64);
+    std::vector<double> row(2000);
+    SessionRecorder recorder;
+    ASSERT_TRUE(recorder.start(path.string()));
+    for (uint64_t f = 0; f < 2000; ++f) {
+        if (f == 0 || f == 1536) { // a reconnect: new schema, subscription and stream
+            recorder.record_text(kSchema);
+            recorder.record_text(kAck);
+            encoder = daedalus::protocol::testing::XorFrameEncoder(64);
+        }
+        for (size_t s = 0; s < row.size(); ++s) {
+            row[s] = static_cast<double>(f * s);
+        }
+        const auto frame = encoder.encode(f, 0.01 * static_cast<double>(f), row);
+        ASSERT_TRUE(recorder.record_frame(frame.data(), frame.size()));
+    }
+    recorder.stop();
+
+    SessionReader reader;
+    ASSERT_TRUE(reader.open(path.string()));
+    ASSERT_GE(reader.index().size(), 3u);
+    bool saw_second_layout = false;
+    for (const auto &entry : reader.index()) {
+        const auto info = frame_info(reader.read(entry.offset)->payload);
+        EXPECT_TRUE(info->seekable);
+        EXPECT_EQ(entry.frame % 64, 0u);
+        if (entry.frame >= 1536) {
+            // Frames after the reconnect are read with the layout sent there.
+            EXPECT_GT(entry.schema_offset, reader.index().front().offset);
+            EXPECT_GT(entry.ack_offset, entry.schema_offset);
+            saw_second_layout = true;
+        }
+    }
+    EXPECT_TRUE(saw_second_layout);
+}
+
+TEST_F(ReaderFixture, RejectsFilesThatAreNotSessions) {
+    SessionReader reader;
+    EXPECT_FALSE(reader.open("/nonexistent-dir/session.daedalus"));
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << std::string(200, 'x');
+    }
+    EXPECT_FALSE(reader.open(path.string()));
+    EXPECT_FALSE(reader.is_open());
+}
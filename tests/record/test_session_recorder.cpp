@@ -0,0 +1,130 @@
+#include "daedalus/record/session_recorder.hpp"
+#include "session_test_util.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace daedalus::record;
+
+namespace {
+
+struct ParsedRecord {
+    RecordKind kind;
+    std::vector<uint8_t> payload;
+    uint64_t received_ns;
+};
+
+std::vector<uint8_t> read_file(const std::filesystem::path &path) {
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+/// Parse the stream records of a session file written by the recorder; fails the
+/// test on bad layout.
+std::vector<ParsedRecord> parse_session(const std::vector<uint8_t> &file) {
+    std::vector<ParsedRecord> records;
+    EXPECT_GE(file.size(), sizeof(SessionFileHeader));
+    SessionFileHeader header{};
+    std::memcpy(&header, file.data(), sizeof(header));
+    EXPECT_EQ(std::memcmp(header.magic, kSessionMagic, sizeof(kSessionMagic)), 0);
+    EXPECT_EQ(header.version, kSessionVersion);
+
+    size_t at = header.header_bytes;
+    while (at + sizeof(RecordHeader) <= file.size()) {
+        RecordHeader rh{};
+        std::memcpy(&rh, file.data() + at, sizeof(rh));
+        EXPECT_LE(at + record_bytes(rh.size), file.size());
+        if (rh.kind == static_cast<uint32_t>(RecordKind::Index)) {
+            // The index and trailer close the file.
+            EXPECT_EQ(rh.size % sizeof(IndexEntry), 0u);
+            at += record_bytes(rh.size) + sizeof(SessionTrailer);
+            break;
+        }
+        const auto *payload = file.data() + at + sizeof(rh);
+        records.push_back({static_cast<RecordKind>(rh.kind),
+                           std::vector<uint8_t>(payload, payload + rh.size), rh.received_ns});
+        at += record_bytes(rh.size);
+    }
+    EXPECT_EQ(at, file.size());
+    return records;
+}
+
+using RecorderFixture = daedalus::record::testing::SessionFileTest;
+
+} // namespace
+
+TEST_F(RecorderFixture, WritesTextAndFramesInOrder) {
+    SessionRecorder recorder;
+    EXPECT_FALSE(recorder.record_text("before start"));
+    ASSERT_TRUE(recorder.start(path.string()));
+    EXPECT_TRUE(recorder.recording());
+
+    const std::string &schema = daedalus::record::testing::kSchema;
+    const std::vector<uint8_t> frame = {1, 2, 3, 4, 5};
+    EXPECT_TRUE(recorder.record_text(schema));
+    EXPECT_TRUE(recorder.record_frame(frame.data(), frame.size()));
+    EXPECT_TRUE(recorder.record_frame(nullptr, 0));
+    recorder.stop();
+    EXPECT_FALSE(recorder.recording());
+    EXPECT_FALSE(recorder.record_frame(frame.data(), frame.size()));
+
+    const auto file = read_file(path);
+    const auto records = parse_session(file);
+    ASSERT_EQ(records.size(), 3u);
+    EXPECT_EQ(records[0].kind, RecordKind::Text);
+    EXPECT_EQ(std::string(records[0].payload.begin(), records[0].payload.end()), schema);
+    EXPECT_EQ(records[1].kind, RecordKind::Frame);
+    EXPECT_EQ(records[1].payload, frame);
+    EXPECT_TRUE(records[2].payload.empty());
+    EXPECT_LE(records[0].received_ns, records[1].received_ns);
+
+    const auto stats = recorder.stats();
+    EXPECT_EQ(stats.records, 3u);
+    EXPECT_EQ(stats.bytes_written, file.size());
+    EXPECT_EQ(stats.dropped, 0u);
+    EXPECT_GE(stats.syncs, 1u);
+}
+
+TEST_F(RecorderFixture, DropsInsteadOfBlockingWhenTheRingIsFull) {
+    SessionRecorder::Options options;
+    options.ring_bytes = 4096;
+    SessionRecorder recorder(options);
+    ASSERT_TRUE(recorder.start(path.string()));
+
+    const std::vector<uint8_t> oversized(4096, 0xAB);
+    EXPECT_FALSE(recorder.record_frame(oversized.data(), oversized.size()));
+
+    // Far more than the ring holds, pushed without pause: some may be dropped,
+    // none may block, and everything accepted reaches the file intact.
+    const std::vector<uint8_t> frame(1000, 0x5A);
+    uint64_t accepted = 0;
+    for (int i = 0; i < 2000; ++i) {
+        accepted += recorder.record_frame(frame.data(), frame.size()) ? 1 : 0;
+    }
+    recorder.stop();
+
+    const auto stats = recorder.stats();
+    EXPECT_EQ(stats.records, accepted);
+    EXPECT_EQ(stats.dropped, 2001u - accepted);
+    const auto records = parse_session(read_file(path));
+    ASSERT_EQ(records.size(), accepted);
+    for (const auto &record : records) {
+        ASSERT_EQ(record.payload, frame);
+    }
+}
+
+TEST_F(RecorderFixture, RejectsUnwritablePathAndSecondStart) {
+    SessionRecorder recorder;
+    EXPECT_FALSE(recorder.start("/nonexistent-dir/session.daedalus"));
+
+    SessionRecorder used;
+    ASSERT_TRUE(used.start(path.string()));
+    used.stop();
+    EXPECT_FALSE(used.start(path.string()));
+}
@@ -0,0 +1,167 @@
+#include "daedalus/record/session_recorder.hpp"
+#include "daedalus/record/session_replay.hpp"
+#include "session_test_util.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+using namespace daedalus::record;
+using namespace daedalus::protocol;
+using daedalus::data::FrameBatch;
+
+namespace {
+
+/// Pop the next event, waiting up to a second for it.
+std::optional<ControlEvent> next_event(SessionReplay &replay) {
+    ControlEvent event;
+    for (int i = 0; i < 1000; ++i) {
+        if (replay.event_queue().try_pop(event)) {
+            return event;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return std::nullopt;
+}
+
+/// Skip to the next subscribe ack, as a consumer would set up for it.
+bool await_ack(SessionReplay &replay) {
+    while (auto event = next_event(replay)) {
+        if (std::holds_alternative<SubscribeAck>(*event)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Consume batches like the ingest thread until the replay has played the whole
+/// recording and every batch is taken. The deadline only guards against a hang.
+std::vector<FrameBatch> drain(SessionReplay &replay) {
+    std::vector<FrameBatch> batches;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(120);
+    while (std::chrono::steady_clock::now() < deadline) {
+        // Checked before the pop: a replay flushes before it reports finished, so
+        // an empty queue after that means nothing is left.
+        const bool finished = replay.finished();
+        FrameBatch batch;
+        if (replay.telemetry_queue().try_pop(batch)) {
+            batches.push_back(batch);
+            replay.batch_pool().release(std::move(batch));
+        } else if (finished) {
+            break;
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+    return batches;
+}
+
+struct ReplayFixture : daedalus::record::testing::SessionFileTest {
+    /// Record the layout and `frames` typed frames, `spacing` apart in receive time.
+    void record(uint64_t frames, std::chrono::microseconds spacing = {}) {
+        record_session(frames, daedalus::record::testing::typed_frame, spacing);
+    }
+
+    /// Seconds to replay the whole recording at `speed`.
+    double replay_seconds(double speed) {
+        SessionReplay replay(path.string(), speed);
+        replay.connect();
+        EXPECT_TRUE(await_ack(replay));
+        const auto start = std::chrono::steady_clock::now();
+        replay.resume();
+        EXPECT_FALSE(drain(replay).empty());
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+} // namespace
+
+TEST_F(ReplayFixture, FeedsTheRecordingThroughThePipelineLikeALiveStream) {
+    record(20000);
+
+    SessionReplay replay(path.string(), SessionReplay::kMaxSpeed);
+    replay.connect();
+    EXPECT_EQ(replay.state(), ConnectionState::Connected);
+    auto event = next_event(replay);
+    ASSERT_TRUE(event);
+    const auto *change = std::get_if<StateChange>(&*event);
+    ASSERT_NE(change, nullptr);
+    EXPECT_EQ(change->state, ConnectionState::Connected);
+    event = next_event(replay);
+    ASSERT_TRUE(event && std::holds_alternative<Schema>(*event));
+    event = next_event(replay);
+    ASSERT_TRUE(event && std::holds_alternative<SubscribeAck>(*event));
+
+    // Like Hermes, nothing streams until the consumer resumes.
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(replay.frames_played(), 0u);
+    replay.resume();
+
+    // Consume late: the replay waits for room rather than dropping.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const auto batches = drain(replay);
+    uint64_t expected = 0;
+    for (const auto &batch : batches) {
+        ASSERT_EQ(batch.signal_count, 2u);
+        for (size_t r = 0; r < batch.rows; ++r, ++expected) {
+            ASSERT_EQ(batch.frame_column()[r], expected);
+            ASSERT_DOUBLE_EQ(batch.column(0)[r], static_cast<double>(expected) / 2.0);
+            ASSERT_DOUBLE_EQ(batch.column(1)[r], static_cast<double>(expected % 7));
+        }
+    }
+    EXPECT_EQ(expected, 20000u);
+    EXPECT_EQ(replay.telemetry_queue().stats().dropped, 0u);
+    EXPECT_TRUE(replay.finished());
+    EXPECT_EQ(replay.frames_played(), 20000u);
+    EXPECT_DOUBLE_EQ(replay.position(), replay.end_time());
+    EXPECT_EQ(replay.stream_health().gaps, 0u);
+
+    replay.disconnect();
+    EXPECT_EQ(replay.state(), ConnectionState::Disconnected);
+}
+
+TEST_F(ReplayFixture, PacesFramesAsTheyWereReceived) {
+    record(40, std::chrono::milliseconds(5)); // at least 195 ms of receive time
+
+    const double as_recorded = replay_seconds(1.0);
+    const double ten_times = replay_seconds(10.0);
+    EXPECT_GE(as_recorded, 0.19);
+    EXPECT_LT(ten_times, as_recorded / 2.0);
+}
+
+TEST_F(ReplayFixture, SeekResendsTheLayoutAndPlaysFromTheIndex) {
+    record(30000);
+
+    SessionReplay replay(path.string(), SessionReplay::kMaxSpeed);
+    replay.connect();
+    ASSERT_TRUE(await_ack(replay));
+    replay.seek(200.0);
+    auto event = next_event(replay);
+    ASSERT_TRUE(event && std::holds_alternative<Schema>(*event));
+    ASSERT_TRUE(await_ack(replay));
+    replay.resume();
+
+    const auto batches = drain(replay);
+    ASSERT_FALSE(batches.empty());
+    // From the index entry at or before the target, not from the start.
+    SessionReader reader;
+    ASSERT_TRUE(reader.open(path.string()));
+    const double entry_time = reader.seek_time(200.0, 0)->time;
+    EXPECT_GT(entry_time, 100.0);
+    EXPECT_DOUBLE_EQ(batches.front().time_column()[0], entry_time);
+}
+
+TEST_F(ReplayFixture, ReportsAnUnreadableFile) {
+    SessionReplay replay("/nonexistent-dir/session.daedalus");
+    replay.connect();
+    EXPECT_EQ(replay.state(), ConnectionState::Error);
+    const auto event = next_event(replay);
+    ASSERT_TRUE(event);
+    const auto *change = std::get_if<StateChange>(&*event);
+    ASSERT_NE(change, nullptr);
+    EXPECT_EQ(change->state, ConnectionState::Error);
+}
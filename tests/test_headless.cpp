@@ -0,0 +1,51 @@
+#include "daedalus/headless.hpp"
+#include "daedalus/record/session_replay.hpp"
+#include "record/session_test_util.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+using namespace daedalus;
+using daedalus::record::testing::plain_frame;
+
+namespace {
+
+struct HeadlessSessionTest : record::testing::SessionFileTest {};
+
+} // namespace
+
+TEST_F(HeadlessSessionTest, IngestsAReplayAndReportsThroughput) {
+    record_session(5000, [](uint64_t f) { return plain_frame(f, 2); });
+
+    record::SessionReplay replay(path.string(), record::SessionReplay::kMaxSpeed);
+    HeadlessReport report;
+    {
+        HeadlessSession session(replay);
+        session.start();
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!(replay.finished() && session.drained(replay.frames_played())) &&
+               std::chrono::steady_clock::now() < deadline) {
+            session.poll();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        // The schema and ack were answered as the app would: one store, all signals
+        ASSERT_TRUE(session.store());
+        EXPECT_EQ(session.store()->signal_count(), 2u);
+        report = session.report();
+        session.stop();
+        EXPECT_FALSE(session.store());
+    }
+
+    EXPECT_EQ(report.frames, 5000u);
+    EXPECT_EQ(report.samples, 10000u);
+    EXPECT_GT(report.seconds, 0.0);
+    EXPECT_GT(report.latency_count, 0u);
+    EXPECT_LE(report.latency_p50, report.latency_p99);
+    EXPECT_LE(report.latency_p99, report.latency_max);
+    EXPECT_EQ(report.frames_dropped, 0u);
+    EXPECT_EQ(report.rows_discarded, 0u);
+    EXPECT_EQ(report.frames_rejected, 0u);
+    EXPECT_EQ(report.gaps, 0u);
+}
@@ -0,0 +1,72 @@
+#include "daedalus/launch_options.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using namespace daedalus;
+
+namespace {
+
+LaunchOptions parse(std::vector<const char *> args) {
+    args.insert(args.begin(), "daedalus");
+    return parse_launch_options(static_cast<int>(args.size()), args.data());
+}
+
+} // namespace
+
+TEST(LaunchOptions, DefaultsToTheLiveUi) {
+    const auto options = parse({});
+    EXPECT_FALSE(options.headless);
+    EXPECT_EQ(options.url, "ws://127.0.0.1:8765");
+    EXPECT_TRUE(options.replay_path.empty());
+    EXPECT_DOUBLE_EQ(options.replay_speed, 1.0);
+    EXPECT_TRUE(options.unknown.empty());
+}
+
+TEST(LaunchOptions, ParsesHeadlessRecordingRun) {
+    const auto options = parse({"--headless", "--url", "ws://sim:9000", "--encoding", "xor",
+                                "--record", "out.daedalus", "--duration", "30", "--interval",
+                                "0.5"});
+    EXPECT_TRUE(options.headless);
+    EXPECT_EQ(options.url, "ws://sim:9000");
+    EXPECT_EQ(options.encoding, protocol::TelemetryEncoding::Xor);
+    EXPECT_EQ(options.record_path, "out.daedalus");
+    EXPECT_DOUBLE_EQ(options.duration_s, 30.0);
+    EXPECT_DOUBLE_EQ(options.report_interval_s, 0.5);
+}
+
+TEST(LaunchOptions, ParsesReplaySpeedAndCollectsUnknownArguments) {
+    auto options = parse({"--replay", "s.daedalus", "--speed", "max", "--bogus"});
+    EXPECT_EQ(options.replay_path, "s.daedalus");
+    EXPECT_DOUBLE_EQ(options.replay_speed, 0.0);
+    ASSERT_EQ(options.unknown.size(), 1u);
+    EXPECT_EQ(options.unknown[0], "--bogus");
+
+    options = parse({"--speed", "4"});
+    EXPECT_DOUBLE_EQ(options.replay_speed, 4.0);
+    // A flag missing its value is not swallowed silently
+    options = parse({"--replay"});
+    EXPECT_TRUE(options.replay_path.empty());
+    ASSERT_EQ(options.unknown.size(), 1u);
+}
+
+TEST(LaunchOptions, ReportsMalformedValuesAndKeepsTheDefaults) {
+    auto options = parse({"--speed", "0", "--speed", "-2", "--speed", "4x", "--speed", "nan",
+                          "--encoding", "zstd", "--duration", "-1", "--interval", "0"});
+    EXPECT_DOUBLE_EQ(options.replay_speed, 1.0);
+    EXPECT_EQ(options.encoding, protocol::TelemetryEncoding::Plain);
+    EXPECT_DOUBLE_EQ(options.duration_s, 0.0);
+    EXPECT_DOUBLE_EQ(options.report_interval_s, 1.0);
+    const std::vector<std::string> expected = {"--speed 0",       "--speed -2",
+                                               "--speed 4x",      "--speed nan",
+                                               "--encoding zstd", "--duration -1",
+                                               "--interval 0"};
+    EXPECT_EQ(options.unknown, expected);
+
+    options = parse({"--encoding", "xor", "--encoding", "plain", "--speed", "0.25"});
+    EXPECT_EQ(options.encoding, protocol::TelemetryEncoding::Plain);
+    EXPECT_DOUBLE_EQ(options.replay_speed, 0.25);
+    EXPECT_TRUE(options.unknown.empty());
+}
@@ -219,3 +219,14 @@ TEST(PlotManager, CanSetSignalUnitLookupCallback) {
     });
     SUCCEED();
 }
+
+TEST(PlotManager, IsPlottedTracksSignalsOnAnyPanel) {
+    PlotManager manager;
+    manager.create_panel();
+    const size_t second = manager.create_panel();
+    EXPECT_TRUE(manager.add_signal_to_panel(second, 7, "vehicle.att.pitch"));
+    EXPECT_TRUE(manager.is_plotted(7));
+    EXPECT_FALSE(manager.is_plotted(3));
+    manager.panel(second).remove_signal(7);
+    EXPECT_FALSE(manager.is_plotted(7));
+}